@@ -1,6 +1,6 @@
 package Tk::Canvas;
 use vars qw($VERSION);
-$VERSION = '4.013'; # sprintf '4.%03d', q$Revision: #12 $ =~ /\D(\d+)\s*$/;
+$VERSION = '4.014'; # sprintf '4.%03d', q$Revision: #12 $ =~ /\D(\d+)\s*$/;
 
 use Tk qw($XS_VERSION);
 
@@ -11,10 +11,12 @@ bootstrap Tk::Canvas;
 
 sub Tk_cmd { \&Tk::canvas }
 
-Tk::Methods('addtag','bbox','bind','canvasx','canvasy','coords','create',
-            'dchars','delete','dtag','find','focus','gettags','icursor',
-            'index','insert','itemcget','itemconfigure','lower','move',
-            'postscript','raise','scale','scan','select','type','xview','yview');
+Tk::Methods('addtag','bind','create','dchars','delete','dtag','focus',
+            'icursor','insert','lower','postscript','raise','redrawstats',
+            'scale','scan','select','xview','yview');
+
+Tk::LeafMethods('bbox','canvasx','canvasy','coords','find','gettags',
+                'index','itemcget','itemconfigure','move','type');
 
 use Tk::Submethods ( 'create' => [qw(arc bitmap grid group image line oval
 				     polygon rectangle text window)],
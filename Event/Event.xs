@@ -17,6 +17,9 @@
 #include "pTk/tkEvent.h"
 #include "pTk/tkEvent_f.h"
 #include "pTk/tkEvent_f.c"
+#ifndef WIN32
+#include <dlfcn.h>
+#endif
 
 extern void TclInitSubsystems(CONST char *argv0);
 
@@ -99,6 +102,8 @@ Tcl_ValidateAllMemory (CONST char *file, int line)
 {
 }
 
+/* Number of ckalloc calls, for Tk::Event::AllocStats */
+static long allocCalls = 0;
 
 #ifdef DO_CHECK_TCL_ALLOC
 
@@ -215,6 +220,7 @@ Tcl_DbCkalloc (unsigned int usize,CONST char *file,int line)
   abort();
  lp = PerlMemShared_calloc(size, sizeof(alloc_t));
  Tcl_AllocCount++;
+ allocCalls++;
  res = enlink(lp,size,file,line);
  if (res+usize > (char *)(&lp[size-1].self))
   {
@@ -315,6 +321,7 @@ Tcl_Alloc(unsigned int size)
  char *p;
  if ((int) size < 0)
   abort();
+ allocCalls++;
  p = PerlMemShared_calloc(size, sizeof(char));
  return p;
 }
@@ -353,6 +360,117 @@ Tcl_AttemptDbCkalloc(unsigned int usize,CONST char *file,int line)
  return Tcl_DbCkalloc(usize,file,line);
 }
 
+/*
+ * A stack-like arena for short-lived memory.  Tcl_ArenaMark notes the
+ * top of the arena, Tcl_ArenaAlloc takes memory from the top, and
+ * Tcl_ArenaRelease gives back everything taken since a mark in one go;
+ * nothing is freed individually.  Marks must be released in the reverse
+ * order to that in which they were taken, as C scopes are.  The event
+ * loop takes a mark around each event, idle and timer handler it
+ * calls, so memory taken during a handler and not released by whoever
+ * took it is reclaimed when the handler returns.
+ *
+ * Memory comes in blocks of ARENA_BLOCK bytes (larger requests get a
+ * block of their own), and up to ARENA_SPARES released blocks are kept
+ * for re-use, so once the arena has grown to what the handlers need it
+ * makes no further calls on the system allocator.
+ */
+
+#define ARENA_BLOCK 65536
+#define ARENA_SPARES 4
+#define ARENA_ALIGN 8
+
+typedef struct ArenaBlock
+{
+ struct ArenaBlock *prev;       /* Block below this one, or NULL */
+ size_t size;                   /* Bytes available in space */
+ size_t used;                   /* Bytes of space in use */
+ union {
+  double d;
+  void *p;
+  char space[1];
+ } u;
+} ArenaBlock;
+
+static ArenaBlock *arenaTop   = NULL;
+static ArenaBlock *arenaSpare = NULL;  /* Released blocks, via prev */
+static int arenaSpares = 0;
+static long arenaAllocs = 0;    /* Calls of Tcl_ArenaAlloc */
+static long arenaBlocks = 0;    /* Blocks got from the system */
+
+ClientData
+Tcl_ArenaMark(void)
+{
+ return (arenaTop) ? (ClientData) (arenaTop->u.space + arenaTop->used)
+                   : (ClientData) NULL;
+}
+
+char *
+Tcl_ArenaAlloc(unsigned int size)
+{
+ dTHXs;
+ ArenaBlock *block = arenaTop;
+ char *result;
+ size = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+ arenaAllocs++;
+ if (!block || block->size - block->used < size)
+  {
+   size_t want = (size > ARENA_BLOCK) ? size : ARENA_BLOCK;
+   if (arenaSpare && arenaSpare->size >= want)
+    {
+     block = arenaSpare;
+     arenaSpare = block->prev;
+     arenaSpares--;
+    }
+   else
+    {
+     block = (ArenaBlock *) PerlMemShared_malloc(
+                 offsetof(ArenaBlock, u) + want);
+     block->size = want;
+     arenaBlocks++;
+    }
+   block->prev = arenaTop;
+   block->used = 0;
+   arenaTop = block;
+  }
+ result = block->u.space + block->used;
+ block->used += size;
+ return result;
+}
+
+void
+Tcl_ArenaRelease(ClientData mark)
+{
+ dTHXs;
+ char *m = (char *) mark;
+ while (arenaTop &&
+        !(m >= arenaTop->u.space && m <= arenaTop->u.space + arenaTop->used))
+  {
+   ArenaBlock *block = arenaTop;
+   arenaTop = block->prev;
+   if (arenaSpares < ARENA_SPARES && block->size == ARENA_BLOCK)
+    {
+     block->prev = arenaSpare;
+     arenaSpare = block;
+     arenaSpares++;
+    }
+   else
+    PerlMemShared_free(block);
+  }
+ if (arenaTop)
+  arenaTop->used = m - arenaTop->u.space;
+}
+
+static SV *
+Event_AllocStats(pTHX)
+{
+ HV *hv = newHV();
+ hv_store(hv, "ckalloc", 7, newSViv(allocCalls), 0);
+ hv_store(hv, "arena", 5, newSViv(arenaAllocs), 0);
+ hv_store(hv, "arenablocks", 11, newSViv(arenaBlocks), 0);
+ return newRV_noinc((SV *) hv);
+}
+
 void
 Event_CleanupGlue(void)
 {
@@ -371,6 +489,291 @@ int fd;
 #endif
 }
 
+/*
+ * Optional profile of where the event loop's time goes: a count of calls
+ * and the elapsed time in them for each Tk command, perl callback and
+ * X event type, and for each idle and timer handler procedure.  Callers
+ * bracket a dispatch with LangProfileStart, which returns 0 unless
+ * profiling is on, and LangProfileRecord; so when it is off the cost is
+ * one call and a test.  Times are inclusive: a callback run from inside
+ * a command is counted in both.
+ */
+
+static int profiling = 0;
+static HV *profileData = NULL;
+
+/*
+ * Histograms of how long each iteration of the event loop and each
+ * handler take, how late timers fire and how long the idle queue gets.
+ * Bucket 0 counts values below 1, bucket i values from 2**(i-1) up to
+ * 2**i, and the last bucket everything larger.
+ */
+
+#define HIST_BUCKETS 32
+static int histograms = 0;
+static UV histogram[LANG_HIST_COUNT][HIST_BUCKETS];
+static CONST char *histogramName[LANG_HIST_COUNT] = {
+ "iteration", "handler", "lateness", "idlequeue"
+};
+
+/*
+ * The stall detector: an iteration that runs longer than stallLimit
+ * seconds is reported, naming the innermost dispatch within it that
+ * itself ran longer than the limit.
+ */
+
+static double stallLimit = 0.0;
+static SV *stallCallback = NULL;
+static char stallName[256];
+
+static int active = 0;
+
+static void
+ProfileSetActive(void)
+{
+ active = (profiling || histograms || stallLimit > 0.0);
+}
+
+static double
+ProfileNow(void)
+{
+#if defined(CLOCK_MONOTONIC) && !defined(WIN32)
+ struct timespec ts;
+ clock_gettime(CLOCK_MONOTONIC, &ts);
+ return (double) ts.tv_sec + ts.tv_nsec * 1e-9;
+#else
+ Tcl_Time t;
+ Tcl_GetTime(&t);
+ return (double) t.sec + t.usec * 1e-6;
+#endif
+}
+
+double
+LangProfileStart(void)
+{
+ return (active) ? ProfileNow() : 0.0;
+}
+
+/* Whether names are wanted for the per-name profile, so callers that
+   have to build one need only do so when it will be kept.
+ */
+int
+LangProfiling(void)
+{
+ return profiling;
+}
+
+void
+LangProfileSample(int which, double value)
+{
+ int bucket = 0;
+ if (!histograms || which < 0 || which >= LANG_HIST_COUNT)
+  return;
+ if (value >= 1.0)
+  {
+   frexp(value, &bucket);
+   if (bucket >= HIST_BUCKETS)
+    bucket = HIST_BUCKETS-1;
+  }
+ histogram[which][bucket]++;
+}
+
+/* Handler procedures are mostly static so have no name we can find;
+   give the object they live in and the offset, which addr2line or nm
+   will turn into a name.
+ */
+static CONST char *
+ProfileProcName(VOID *proc, char *buf, size_t len)
+{
+#ifdef RTLD_DEFAULT
+ Dl_info info;
+ if (dladdr(proc, &info) && info.dli_fname)
+  {
+   CONST char *base = strrchr(info.dli_fname, '/');
+   base = (base) ? base+1 : info.dli_fname;
+   if (info.dli_sname && info.dli_saddr == proc)
+    return info.dli_sname;
+   my_snprintf(buf, len, "%s+0x%lx", base,
+               (unsigned long) ((char *) proc - (char *) info.dli_fbase));
+   return buf;
+  }
+#endif
+ my_snprintf(buf, len, "0x%lx", (unsigned long) PTR2UV(proc));
+ return buf;
+}
+
+void
+LangProfileRecord(CONST char *kind, CONST char *name, VOID *proc, double start)
+{
+ dTHX;
+ char buf[256];
+ double now;
+ SV **svp;
+ AV *av;
+ if (!start)
+  return;
+ now = ProfileNow();
+ if (*kind != 'c')      /* not a command or callback */
+  LangProfileSample(LANG_HIST_HANDLER, (now - start) * 1e6);
+ if (stallLimit > 0.0 && now - start >= stallLimit && !stallName[0])
+  {
+   if (!name)
+    name = ProfileProcName(proc, buf, sizeof(buf));
+   my_snprintf(stallName, sizeof(stallName), "%s %s", kind, name);
+  }
+ if (!profiling)
+  return;
+ if (!name)
+  name = ProfileProcName(proc, buf, sizeof(buf));
+ if (!profileData)
+  profileData = newHV();
+ svp = hv_fetch(profileData, kind, strlen(kind), 1);
+ if (!SvROK(*svp))
+  {
+   SV *rv = newRV_noinc((SV *) newHV());
+   sv_setsv(*svp, rv);
+   SvREFCNT_dec(rv);
+  }
+ svp = hv_fetch((HV *) SvRV(*svp), name, strlen(name), 1);
+ if (!SvROK(*svp))
+  {
+   SV *rv;
+   av = newAV();
+   av_store(av, 0, newSViv(0));
+   av_store(av, 1, newSVnv(0.0));
+   rv = newRV_noinc((SV *) av);
+   sv_setsv(*svp, rv);
+   SvREFCNT_dec(rv);
+  }
+ av = (AV *) SvRV(*svp);
+ sv_setiv(AvARRAY(av)[0], SvIV(AvARRAY(av)[0]) + 1);
+ sv_setnv(AvARRAY(av)[1], SvNV(AvARRAY(av)[1]) + (now - start));
+}
+
+/* Called at the end of each Tcl_DoOneEvent that started while the
+   profile was kept; start has been moved on by any time spent waiting.
+   depth is the number of Tcl_DoOneEvent calls still active around this
+   one, so the culprit of a stall is kept for the outermost iteration.
+ */
+void
+LangProfileIteration(double start, int depth)
+{
+ double elapsed = ProfileNow() - start;
+ LangProfileSample(LANG_HIST_ITERATION, elapsed * 1e6);
+ if (stallLimit > 0.0 && elapsed >= stallLimit)
+  {
+   dTHX;
+   if (stallCallback)
+    {
+     dSP;
+     ENTER;
+     SAVETMPS;
+     PUSHMARK(sp);
+     XPUSHs(sv_2mortal(newSVnv(elapsed)));
+     XPUSHs((stallName[0]) ? sv_2mortal(newSVpv(stallName, 0))
+                           : &PL_sv_undef);
+     PUTBACK;
+     call_sv(stallCallback, G_DISCARD | G_EVAL);
+     if (SvTRUE(ERRSV))
+      warn("Tk::Event::Watchdog callback: %" SVf, ERRSV);
+     FREETMPS;
+     LEAVE;
+    }
+   else
+    {
+     warn("Tk event loop stalled for %.3fs%s%s\n", elapsed,
+          (stallName[0]) ? " in " : "", stallName);
+    }
+  }
+ if (!depth)
+  stallName[0] = '\0';
+}
+
+static int
+Event_Profile(int on)
+{
+ int old = profiling;
+ if (on >= 0)
+  profiling = on;
+ ProfileSetActive();
+ return old;
+}
+
+static int
+Event_Histograms(int on)
+{
+ int old = histograms;
+ if (on >= 0)
+  histograms = on;
+ ProfileSetActive();
+ return old;
+}
+
+static SV *
+Event_HistogramData(pTHX_ int reset)
+{
+ HV *hv = newHV();
+ int i, j;
+ for (i = 0; i < LANG_HIST_COUNT; i++)
+  {
+   AV *av = newAV();
+   av_extend(av, HIST_BUCKETS-1);
+   for (j = 0; j < HIST_BUCKETS; j++)
+    av_store(av, j, newSVuv(histogram[i][j]));
+   hv_store(hv, histogramName[i], strlen(histogramName[i]),
+            newRV_noinc((SV *) av), 0);
+  }
+ if (reset)
+  Zero((UV *) histogram, LANG_HIST_COUNT * HIST_BUCKETS, UV);
+ return newRV_noinc((SV *) hv);
+}
+
+static double
+Event_Watchdog(pTHX_ double limit, SV *callback)
+{
+ double old = stallLimit;
+ if (limit >= 0.0)
+  {
+   stallLimit = limit;
+   if (stallCallback)
+    SvREFCNT_dec(stallCallback);
+   stallCallback = (callback && SvOK(callback)) ? newSVsv(callback) : NULL;
+   stallName[0] = '\0';
+  }
+ ProfileSetActive();
+ return old;
+}
+
+static SV *
+Event_ProfileData(pTHX_ int reset)
+{
+ HV *copy = newHV();
+ if (profileData)
+  {
+   HE *he;
+   hv_iterinit(profileData);
+   while ((he = hv_iternext(profileData)))
+    {
+     HV *kind  = (HV *) SvRV(HeVAL(he));
+     HV *names = newHV();
+     HE *ne;
+     hv_iterinit(kind);
+     while ((ne = hv_iternext(kind)))
+      {
+       AV *av = (AV *) SvRV(HeVAL(ne));
+       AV *entry = newAV();
+       av_store(entry, 0, newSVsv(AvARRAY(av)[0]));
+       av_store(entry, 1, newSVsv(AvARRAY(av)[1]));
+       hv_store_ent(names, hv_iterkeysv(ne), newRV_noinc((SV *) entry), 0);
+      }
+     hv_store_ent(copy, hv_iterkeysv(he), newRV_noinc((SV *) names), 0);
+    }
+   if (reset)
+    hv_clear(profileData);
+  }
+ return newRV_noinc((SV *) copy);
+}
+
 static void
 install_vtab(pTHX_ char *name, void *table, size_t size)
 {
@@ -1436,6 +1839,10 @@ int
 Tcl_DoOneEvent(flags)
 int	flags
 
+int
+Tcl_HoldIdle(delta = 0)
+int	delta
+
 void
 Tcl_QueueEvent(evPtr, position = TCL_QUEUE_TAIL)
 Tcl_Event *		evPtr
@@ -1525,6 +1932,54 @@ MODULE = Tk::Event	PACKAGE = Tk::Event	PREFIX = Event_
 void
 Event_CleanupGlue()
 
+int
+Event_Profile(on = -1)
+int	on
+
+SV *
+Event_ProfileData(reset = 0)
+int	reset
+CODE:
+ {
+  RETVAL = Event_ProfileData(aTHX_ reset);
+ }
+OUTPUT:
+ RETVAL
+
+SV *
+Event_AllocStats()
+CODE:
+ {
+  RETVAL = Event_AllocStats(aTHX);
+ }
+OUTPUT:
+ RETVAL
+
+int
+Event_Histograms(on = -1)
+int	on
+
+SV *
+Event_HistogramData(reset = 0)
+int	reset
+CODE:
+ {
+  RETVAL = Event_HistogramData(aTHX_ reset);
+ }
+OUTPUT:
+ RETVAL
+
+double
+Event_Watchdog(limit = -1.0, callback = NULL)
+double	limit
+SV *	callback
+CODE:
+ {
+  RETVAL = Event_Watchdog(aTHX_ limit, callback);
+ }
+OUTPUT:
+ RETVAL
+
 MODULE = Tk::Event	PACKAGE = Tk::Event
 
 PROTOTYPES: DISABLE
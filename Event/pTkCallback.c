@@ -149,6 +149,43 @@ int line;
  return sv;
 }
 
+#ifndef CvISXSUB
+#define CvISXSUB(cv) (CvXSUB(cv) != NULL)
+#endif
+
+/* Name a callback for the profile: the sub's full name (with where an
+   anonymous one was defined), or class->method for a method callback.
+ */
+static CONST char *
+CallbackName(pTHX_ SV *sv, SV *obj)
+{
+ SV *name = sv_newmortal();
+ CV *cv   = NULL;
+ if (SvTYPE(sv) == SVt_PVCV)
+  cv = (CV *) sv;
+ else if (SvROK(sv) && SvTYPE(SvRV(sv)) == SVt_PVCV)
+  cv = (CV *) SvRV(sv);
+ if (cv)
+  {
+   if (CvGV(cv))
+    gv_efullname3(name, CvGV(cv), Nullch);
+   if (CvANON(cv) && !CvISXSUB(cv) && CvSTART(cv) &&
+       (CvSTART(cv)->op_type == OP_NEXTSTATE ||
+        CvSTART(cv)->op_type == OP_DBSTATE))
+    {
+     COP *cop = (COP *) CvSTART(cv);
+     sv_catpvf(name, " at %s line %ld", CopFILE(cop), (long) CopLINE(cop));
+    }
+  }
+ else if (SvPOK(sv) && obj && SvROK(obj) && SvOBJECT(SvRV(obj)))
+  sv_setpvf(name, "%s->%s", HvNAME(SvSTASH(SvRV(obj))), SvPV_nolen(sv));
+ else if (obj && SvPOK(obj) && SvROK(sv) && SvOBJECT(SvRV(sv)))
+  sv_setpvf(name, "%s->%s", HvNAME(SvSTASH(SvRV(sv))), SvPV_nolen(obj));
+ else
+  sv_setpv(name, SvPV_nolen(sv));
+ return SvPV_nolen(name);
+}
+
 int
 LangCallCallback(sv, flags)
 SV *sv;
@@ -159,6 +196,8 @@ int flags;
  STRLEN na;
  I32 myframe = TOPMARK;
  I32 count;
+ double start = LangProfileStart();
+ CONST char *name = NULL;
  ENTER;
  if (SvGMAGICAL(sv))
   mg_get(sv);
@@ -185,6 +224,13 @@ int flags;
     }
   }
 
+ if (start)
+  {
+   SV *obj = (PL_stack_sp > PL_stack_base + myframe) ?
+             PL_stack_base[myframe+1] : NULL;
+   name = CallbackName(aTHX_ sv, obj);
+  }
+
  /* Belt-and-braces fix to callback destruction issues */
  /* Increment refcount of thing while we call it */
  SvREFCNT_inc(sv);
@@ -219,6 +265,7 @@ int flags;
      count = perl_call_sv(sv, flags);
     }
   }
+ LangProfileRecord("callback", name, NULL, start);
  LEAVE;
  return count;
 }
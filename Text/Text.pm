@@ -21,7 +21,7 @@ use Text::Tabs;
 
 use vars qw($VERSION);
 #$VERSION = sprintf '4.%03d', q$Revision: #24 $ =~ /\D(\d+)\s*$/;
-$VERSION = '4.030';
+$VERSION = '4.031';
 
 use Tk qw(Ev $XS_VERSION);
 use base  qw(Tk::Clipboard Tk::Widget);
@@ -34,9 +34,11 @@ sub Tk_cmd { \&Tk::text }
 
 sub Tk::Widget::ScrlText { shift->Scrolled('Text' => @_) }
 
-Tk::Methods('bbox','compare','debug','delete','dlineinfo','dump','edit',
-            'get','image','index','insert','mark','scan','search',
-            'see','tag','window','xview','yview');
+Tk::Methods('bbox','debug','delete','dlineinfo','dump','edit',
+            'get','image','insert','scan','search',
+            'see','window','xview','yview');
+
+Tk::LeafMethods('compare','index','mark','tag');
 
 use Tk::Submethods ( 'mark'   => [qw(gravity names next previous set unset)],
 		     'scan'   => [qw(mark dragto)],
@@ -252,6 +252,14 @@ sub Methods
   }
 }
 
+# Like Methods, for widget commands which do not run the event loop.
+# These are entered as XSUBs which take a shorter path into the command.
+sub LeafMethods
+{
+ my ($package) = caller;
+ EnterLeafMethods($package,__FILE__,@_);
+}
+
 my %dialog = ( tk_chooseColor => 'ColorDialog',
                tk_messageBox  => 'MessageBox',
                tk_getOpenFile => 'FDialog',
@@ -506,6 +506,22 @@ CODE:
    }
  }
 
+void
+EnterLeafMethods(package,file,...)
+char *	package
+char *	file
+CODE:
+ {int i;
+  for (i=2; i < items; i++)
+   {
+    STRLEN len;
+    SV *method = newSVsv(ST(i));
+    SV *name = sv_2mortal(newSVpvf("%s::%s", package, SvPV(method,len)));
+    CV *cv = newXS(SvPV_nolen(name), XStoLeafWidget, file);
+    CvXSUBANY(cv).any_ptr = method;
+   }
+ }
+
 IV
 GetFILE(arg,w)
 SV *	arg
@@ -608,6 +624,44 @@ PPCODE:
    }
  }
 
+SV *
+pTk_GIFFrameInfo(tkwin, source, isData = 0)
+Tk_Window	tkwin;
+SV *	source;
+int	isData;
+CODE:
+ {
+  Tcl_Interp *interp;
+  TkGIFFrameInfo *frames;
+  int numFrames, loop, i;
+  HV *hv;
+  AV *av;
+  if (!TkToWidget(tkwin,&interp) || !interp)
+   croak("Invalid widget");
+  Tcl_ResetResult(interp);
+  if (TkGetGIFFrameInfo(interp, source, isData, &frames, &numFrames, &loop) != TCL_OK)
+   croak("%s",Tcl_GetStringResult(interp));
+  av = newAV();
+  for (i = 0; i < numFrames; i++)
+   {
+    HV *fhv = newHV();
+    hv_store(fhv, "left",     4, newSViv(frames[i].left), 0);
+    hv_store(fhv, "top",      3, newSViv(frames[i].top), 0);
+    hv_store(fhv, "width",    5, newSViv(frames[i].width), 0);
+    hv_store(fhv, "height",   6, newSViv(frames[i].height), 0);
+    hv_store(fhv, "delay",    5, newSViv(frames[i].delay), 0);
+    hv_store(fhv, "disposal", 8, newSViv(frames[i].disposal), 0);
+    av_push(av, newRV_noinc((SV *) fhv));
+   }
+  ckfree((char *) frames);
+  hv = newHV();
+  hv_store(hv, "frames", 6, newRV_noinc((SV *) av), 0);
+  hv_store(hv, "loop",   4, (loop < 0) ? newSV(0) : newSViv(loop), 0);
+  RETVAL = newRV_noinc((SV *) hv);
+ }
+OUTPUT:
+ RETVAL
+
 
 MODULE = Tk	PACKAGE = Tk::Widget	PREFIX = Tk_
 
@@ -771,6 +825,23 @@ CODE:
   XSync(Tk_Display(win),flush);
  }
 
+void
+BufferPixmapStats(win)
+Tk_Window	win
+PPCODE:
+ {
+  static char *names[] = { "pixmaps", "inuse", "bytes", "hits", "misses" };
+  double stats[5];
+  int i;
+  TkGetBufferPixmapStats(win, stats);
+  EXTEND(sp, 10);
+  for (i = 0; i < 5; i++)
+   {
+    PUSHs(sv_2mortal(newSVpv(names[i],0)));
+    PUSHs(sv_2mortal(newSVnv(stats[i])));
+   }
+ }
+
 void
 Tk_GetRootCoords(win)
 Tk_Window	win
@@ -1138,6 +1209,37 @@ SV *	&name
 OUTPUT:
 	name
 
+MODULE = Tk	PACKAGE = Tk::Photo	PREFIX = Photo_
+
+IV
+Photo_CacheLimit(class, limit = -1)
+SV *	class
+IV	limit
+CODE:
+ {
+  RETVAL = TkPhotoCacheLimit((long) limit);
+ }
+OUTPUT:
+ RETVAL
+
+void
+Photo_CacheStats(class)
+SV *	class
+PPCODE:
+ {
+  static char *names[] = { "entries", "bytes", "limit",
+                           "hits", "misses", "evictions" };
+  double stats[6];
+  int i;
+  TkPhotoCacheStats(stats);
+  EXTEND(sp, 12);
+  for (i = 0; i < 6; i++)
+   {
+    PUSHs(sv_2mortal(newSVpv(names[i],0)));
+    PUSHs(sv_2mortal(newSVnv(stats[i])));
+   }
+ }
+
 MODULE = Tk	PACKAGE = Tk	PREFIX = Lang_
 
 SV *
@@ -1,7 +1,7 @@
 package Tk::Animation;
 
 use vars qw($VERSION);
-$VERSION = '4.008'; # $Id: //depot/Tkutf8/Tk/Animation.pm#8 $
+$VERSION = '4.009'; # $Id: //depot/Tkutf8/Tk/Animation.pm#8 $
 
 use Tk::Photo;
 use base  qw(Tk::Photo);
@@ -27,9 +27,24 @@ sub new
  $obj->{'_MainWIndow_'} = $widget->MainWindow;
  if ($args{'-format'} eq 'gif')
   {
+   # Ask the GIF reader for the frames up front: this tells us how
+   # many there are without probing past the end, and leaves the
+   # reader an index of the file so each -index below is found
+   # directly rather than by walking all the frames before it.
+   my $info;
+   if (defined $args{'-file'})
+    {
+     $info = eval { $widget->GIFFrameInfo($args{'-file'}) };
+    }
+   elsif (defined $args{'-data'})
+    {
+     $info = eval { $widget->GIFFrameInfo($args{'-data'},1) };
+    }
+   $obj->{'_gif_info_'} = $info;
+   my $count = $info ? @{$info->{'frames'}} : undef;
    my @images;
    local $@;
-   while (1)
+   while (!defined($count) || @images < $count)
     {
      my $index = @images;
      $args{'-format'} = "gif -index $index";
@@ -164,7 +179,20 @@ sub _get_gif_info
 {
  my ($obj) = @_;
  my $info;
- if (defined(my $file = $obj->cget(-file)) && eval { require Image::Info; 1; })
+ if (my $gif = $obj->{'_gif_info_'})
+  {
+   my $first = $gif->{'frames'}[0];
+   if ($first)
+    {
+     $obj->{'_blank_'}  = $first->{'disposal'} == 2 || $first->{'disposal'} == 3;
+     $obj->{'_period_'} = $first->{'delay'}*10 if $first->{'delay'};
+    }
+   if (defined $gif->{'loop'})
+    {
+     $obj->{'_loop_'} = $gif->{'loop'} ? $gif->{'loop'} : 'forever';
+    }
+  }
+ elsif (defined(my $file = $obj->cget(-file)) && eval { require Image::Info; 1; })
   {
    $info = Image::Info::image_info($file);
   }
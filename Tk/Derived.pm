@@ -8,7 +8,7 @@ use strict;
 use Carp;
 
 use vars qw($VERSION);
-$VERSION = '4.011'; # sprintf '4.%03d', q$Revision: #10 $ =~ /\D(\d+)\s*$/;
+$VERSION = '4.012'; # sprintf '4.%03d', q$Revision: #10 $ =~ /\D(\d+)\s*$/;
 
 $Tk::Derived::Debug = 0;
 
@@ -49,10 +49,24 @@ sub Subconfigure
  # This finds the widget or widgets to to which to apply a particular
  # configure option
  my ($cw,$opt) = @_;
- my $config = $cw->ConfigSpecs;
+ # Look in the cache of options already resolved first: construction
+ # alone configures every option at least once, and then cget and
+ # configure resolve the same few over and over. The cache is dropped
+ # by anything which could change the answer - ConfigSpecs, ConfigAlias
+ # and Advertise - and is kept with the widget so that it goes, along
+ # with the references it holds to the widget, when the widget does.
+ my $cache = $cw->TkHash('_Subconfigure_');
+ if (defined $opt && exists $cache->{$opt})
+  {
+   my $hit = $cache->{$opt};
+   return (wantarray) ? @$hit : $hit->[0];
+  }
+ my $config = $cw->TkHash('ConfigSpecs');
  my $widget;
  my @subwidget = ();
  my @arg = ();
+ my $key = $opt;
+ my $static = defined $opt;
  if (defined $opt)
   {
    $widget = $config->{$opt};
@@ -110,11 +124,13 @@ sub Subconfigure
     }
    elsif ($widget eq 'DESCENDANTS')
     {
-     push(@subwidget,$cw->Descendants)
+     push(@subwidget,$cw->Descendants);
+     $static = 0;
     }
    elsif ($widget eq 'CHILDREN')
     {
-     push(@subwidget,$cw->children)
+     push(@subwidget,$cw->children);
+     $static = 0;
     }
    elsif ($widget eq 'METHOD')
     {
@@ -144,6 +160,7 @@ sub Subconfigure
     }
   }
  $cw->BackTrace("No delegate subwidget '$widget' for $opt") unless (@subwidget);
+ $cache->{$key} = [@subwidget] if ($static);
  return (wantarray) ? @subwidget : $subwidget[0];
 }
 
@@ -400,6 +417,8 @@ sub ConfigDefault
 sub ConfigSpecs
 {
  my $cw = shift;
+ # Caller may change the specs through the hash returned
+ %{$cw->{'_Subconfigure_'}} = () if (exists $cw->{'_Subconfigure_'});
  my $specs = $cw->TkHash('ConfigSpecs');
  while (@_)
   {
@@ -490,6 +509,7 @@ sub Advertise
  croak 'No widget' unless (defined $widget);
  my $hash = $cw->TkHash('SubWidget');
  $hash->{$name} = $widget;              # advertise it
+ %{$cw->{'_Subconfigure_'}} = () if (exists $cw->{'_Subconfigure_'});
  return $widget;
 }
 
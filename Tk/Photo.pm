@@ -1,7 +1,7 @@
 package Tk::Photo;
 
 use vars qw($VERSION);
-$VERSION = '4.006'; # sprintf '4.%03d', 4+q$Revision: #4 $ =~ /\D(\d+)\s*$/;
+$VERSION = '4.007'; # sprintf '4.%03d', 4+q$Revision: #4 $ =~ /\D(\d+)\s*$/;
 
 use Tk qw($XS_VERSION);
 
@@ -18,5 +18,125 @@ use Tk::Submethods (
     'transparency'  => [qw/get set/],
 );
 
+# Reads queued by ReadAsync are kept per MainWindow and done one step
+# per idle callback, so that pending events (scrolling, expose, ...)
+# are handled between the steps rather than after all the reads.
+# A file is decoded into a scratch photo in one step: the format
+# readers cannot be suspended part way through a file.  The next step
+# copies the result into the target in one go, so a partly read image
+# is never shown, and the target is left untouched if the file cannot
+# be read or the read is cancelled.
+
+sub ReadAsync
+{
+ my ($image,$file,@opts) = @_;
+ my %args;
+ while (@opts)
+  {
+   my $opt = shift(@opts);
+   if ($opt eq '-shrink')
+    {
+     $args{$opt} = 1;
+    }
+   elsif ($opt eq '-from' || $opt eq '-to')
+    {
+     # Coordinates may be given as a list or an array reference.
+     my @xy;
+     push(@xy,shift(@opts)) while @opts && $opts[0] =~ /^-?\d+$/;
+     $args{$opt} = (@xy) ? \@xy : shift(@opts);
+    }
+   else
+    {
+     $args{$opt} = shift(@opts);
+    }
+  }
+ my $cb = delete $args{'-command'};
+ my $job = { image => $image, file => $file, args => \%args };
+ $job->{'command'} = Tk::Callback->new($cb) if defined $cb;
+ my $mw = Tk::Widget::MainWindow($image);
+ my $q  = $mw->privateData('Tk::Photo');
+ push(@{$q->{'reads'}},$job);
+ $q->{'after'} ||= $mw->afterIdle([\&_ReadNext,$mw]);
+ return $job;
+}
+
+sub CancelRead
+{
+ my ($image,$job) = @_;
+ my $q = Tk::Widget::MainWindow($image)->privateData('Tk::Photo');
+ my $reads = $q->{'reads'} || [];
+ my $n = @$reads;
+ @$reads = grep { $_->{'image'} != $image ||
+                  (defined($job) && $_ != $job) } @$reads;
+ $n -= @$reads;
+ my $cur = $q->{'current'};
+ if ($cur && $cur->{'image'} == $image && (!defined($job) || $cur == $job))
+  {
+   # Decoded but not yet copied in: drop the scratch photo.
+   delete $q->{'current'};
+   my $tmp = delete $cur->{'tmp'};
+   $tmp->delete if $tmp;
+   $n++;
+  }
+ return $n;
+}
+
+sub _ReadNext
+{
+ my ($mw) = @_;
+ my $q = $mw->privateData('Tk::Photo');
+ delete $q->{'after'};
+ my $err;
+ my $job = $q->{'current'};
+ if ($job)
+  {
+   eval { $job->{'image'}->copy($job->{'tmp'},@{$job->{'copy'}}) };
+   $err = _ReadDone($q,$job,$@);
+  }
+ else
+  {
+   _ReadStart($mw,$q,\$err);
+  }
+ $q->{'after'} ||= $mw->afterIdle([\&_ReadNext,$mw])
+   if $q->{'current'} || @{$q->{'reads'}};
+ die $err if $err;
+}
+
+sub _ReadStart
+{
+ my ($mw,$q,$errRef) = @_;
+ my $job = shift(@{$q->{'reads'}});
+ return unless $job;
+ my %args = %{$job->{'args'}};
+ my @copy;
+ foreach my $opt ('-from','-to')
+  {
+   my $xy = delete $args{$opt};
+   push(@copy,$opt => @$xy) if $xy && @$xy;
+  }
+ push(@copy,'-shrink') if delete $args{'-shrink'};
+ $job->{'copy'} = \@copy;
+ my $tmp = eval { Tk::Photo->new($mw,-file => $job->{'file'},%args) };
+ my $err = $@;
+ $job->{'tmp'} = $tmp;
+ return $q->{'current'} = $job unless $err;
+ $$errRef = _ReadDone($q,$job,$err);
+ return;
+}
+
+sub _ReadDone
+{
+ my ($q,$job,$err) = @_;
+ delete $q->{'current'};
+ my $tmp = delete $job->{'tmp'};
+ $tmp->delete if $tmp;
+ if ($job->{'command'})
+  {
+   $job->{'command'}->Call($job->{'image'},$err ? $err : undef);
+   return;
+  }
+ return $err;
+}
+
 1;
 __END__
@@ -3,7 +3,7 @@
 # modify it under the same terms as Perl itself.
 package Tk::Widget;
 use vars qw($VERSION @DefaultMenuLabels);
-$VERSION = '4.036'; # was: sprintf '4.%03d', q$Revision: #30 $ =~ /\D(\d+)\s*$/;
+$VERSION = '4.037'; # was: sprintf '4.%03d', q$Revision: #30 $ =~ /\D(\d+)\s*$/;
 
 require Tk;
 use AutoLoader;
@@ -501,6 +501,21 @@ sub afterIdle
  return Tk::After->new($w,'idle','once',@_);
 }
 
+# Run code with idle handlers held back, so that the redisplay and
+# geometry work its changes schedule is done once, at the end.
+sub batch
+{
+ my ($w,$code,@args) = @_;
+ my @result;
+ Tk::Event::HoldIdle(1);
+ my $ok = eval { @result = wantarray ? $code->(@args) : scalar($code->(@args)); 1 };
+ my $err = $@;
+ Tk::Event::HoldIdle(-1);
+ $w->idletasks if !Tk::Event::HoldIdle() && Tk::Exists($w);
+ die $err unless $ok;
+ return wantarray ? @result : $result[0];
+}
+
 sub afterInfo {
     my ($w, $id) = @_;
     if (defined $id) {
@@ -49,10 +49,30 @@ Tcl_FSOpenFileChannel(interp, pathPtr, modeString, permissions)
 
 
 
+/* Channels are named by perl filehandles, as "STDOUT", "main::FH" or
+   "*main::FH" (what a glob stringifies to).
+ */
 Tcl_Channel
 Tcl_GetChannel (Tcl_Interp *interp,CONST char *chanName, int *modePtr)
 {
- Tcl_SprintfResult(interp,"Tcl_GetChannel %s not implemeted",chanName);
+ dTHX;
+ CONST char *name = (*chanName == '*') ? chanName+1 : chanName;
+ GV *gv = gv_fetchpv(name, 0, SVt_PVIO);
+ IO *io = (gv) ? GvIO(gv) : NULL;
+ if (io && (IoOFP(io) || IoIFP(io)))
+  {
+   if (modePtr)
+    {
+     *modePtr = 0;
+     if (IoOFP(io))
+      *modePtr |= TCL_WRITABLE;
+     if (IoIFP(io) && IoTYPE(io) != IoTYPE_WRONLY && IoTYPE(io) != IoTYPE_APPEND)
+      *modePtr |= TCL_READABLE;
+    }
+   return (Tcl_Channel) ((IoOFP(io)) ? IoOFP(io) : IoIFP(io));
+  }
+ if (interp)
+  Tcl_SprintfResult(interp,"can not find channel named \"%s\"",chanName);
  return NULL;
 }
 
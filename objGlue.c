@@ -1034,6 +1034,16 @@ Tcl_AppendStringsToObj (Tcl_Obj *obj,...)
   }
 }
 
+/*
+ * Tcl_GetIndexFromObj remembers the table and index it resolved in the
+ * key's internal rep, as core Tcl does, so that a method name or option
+ * switch used over and over is not looked up in the table each time.
+ */
+
+static Tcl_ObjType tclIndexType;
+static void IndexCache _ANSI_ARGS_((Tcl_Obj *objPtr, CONST char **tablePtr,
+				    int index));
+
 /*
  *----------------------------------------------------------------------
  *
@@ -1076,12 +1086,34 @@ Tcl_GetIndexFromObj(interp, objPtr, tablePtr, msg, flags, indexPtr)
     CONST char *key, *p1, *p2, **entryPtr;
     Tcl_Obj *resultPtr;
 
+    key = Tcl_GetStringFromObj(objPtr, &length);
+
+    /*
+     * See if there is a cached result from a previous lookup in this
+     * table.  The string is checked again in case the SV was changed
+     * behind our back without its set magic being called.  Only an
+     * exact match is trusted: a changed key may be a prefix of the
+     * cached entry without being a unique abbreviation of it.
+     */
+
+    if ((length > 0) && (TclObjGetType(objPtr) == &tclIndexType)) {
+	Tcl_InternalRep *repPtr = TclObjInternal(objPtr);
+	if (repPtr->twoPtrValue.ptr1 == (VOID *) tablePtr) {
+	    index = (int) PTR2IV(repPtr->twoPtrValue.ptr2);
+	    p2 = tablePtr[index];
+	    if ((strncmp(key, p2, (size_t) length) == 0)
+		    && (p2[length] == 0)) {
+		*indexPtr = index;
+		return TCL_OK;
+	    }
+	}
+    }
+
     /*
      * Lookup the value of the object in the table.  Accept unique
      * abbreviations unless TCL_EXACT is set in flags.
      */
 
-    key = Tcl_GetStringFromObj(objPtr, &length);
     index = -1;
     numAbbrev = 0;
     for (entryPtr = tablePtr, i = 0; *entryPtr != NULL; entryPtr++, i++) {
@@ -1109,6 +1141,7 @@ Tcl_GetIndexFromObj(interp, objPtr, tablePtr, msg, flags, indexPtr)
     }
 
     done:
+    IndexCache(objPtr, tablePtr, index);
     *indexPtr = index;
     return TCL_OK;
 
@@ -1359,6 +1392,32 @@ Tcl_ObjType perlDummyType = {
   IntSetFromAnyProc
 };
 
+static void
+IndexDupProc(Tcl_Obj *src,Tcl_Obj *dst)
+{
+ dTHX;
+ SvSetMagicSV(dst,src);
+ TclObjSetType(dst,&tclIndexType);
+ *TclObjInternal(dst) = *TclObjInternal(src);
+}
+
+static int
+IndexSetFromAnyProc(Tcl_Interp *interp, Tcl_Obj *obj)
+{
+ if (interp)
+  Tcl_SetResult(interp,"can't convert value to index except via Tcl_GetIndexFromObj API",TCL_STATIC);
+ return TCL_ERROR;
+}
+
+/* internalRep.twoPtrValue holds the table and the index within it */
+static Tcl_ObjType tclIndexType = {
+  "index",
+  DummyFreeProc,
+  IndexDupProc,
+  IntUpdateStringProc,
+  IndexSetFromAnyProc
+};
+
 typedef struct
 {
  Tcl_ObjType *type;
@@ -1558,6 +1617,33 @@ Tcl_ObjMagic(Tcl_Obj *obj,int add)
  return NULL;
 }
 
+static void
+IndexCache(Tcl_Obj *obj, CONST char **tablePtr, int index)
+{
+ dTHX;
+ Tcl_ObjType *type;
+ Tcl_InternalRep *rep;
+ /* Only plain strings, or ones that carry nothing but our own magic,
+  * are worth remembering - anything else may be tied, a reference or
+  * have an internal rep (e.g. a number) we must not replace.
+  */
+ if (SvROK(obj) || !SvPOK(obj))
+  return;
+ if (SvMAGICAL(obj))
+  {
+   MAGIC *mg = SvMAGIC(obj);
+   if (mg->mg_virtual != &TclObj_vtab || mg->mg_moremagic)
+    return;
+  }
+ type = TclObjGetType(obj);
+ if (type != &perlDummyType && type != &tclIndexType)
+  return;
+ TclObjSetType(obj,&tclIndexType);
+ rep = TclObjInternal(obj);
+ rep->twoPtrValue.ptr1 = (VOID *) tablePtr;
+ rep->twoPtrValue.ptr2 = INT2PTR(VOID *,(IV) index);
+}
+
 Tcl_Obj *
 Tcl_DuplicateObj(Tcl_Obj *src)
 {
@@ -87,6 +87,34 @@ static XrmQuarkList Qclass;     /* class Quark list (malloced) */
 static int Qsize  = 0;          /* Number of slots in Quark lists */
 static int Qindex = 0;          /* index just beyond cacheWindow in Quark list */
 
+/*
+ * Per-window cache of Xrm search lists. Resolving the window's
+ * name/class path against the database is the expensive part of an
+ * option lookup, and it is the same for every option of the window,
+ * so we do it once with XrmQGetSearchList() and then resolve each
+ * option with a cheap XrmQGetSearchResource(). Entries are keyed
+ * by TkWindow * and are stale once searchEpoch moves on (any change
+ * to the database) or the window's class changes.
+ */
+
+typedef struct SearchCache {
+    XrmDatabase database;       /* Database the list was built from */
+    unsigned long epoch;        /* Value of searchEpoch when built */
+    int size;                   /* Number of slots in list */
+    XrmHashTable *list;         /* Search list (malloced) */
+} SearchCache;
+
+#define SEARCH_LIST_MIN   32
+#define SEARCH_LIST_MAX 8192
+
+static Tcl_HashTable searchTable;
+static int searchTableInit = 0;
+static unsigned long searchEpoch = 1;
+
+static SearchCache *	GetSearchList _ANSI_ARGS_((TkWindow *winPtr,
+			    XrmDatabase database));
+static void		ForgetSearchList _ANSI_ARGS_((TkWindow *winPtr));
+
 
 #ifdef XRM_DEBUG
 static void
@@ -147,6 +175,115 @@ int depth;
  return depth+1;
 }
 
+/*
+ *--------------------------------------------------------------
+ *
+ * GetSearchList --
+ *
+ *  Return the cached Xrm search list for winPtr, (re)building it
+ *  if there is none or it is out of date.
+ *
+ * Results:
+ *  Pointer to the cache entry, or NULL if a search list could not
+ *  be built (caller should fall back to XrmQGetResource).
+ *
+ * Side effects:
+ *  May update the quark lists and cachedWindow.
+ *
+ *--------------------------------------------------------------
+ */
+
+static SearchCache *
+GetSearchList(winPtr, database)
+TkWindow *winPtr;
+XrmDatabase database;
+{
+ Tcl_HashEntry *hPtr;
+ SearchCache *cachePtr;
+ int isNew;
+
+ if (!searchTableInit)
+  {
+   Tcl_InitHashTable(&searchTable, TCL_ONE_WORD_KEYS);
+   searchTableInit = 1;
+  }
+ hPtr = Tcl_CreateHashEntry(&searchTable, (char *) winPtr, &isNew);
+ if (isNew)
+  {
+   cachePtr = (SearchCache *) ckalloc(sizeof(SearchCache));
+   cachePtr->database = NULL;
+   cachePtr->epoch = 0;
+   cachePtr->size = SEARCH_LIST_MIN;
+   cachePtr->list = (XrmHashTable *) ckalloc(cachePtr->size * sizeof(XrmHashTable));
+   Tcl_SetHashValue(hPtr, cachePtr);
+  }
+ else
+  {
+   cachePtr = (SearchCache *) Tcl_GetHashValue(hPtr);
+   if (cachePtr->epoch == searchEpoch && cachePtr->database == database)
+    {
+     return cachePtr;
+    }
+  }
+
+ if (winPtr != cachedWindow)
+  {
+   Qindex = SetupQuarks(winPtr,3);
+   cachedWindow = winPtr;
+  }
+ Qname[Qindex]  = NULLQUARK;
+ Qclass[Qindex] = NULLQUARK;
+
+ while (!XrmQGetSearchList(database, Qname, Qclass,
+                           cachePtr->list, cachePtr->size))
+  {
+   if (cachePtr->size >= SEARCH_LIST_MAX)
+    {
+     ForgetSearchList(winPtr);
+     return NULL;
+    }
+   cachePtr->size *= 2;
+   cachePtr->list = (XrmHashTable *) ckrealloc((char *) cachePtr->list,
+                                     cachePtr->size * sizeof(XrmHashTable));
+  }
+ cachePtr->database = database;
+ cachePtr->epoch = searchEpoch;
+ return cachePtr;
+}
+
+/*
+ *--------------------------------------------------------------
+ *
+ * ForgetSearchList --
+ *
+ *  Discard any cached search list for winPtr.
+ *
+ * Results:
+ *  None.
+ *
+ * Side effects:
+ *  Memory is freed.
+ *
+ *--------------------------------------------------------------
+ */
+
+static void
+ForgetSearchList(winPtr)
+TkWindow *winPtr;
+{
+ Tcl_HashEntry *hPtr;
+ if (!searchTableInit)
+  return;
+ hPtr = Tcl_FindHashEntry(&searchTable, (char *) winPtr);
+ if (hPtr != NULL)
+  {
+   SearchCache *cachePtr = (SearchCache *) Tcl_GetHashValue(hPtr);
+   ckfree((char *) cachePtr->list);
+   ckfree((char *) cachePtr);
+   Tcl_DeleteHashEntry(hPtr);
+  }
+}
+
 /*
  *--------------------------------------------------------------
  *
@@ -163,7 +300,8 @@ int depth;
  * Side  effects:
  *  The  internal  caches  used  to  speed  up  option  mapping
  *  may  be  modified,  if  this  tkwin  is  different  from  the
- *  last  tkwin  used  for  option  retrieval.
+ *  last  tkwin  used  for  option  retrieval, or  its  search
+ *  list  has  not  been  computed  yet.
  *
  *--------------------------------------------------------------
  */
@@ -181,12 +319,37 @@ CONST char *className;            /* Class of option.  NULL means there
  XrmDatabase database;
  XrmRepresentation type = NULLQUARK;
  XrmValue value;
+ SearchCache *cachePtr;
 
  if (winPtr->mainPtr->optionRootPtr == NULL)
   {
    OptionInit(winPtr->mainPtr);
   }
 
+ database = (XrmDatabase) winPtr->mainPtr->optionRootPtr;
+ if (database == NULL)
+  {
+   return NULL;
+  }
+
+ memset(&value,0,sizeof(value));
+
+ cachePtr = GetSearchList(winPtr, database);
+ if (cachePtr != NULL)
+  {
+   if (XrmQGetSearchResource(cachePtr->list, XrmStringToQuark(name),
+                             XrmStringToQuark(className), &type, &value))
+    {
+#ifdef XRM_DEBUG
+     fprintf(stdout, "%s(%s/%s) type=%s val=%.*s\n",
+             Tk_PathName(winPtr), name, className,
+             XrmQuarkToString(type), (int) value.size, value.addr);
+#endif
+     return Tk_GetUid(value.addr);
+    }
+   return NULL;
+  }
+
  if (winPtr != cachedWindow)
   {
    Qindex = SetupQuarks(winPtr,3);
@@ -210,11 +373,7 @@ CONST char *className;            /* Class of option.  NULL means there
  Qshow(stdout,"Class",Qclass);
 #endif
 
- database = (XrmDatabase) winPtr->mainPtr->optionRootPtr;
-
- memset(&value,0,sizeof(value));
-
- if (database && XrmQGetResource(database, Qname, Qclass, &type, &value))
+ if (XrmQGetResource(database, Qname, Qclass, &type, &value))
   {
 #ifdef XRM_DEBUG
    fprintf(stdout, "%s(%s/%s) type=%s val=%.*s\n",
@@ -267,6 +426,7 @@ int priority;                     /* Overall priority level to use for
  /* XrmMergeDatabases ? */
 
  XrmPutStringResource(&database, name, value);
+ searchEpoch++;
 #ifdef XRM_DEBUG
  fprintf(stdout, "Xrm_AddOption %p %s %s %d\n", database, name, value, priority);
 #endif
@@ -352,6 +512,7 @@ Tcl_Obj *CONST args[];                  /* Argument strings. */
     }
    cachedWindow = NULL;
    Qindex = 0;
+   searchEpoch++;
    return TCL_OK;
   }
  else if ((c == 'g') && (strncmp(Tcl_GetString(args[1]), "get", length) == 0))
@@ -475,6 +636,12 @@ void
 XrmOptionClassChanged(winPtr)
 TkWindow *winPtr;                 /* Window whose class changed. */
 {
+ ForgetSearchList(winPtr);
+ if (winPtr->childList != NULL)
+  {
+   /* Descendants' search paths include our class */
+   searchEpoch++;
+  }
  if (winPtr == cachedWindow)
   {
    if (cachedWindow->parentPtr)
@@ -605,6 +772,7 @@ int priority;                     /* Priority level to use for options in
       }
      XrmCombineFileDatabase(realName, (XrmDatabase *)(&winPtr->mainPtr->optionRootPtr),
                             (priority > TK_STARTUP_FILE_PRIO));
+     searchEpoch++;
     }
    else
     {
@@ -127,12 +127,47 @@ static Tk_ConfigSpec configSpecs[] = {
 	(char *) NULL, 0, 0}
 };
 
+/*
+ * Image data is encoded a few kilobytes at a time through the following
+ * structure.  Each time the buffer fills up it is appended to the
+ * interpreter's result and, if the output goes to a channel, the result
+ * is written out there and emptied, so that the Postscript for a large
+ * image never has to be held in memory all at once.
+ */
+
+#define PS_ENCODE_SIZE	4096	/* Size of encoding buffer. */
+#define PS_LINE_LENGTH	64	/* Encoded characters per output line. */
+
+typedef struct PsEncoder {
+    Tcl_Interp *interp;		/* Interpreter whose result receives the
+				 * encoded data. */
+    TkPostscriptInfo *psInfoPtr;
+				/* Postscript job the data is part of. */
+    int ascii85;		/* Non-zero means encode as ASCII85,
+				 * zero means as hex digits. */
+    unsigned long tuple;	/* ASCII85 bytes waiting to be encoded. */
+    int count;			/* Number of bytes in tuple. */
+    int lineLen;		/* Characters output on the current line. */
+    int used;			/* Characters used in buf. */
+    char buf[PS_ENCODE_SIZE + 8];
+				/* Encoded characters not yet appended
+				 * to the result. */
+} PsEncoder;
+
 /*
  * Forward declarations for procedures defined later in this file:
  */
 
 static int		GetPostscriptPoints _ANSI_ARGS_((Tcl_Interp *interp,
 			    char *string, double *doublePtr));
+static void		PsEncodeByte _ANSI_ARGS_((PsEncoder *encPtr,
+			    int byte));
+static void		PsEncodeEnd _ANSI_ARGS_((PsEncoder *encPtr));
+static void		PsEncodeFlush _ANSI_ARGS_((PsEncoder *encPtr));
+static void		PsEncodeInit _ANSI_ARGS_((PsEncoder *encPtr,
+			    Tcl_Interp *interp, TkPostscriptInfo *psInfoPtr,
+			    int ascii85));
+static void		PsEncodeTuple _ANSI_ARGS_((PsEncoder *encPtr));
 
 /*
  *--------------------------------------------------------------
@@ -1181,6 +1216,193 @@ TkImageGetColor(cdata, pixel, red, green, blue)
 }
 #endif
 
+/*
+ *--------------------------------------------------------------
+ *
+ * PsEncodeInit --
+ *
+ *	Prepare a PsEncoder for a new run of image data.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	*encPtr is initialized.
+ *
+ *--------------------------------------------------------------
+ */
+
+static void
+PsEncodeInit(encPtr, interp, psInfoPtr, ascii85)
+    PsEncoder *encPtr;		/* Encoder to initialize. */
+    Tcl_Interp *interp;		/* Interpreter receiving the output. */
+    TkPostscriptInfo *psInfoPtr;
+				/* Postscript job the data is part of. */
+    int ascii85;		/* Non-zero means ASCII85, zero hex. */
+{
+    encPtr->interp = interp;
+    encPtr->psInfoPtr = psInfoPtr;
+    encPtr->ascii85 = ascii85;
+    encPtr->tuple = 0;
+    encPtr->count = 0;
+    encPtr->lineLen = 0;
+    encPtr->used = 0;
+}
+
+/*
+ *--------------------------------------------------------------
+ *
+ * PsEncodeFlush --
+ *
+ *	Move the encoded characters buffered in a PsEncoder to the
+ *	interpreter's result, and from there to the output channel
+ *	if the Postscript is being written to one.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The interpreter's result may be written out and reset.
+ *
+ *--------------------------------------------------------------
+ */
+
+static void
+PsEncodeFlush(encPtr)
+    PsEncoder *encPtr;
+{
+    if (encPtr->used > 0) {
+	encPtr->buf[encPtr->used] = '\0';
+	Tcl_AppendResult(encPtr->interp, encPtr->buf, (char *) NULL);
+	encPtr->used = 0;
+    }
+    if (encPtr->psInfoPtr->chan != NULL) {
+	Tcl_Write(encPtr->psInfoPtr->chan,
+		Tcl_GetStringResult(encPtr->interp), -1);
+	Tcl_ResetResult(encPtr->interp);
+    }
+}
+
+/*
+ *--------------------------------------------------------------
+ *
+ * PsEncodeTuple --
+ *
+ *	Output the bytes collected for one ASCII85 group.  A partial
+ *	group (at the end of the data) yields one character more than
+ *	it has bytes, as the ASCII85Decode filter expects.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Characters are added to the encoder's buffer.
+ *
+ *--------------------------------------------------------------
+ */
+
+static void
+PsEncodeTuple(encPtr)
+    PsEncoder *encPtr;
+{
+    char digits[5];
+    unsigned long tuple = encPtr->tuple;
+    int i, n;
+
+    if ((encPtr->count == 4) && (tuple == 0)) {
+	encPtr->buf[encPtr->used++] = 'z';
+	encPtr->lineLen++;
+    } else {
+	tuple <<= 8 * (4 - encPtr->count);
+	for (i = 4; i >= 0; i--) {
+	    digits[i] = (char) ('!' + tuple % 85);
+	    tuple /= 85;
+	}
+	n = encPtr->count + 1;
+	for (i = 0; i < n; i++) {
+	    encPtr->buf[encPtr->used++] = digits[i];
+	}
+	encPtr->lineLen += n;
+    }
+    encPtr->tuple = 0;
+    encPtr->count = 0;
+}
+
+/*
+ *--------------------------------------------------------------
+ *
+ * PsEncodeByte --
+ *
+ *	Add one byte of image data to a PsEncoder.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Encoded data may be flushed to the result or the channel.
+ *
+ *--------------------------------------------------------------
+ */
+
+static void
+PsEncodeByte(encPtr, byte)
+    PsEncoder *encPtr;
+    int byte;			/* Value to encode, 0..255. */
+{
+    static CONST char hexDigits[] = "0123456789ABCDEF";
+
+    if (encPtr->ascii85) {
+	encPtr->tuple = (encPtr->tuple << 8) | (byte & 0xff);
+	if (++encPtr->count < 4) {
+	    return;
+	}
+	PsEncodeTuple(encPtr);
+    } else {
+	encPtr->buf[encPtr->used++] = hexDigits[(byte >> 4) & 0xf];
+	encPtr->buf[encPtr->used++] = hexDigits[byte & 0xf];
+	encPtr->lineLen += 2;
+    }
+    if (encPtr->lineLen >= PS_LINE_LENGTH) {
+	encPtr->buf[encPtr->used++] = '\n';
+	encPtr->lineLen = 0;
+    }
+    if (encPtr->used >= PS_ENCODE_SIZE) {
+	PsEncodeFlush(encPtr);
+    }
+}
+
+/*
+ *--------------------------------------------------------------
+ *
+ * PsEncodeEnd --
+ *
+ *	Finish a run of image data: output any partial ASCII85 group
+ *	and the end-of-data marker ("~>" or ">").
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	All buffered data is flushed.
+ *
+ *--------------------------------------------------------------
+ */
+
+static void
+PsEncodeEnd(encPtr)
+    PsEncoder *encPtr;
+{
+    if (encPtr->ascii85) {
+	if (encPtr->count > 0) {
+	    PsEncodeTuple(encPtr);
+	}
+	encPtr->buf[encPtr->used++] = '~';
+    }
+    encPtr->buf[encPtr->used++] = '>';
+    encPtr->lineLen = 0;
+    PsEncodeFlush(encPtr);
+}
+
 /*
  *--------------------------------------------------------------
  *
@@ -1223,6 +1445,7 @@ TkPostscriptImage(interp, tkwin, psInfo, ximage, x, y, width, height)
     int i, ncolors;
     Visual *visual;
     TkColormapData cdata;
+    PsEncoder enc;
 
     if (psInfoPtr->prepass) {
 	return TCL_OK;
@@ -1312,22 +1535,11 @@ TkPostscriptImage(interp, tkwin, psInfo, ximage, x, y, width, height)
 
     for (band = height-1; band >= 0; band -= maxRows) {
 	int rows = (band >= maxRows) ? maxRows : band + 1;
-	int lineLen = 0;
-	switch (level) {
-	    case 0:
-		sprintf(buffer, "%d %d 1 matrix {\n<", width, rows);
-		Tcl_AppendResult(interp, buffer, (char *) NULL);
-		break;
-	    case 1:
-		sprintf(buffer, "%d %d 8 matrix {\n<", width, rows);
-		Tcl_AppendResult(interp, buffer, (char *) NULL);
-		break;
-	    case 2:
-		sprintf(buffer, "%d %d 8 matrix {\n<",
-			width, rows);
-		Tcl_AppendResult(interp, buffer, (char *) NULL);
-		break;
-	}
+
+	sprintf(buffer, "%d %d %d matrix {\n<", width, rows,
+		(level == 0) ? 1 : 8);
+	Tcl_AppendResult(interp, buffer, (char *) NULL);
+	PsEncodeInit(&enc, interp, psInfoPtr, 0);
 	for (yy = band; yy > band - rows; yy--) {
 	    switch (level) {
 		case 0: {
@@ -1345,22 +1557,13 @@ TkPostscriptImage(interp, tkwin, psInfo, ximage, x, y, width, height)
 			    data |= mask;
 			mask >>= 1;
 			if (mask == 0) {
-			    sprintf(buffer, "%02X", data);
-			    Tcl_AppendResult(interp, buffer, (char *) NULL);
-			    lineLen += 2;
-			    if (lineLen > 60) {
-			        lineLen = 0;
-			        Tcl_AppendResult(interp, "\n", (char *) NULL);
-			    }
+			    PsEncodeByte(&enc, data);
 			    mask=0x80;
 			    data=0x00;
 			}
 		    }
 		    if ((width % 8) != 0) {
-		        sprintf(buffer, "%02X", data);
-		        Tcl_AppendResult(interp, buffer, (char *) NULL);
-		        mask=0x80;
-		        data=0x00;
+			PsEncodeByte(&enc, data);
 		    }
 		    break;
 		}
@@ -1372,14 +1575,8 @@ TkPostscriptImage(interp, tkwin, psInfo, ximage, x, y, width, height)
 		    for (xx = x; xx < x+width; xx ++) {
 			TkImageGetColor(&cdata, XGetPixel(ximage, xx, yy),
 					&red, &green, &blue);
-			sprintf(buffer, "%02X", (int) floor(0.5 + 255.0 *
+			PsEncodeByte(&enc, (int) floor(0.5 + 255.0 *
 				(0.30 * red + 0.59 * green + 0.11 * blue)));
-			Tcl_AppendResult(interp, buffer, (char *) NULL);
-			lineLen += 2;
-			if (lineLen > 60) {
-			    lineLen = 0;
-			    Tcl_AppendResult(interp, "\n", (char *) NULL);
-			}
 		    }
 		    break;
 		}
@@ -1391,25 +1588,19 @@ TkPostscriptImage(interp, tkwin, psInfo, ximage, x, y, width, height)
 		    for (xx = x; xx < x+width; xx++) {
 			TkImageGetColor(&cdata, XGetPixel(ximage, xx, yy),
 				&red, &green, &blue);
-			sprintf(buffer, "%02X%02X%02X",
-				(int) floor(0.5 + 255.0 * red),
-				(int) floor(0.5 + 255.0 * green),
-				(int) floor(0.5 + 255.0 * blue));
-			Tcl_AppendResult(interp, buffer, (char *) NULL);
-			lineLen += 6;
-			if (lineLen > 60) {
-			    lineLen = 0;
-			    Tcl_AppendResult(interp, "\n", (char *) NULL);
-			}
+			PsEncodeByte(&enc, (int) floor(0.5 + 255.0 * red));
+			PsEncodeByte(&enc, (int) floor(0.5 + 255.0 * green));
+			PsEncodeByte(&enc, (int) floor(0.5 + 255.0 * blue));
 		    }
 		    break;
 		}
 	    }
 	}
-	switch (level) {
-	    case 0: sprintf(buffer, ">\n} image\n"); break;
-	    case 1: sprintf(buffer, ">\n} image\n"); break;
-	    case 2: sprintf(buffer, ">\n} false 3 colorimage\n"); break;
+	PsEncodeEnd(&enc);
+	if (level == 2) {
+	    sprintf(buffer, "\n} false 3 colorimage\n");
+	} else {
+	    sprintf(buffer, "\n} image\n");
 	}
 	Tcl_AppendResult(interp, buffer, (char *) NULL);
 	sprintf(buffer, "0 %d translate\n", rows);
@@ -1454,7 +1645,7 @@ Tk_PostscriptPhoto(interp, blockPtr, psInfo, width, height)
     unsigned char *pixelPtr;
     char buffer[256], cspace[40], decode[40];
     int bpc;
-    int xx, yy, lineLen;
+    int xx, yy;
     float red, green, blue;
     int alpha;
     int bytesPerLine=0, maxWidth=0;
@@ -1462,6 +1653,7 @@ Tk_PostscriptPhoto(interp, blockPtr, psInfo, width, height)
     unsigned char opaque = 255;
     unsigned char *alphaPtr;
     int alphaOffset, alphaPitch, alphaIncr;
+    PsEncoder enc;
 
     if (psInfoPtr->prepass) {
 	codeIncluded = 0;
@@ -1651,7 +1843,7 @@ Tk_PostscriptPhoto(interp, blockPtr, psInfo, width, height)
     Tcl_AppendResult(interp,
 	    "<<\n  /ImageType 1\n", buffer,
 	    "  /DataSource currentfile",
-	    "  /ASCIIHexDecode filter\n", (char *) NULL);
+	    "  /ASCII85Decode filter\n", (char *) NULL);
 
 
     sprintf(buffer,
@@ -1686,7 +1878,8 @@ Tk_PostscriptPhoto(interp, blockPtr, psInfo, width, height)
     }
 
 
-    for (yy = 0, lineLen=0; yy < height; yy++) {
+    PsEncodeInit(&enc, interp, psInfoPtr, 1);
+    for (yy = 0; yy < height; yy++) {
 	switch (colorLevel) {
 	    case 0: {
 		/*
@@ -1723,20 +1916,13 @@ Tk_PostscriptPhoto(interp, blockPtr, psInfo, width, height)
 		    }
 		    mask >>= 1;
 		    if (mask == 0) {
-			sprintf(buffer, "%02X", data);
-			Tcl_AppendResult(interp, buffer, (char *) NULL);
-			lineLen += 2;
-			if (lineLen >= 60) {
-			    lineLen = 0;
-			    Tcl_AppendResult(interp, "\n", (char *) NULL);
-			}
+			PsEncodeByte(&enc, data);
 			mask=0x80;
 			data=0x00;
 		    }
 		}
 		if ((width % 8) != 0) {
-		    sprintf(buffer, "%02X", data);
-		    Tcl_AppendResult(interp, buffer, (char *) NULL);
+		    PsEncodeByte(&enc, data);
 		    mask=0x80;
 		    data=0x00;
 		}
@@ -1767,20 +1953,13 @@ Tk_PostscriptPhoto(interp, blockPtr, psInfo, width, height)
 		    }
 		    mask >>= 1;
 		    if (mask == 0) {
-			sprintf(buffer, "%02X", data);
-			Tcl_AppendResult(interp, buffer, (char *) NULL);
-			lineLen += 2;
-			if (lineLen >= 60) {
-			    lineLen = 0;
-			    Tcl_AppendResult(interp, "\n", (char *) NULL);
-			}
+			PsEncodeByte(&enc, data);
 			mask=0x80;
 			data=0x00;
 		    }
 		}
 		if ((width % 8) != 0) {
-		    sprintf(buffer, "%02X", data);
-		    Tcl_AppendResult(interp, buffer, (char *) NULL);
+		    PsEncodeByte(&enc, data);
 		    mask=0x80;
 		    data=0x00;
 		}
@@ -1796,13 +1975,7 @@ Tk_PostscriptPhoto(interp, blockPtr, psInfo, width, height)
 		for (xx = 0; xx < width; xx ++) {
 		    alpha = *(alphaPtr + (yy * alphaPitch)
 			    + (xx * alphaIncr) + alphaOffset);
-		    sprintf(buffer, "%02X", alpha | 0x01);
-		    Tcl_AppendResult(interp, buffer, (char *) NULL);
-		    lineLen += 2;
-		    if (lineLen >= 60) {
-			lineLen = 0;
-			Tcl_AppendResult(interp, "\n", (char *) NULL);
-		    }
+		    PsEncodeByte(&enc, alpha | 0x01);
 		}
 
 
@@ -1820,14 +1993,8 @@ Tk_PostscriptPhoto(interp, blockPtr, psInfo, width, height)
 		    green = pixelPtr[blockPtr->offset[1]];
 		    blue = pixelPtr[blockPtr->offset[2]];
 
-		    sprintf(buffer, "%02X", (int) floor(0.5 +
+		    PsEncodeByte(&enc, (int) floor(0.5 +
 			    ( 0.3086 * red + 0.6094 * green + 0.0820 * blue)));
-		    Tcl_AppendResult(interp, buffer, (char *) NULL);
-		    lineLen += 2;
-		    if (lineLen >= 60) {
-			lineLen = 0;
-			Tcl_AppendResult(interp, "\n", (char *) NULL);
-		    }
 		}
 		break;
 	    }
@@ -1841,13 +2008,7 @@ Tk_PostscriptPhoto(interp, blockPtr, psInfo, width, height)
 		for (xx = 0; xx < width; xx ++) {
 		    alpha = *(alphaPtr + (yy * alphaPitch)
 			    + (xx * alphaIncr) + alphaOffset);
-		    sprintf(buffer, "%02X", alpha | 0x01);
-		    Tcl_AppendResult(interp, buffer, (char *) NULL);
-		    lineLen += 2;
-		    if (lineLen >= 60) {
-			lineLen = 0;
-			Tcl_AppendResult(interp, "\n", (char *) NULL);
-		    }
+		    PsEncodeByte(&enc, alpha | 0x01);
 		}
 
 
@@ -1861,23 +2022,17 @@ Tk_PostscriptPhoto(interp, blockPtr, psInfo, width, height)
 			+ (yy * blockPtr->pitch)
 			+ (xx *blockPtr->pixelSize);
 
-		    sprintf(buffer, "%02X%02X%02X",
-			    pixelPtr[blockPtr->offset[0]],
-			    pixelPtr[blockPtr->offset[1]],
-			    pixelPtr[blockPtr->offset[2]]);
-		    Tcl_AppendResult(interp, buffer, (char *) NULL);
-		    lineLen += 6;
-		    if (lineLen >= 60) {
-			lineLen = 0;
-			Tcl_AppendResult(interp, "\n", (char *) NULL);
-		    }
+		    PsEncodeByte(&enc, pixelPtr[blockPtr->offset[0]]);
+		    PsEncodeByte(&enc, pixelPtr[blockPtr->offset[1]]);
+		    PsEncodeByte(&enc, pixelPtr[blockPtr->offset[2]]);
 		}
 		break;
 	    }
 	}
     }
 
-    Tcl_AppendResult(interp, ">\n", (char *) NULL);
+    PsEncodeEnd(&enc);
+    Tcl_AppendResult(interp, "\n", (char *) NULL);
     return TCL_OK;
 }
 
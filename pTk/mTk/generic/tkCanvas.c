@@ -270,6 +270,23 @@ extern Tk_ItemType tkArcType, tkBitmapType, tkImageType, tkLineType;
 extern Tk_ItemType tkOvalType, tkPolygonType;
 extern Tk_ItemType tkRectangleType, tkTextType, tkWindowType;
 
+/*
+ * Two damage rectangles are merged if their union is no bigger than
+ * this many pixels more than the rectangles themselves:  below that, the
+ * cost of a separate pixmap and copy outweighs the pixels saved.
+ */
+
+#define DAMAGE_MERGE_SLACK	4096
+
+/*
+ * Returns non-zero if the bounding box of an item is entirely outside
+ * the given area.
+ */
+
+#define ItemOutside(itemPtr, ax1, ay1, ax2, ay2) \
+	(((itemPtr)->x1 >= (ax2)) || ((itemPtr)->y1 >= (ay2)) \
+	|| ((itemPtr)->x2 < (ax1)) || ((itemPtr)->y2 < (ay1)))
+
 /*
  * Prototypes for procedures defined later in this file:
  */
@@ -298,6 +315,10 @@ static void             CanvasSetOrigin _ANSI_ARGS_((TkCanvas *canvasPtr,
 			    int xOrigin, int yOrigin));
 static void             CanvasUpdateScrollbars _ANSI_ARGS_((
 			    TkCanvas *canvasPtr));
+static void             CanvasScrollContents _ANSI_ARGS_((
+			    TkCanvas *canvasPtr));
+static void             AddDamage _ANSI_ARGS_((TkCanvas *canvasPtr,
+			    int x1, int y1, int x2, int y2));
 static int              CanvasWidgetCmd _ANSI_ARGS_((ClientData clientData,
 			    Tcl_Interp *interp, int argc, Tcl_Obj *CONST *args));
 static void             CanvasWorldChanged _ANSI_ARGS_((
@@ -439,6 +460,13 @@ Tk_CanvasObjCmd(clientData, interp, argc, objv)
     canvasPtr->highlightColorPtr = NULL;
     canvasPtr->inset = 0;
     canvasPtr->pixmapGC = None;
+    canvasPtr->scrollGC = None;
+    canvasPtr->shiftX = 0;
+    canvasPtr->shiftY = 0;
+    canvasPtr->numDamage = 0;
+    canvasPtr->redrawCount = 0;
+    canvasPtr->redrawRects = 0;
+    canvasPtr->redrawPixels = 0.0;
     canvasPtr->width = None;
     canvasPtr->height = None;
     canvasPtr->confine = 0;
@@ -564,6 +592,8 @@ CanvasWidgetCmd(clientData, interp, objc, objv)
 #else /* USE_OLD_TAG_SEARCH */
     TagSearch *searchPtr = NULL;        /* Allocated by first TagSearchScan
 					 * Freed by TagSearchDestroy */
+    ClientData mark;                    /* Arena memory to give back on
+					 * return; see TagSearchScan */
 #endif /* USE_OLD_TAG_SEARCH */
 
     int index;
@@ -574,8 +604,8 @@ CanvasWidgetCmd(clientData, interp, objc, objv)
 	"find",         "focus",        "gettags",      "icursor",
 	"index",        "insert",       "itemcget",     "itemconfigure",
 	"lower",        "move",         "postscript",   "raise",
-	"scale",        "scan",         "select",       "type",
-	"xview",        "yview",
+	"redrawstats",  "scale",        "scan",         "select",
+	"type",         "xview",        "yview",
 	NULL
     };
     enum options {
@@ -585,8 +615,8 @@ CanvasWidgetCmd(clientData, interp, objc, objv)
 	CANV_FIND,      CANV_FOCUS,     CANV_GETTAGS,   CANV_ICURSOR,
 	CANV_INDEX,     CANV_INSERT,    CANV_ITEMCGET,  CANV_ITEMCONFIGURE,
 	CANV_LOWER,     CANV_MOVE,      CANV_POSTSCRIPT,CANV_RAISE,
-	CANV_SCALE,     CANV_SCAN,      CANV_SELECT,    CANV_TYPE,
-	CANV_XVIEW,     CANV_YVIEW,
+	CANV_REDRAWSTATS, CANV_SCALE,   CANV_SCAN,      CANV_SELECT,
+	CANV_TYPE,      CANV_XVIEW,     CANV_YVIEW,
 	CANV_VISITOR
     };
 
@@ -606,6 +636,9 @@ CanvasWidgetCmd(clientData, interp, objc, objv)
 
     }
     Tcl_Preserve((ClientData) canvasPtr);
+#ifndef USE_OLD_TAG_SEARCH
+    mark = Tcl_ArenaMark();
+#endif /* not USE_OLD_TAG_SEARCH */
 
     result = TCL_OK;
     switch ((enum options) index) {
@@ -1630,6 +1663,36 @@ CanvasWidgetCmd(clientData, interp, objc, objv)
 #endif /* USE_OLD_TAG_SEARCH */
 	break;
       }
+      case CANV_REDRAWSTATS: {
+	Tcl_Obj *resultObj;
+
+	if ((objc != 2) && ((objc != 3)
+		|| strcmp(Tcl_GetString(objv[2]), "reset") != 0)) {
+	    Tcl_WrongNumArgs(interp, 2, objv, "?reset?");
+	    result = TCL_ERROR;
+	    goto done;
+	}
+
+	/*
+	 * Return the number of redisplays, of areas painted and of
+	 * pixels painted, for profiling redraw costs.
+	 */
+
+	resultObj = Tcl_NewListObj(0, NULL);
+	Tcl_ListObjAppendElement(NULL, resultObj,
+		Tcl_NewLongObj(canvasPtr->redrawCount));
+	Tcl_ListObjAppendElement(NULL, resultObj,
+		Tcl_NewLongObj(canvasPtr->redrawRects));
+	Tcl_ListObjAppendElement(NULL, resultObj,
+		Tcl_NewDoubleObj(canvasPtr->redrawPixels));
+	Tcl_SetObjResult(interp, resultObj);
+	if (objc == 3) {
+	    canvasPtr->redrawCount = 0;
+	    canvasPtr->redrawRects = 0;
+	    canvasPtr->redrawPixels = 0.0;
+	}
+	break;
+      }
       case CANV_SCALE: {
 	double xOrigin, yOrigin, xScale, yScale;
 
@@ -2027,6 +2090,7 @@ CanvasWidgetCmd(clientData, interp, objc, objv)
     done:
 #ifndef USE_OLD_TAG_SEARCH
     TagSearchDestroy(searchPtr);
+    Tcl_ArenaRelease(mark);
 #endif /* not USE_OLD_TAG_SEARCH */
     Tcl_Release((ClientData) canvasPtr);
     return result;
@@ -2088,6 +2152,9 @@ DestroyCanvas(memPtr)
     if (canvasPtr->pixmapGC != None) {
 	Tk_FreeGC(canvasPtr->display, canvasPtr->pixmapGC);
     }
+    if (canvasPtr->scrollGC != None) {
+	Tk_FreeGC(canvasPtr->display, canvasPtr->scrollGC);
+    }
     if (canvasPtr->tile != NULL) {
 	Tk_FreeTile(canvasPtr->tile);
     }
@@ -2387,7 +2454,6 @@ DisplayCanvas(clientData)
     TkCanvas *canvasPtr = (TkCanvas *) clientData;
     Tk_Window tkwin = canvasPtr->tkwin;
     Tk_Item *itemPtr;
-    Pixmap pixmap;
     int screenX1, screenX2, screenY1, screenY2, width, height;
 #ifndef _LANG
     Tcl_DString updateCmd;
@@ -2404,6 +2470,7 @@ DisplayCanvas(clientData)
 #endif
 
     if (!Tk_IsMapped(tkwin)) {
+	canvasPtr->shiftX = canvasPtr->shiftY = 0;
 	goto done;
     }
 
@@ -2423,6 +2490,16 @@ DisplayCanvas(clientData)
 	}
     }
 
+    /*
+     * If the view was scrolled since the last redisplay, move the
+     * pixels that are still visible into place before deciding what
+     * has to be redrawn.
+     */
+
+    if ((canvasPtr->shiftX != 0) || (canvasPtr->shiftY != 0)) {
+	CanvasScrollContents(canvasPtr);
+    }
+
     /*
      * Scan through the item list, registering the bounding box
      * for all items that didn't do that for the final coordinates
@@ -2438,35 +2515,47 @@ DisplayCanvas(clientData)
 	}
     }
     /*
-     * Compute the intersection between the area that needs redrawing
+     * Compute the intersection between each area that needs redrawing
      * and the area that's visible on the screen.
      */
 
-    if ((canvasPtr->redrawX1 < canvasPtr->redrawX2)
-	    && (canvasPtr->redrawY1 < canvasPtr->redrawY2)) {
+    if (canvasPtr->numDamage > 0) {
+	TkCanvasDamage areas[CANVAS_MAX_DAMAGE];
+	Pixmap pixmaps[CANVAS_MAX_DAMAGE];
+	TkCanvasDamage *areaPtr;
+	int numAreas, i, hit;
+
 	screenX1 = canvasPtr->xOrigin + canvasPtr->inset;
 	screenY1 = canvasPtr->yOrigin + canvasPtr->inset;
 	screenX2 = canvasPtr->xOrigin + Tk_Width(tkwin) - canvasPtr->inset;
 	screenY2 = canvasPtr->yOrigin + Tk_Height(tkwin) - canvasPtr->inset;
-	if (canvasPtr->redrawX1 > screenX1) {
-	    screenX1 = canvasPtr->redrawX1;
-	}
-	if (canvasPtr->redrawY1 > screenY1) {
-	    screenY1 = canvasPtr->redrawY1;
-	}
-	if (canvasPtr->redrawX2 < screenX2) {
-	    screenX2 = canvasPtr->redrawX2;
-	}
-	if (canvasPtr->redrawY2 < screenY2) {
-	    screenY2 = canvasPtr->redrawY2;
+	numAreas = 0;
+	for (i = 0; i < canvasPtr->numDamage; i++) {
+	    areaPtr = &areas[numAreas];
+	    *areaPtr = canvasPtr->damage[i];
+	    if (areaPtr->x1 < screenX1) {
+		areaPtr->x1 = screenX1;
+	    }
+	    if (areaPtr->y1 < screenY1) {
+		areaPtr->y1 = screenY1;
+	    }
+	    if (areaPtr->x2 > screenX2) {
+		areaPtr->x2 = screenX2;
+	    }
+	    if (areaPtr->y2 > screenY2) {
+		areaPtr->y2 = screenY2;
+	    }
+	    if ((areaPtr->x1 < areaPtr->x2) && (areaPtr->y1 < areaPtr->y2)) {
+		numAreas++;
+	    }
 	}
-	if ((screenX1 >= screenX2) || (screenY1 >= screenY2)) {
+	if (numAreas == 0) {
 	    goto borders;
 	}
 
 	/*
-	 * Redrawing is done in a temporary pixmap that is allocated
-	 * here and freed at the end of the procedure.  All drawing
+	 * Redrawing is done in temporary pixmaps, one for each area,
+	 * that are allocated here and freed at the end of the procedure.  All drawing
 	 * is done to the pixmap, and the pixmap is copied to the
 	 * screen at the end of the procedure. The temporary pixmap
 	 * serves two purposes:
@@ -2501,75 +2590,86 @@ DisplayCanvas(clientData)
 #else
 #    define Overlap 30
 #endif
-	canvasPtr->drawableXOrigin = screenX1 - Overlap;
-	canvasPtr->drawableYOrigin = screenY1 - Overlap;
-	pixmap = Tk_GetPixmap(Tk_Display(tkwin), Tk_WindowId(tkwin),
-	    (screenX2 + Overlap - canvasPtr->drawableXOrigin),
-	    (screenY2 + Overlap - canvasPtr->drawableYOrigin),
-	    Tk_Depth(tkwin));
-
-	/*
-	 * Clear the area to be redrawn.
-	 */
-
-	width = screenX2 - screenX1;
-	height = screenY2 - screenY1;
 
 	tile = canvasPtr->tile;
 	if (canvasPtr->canvas_state == TK_STATE_DISABLED &&
 		canvasPtr->disabledTile != NULL) {
 	    tile = canvasPtr->disabledTile;
 	}
-	if (tile != NULL) {
-	    int w=0; int h=0;
-	    int flags = canvasPtr->tsoffset.flags;
-	    if (flags & (TK_OFFSET_CENTER|TK_OFFSET_MIDDLE)) {
-		Tk_SizeOfTile(tile, &w, &h);
-		if (flags & TK_OFFSET_CENTER) {
-		    w /= 2;
-		} else {
-		    w = 0;
-		}
-		if (flags & TK_OFFSET_MIDDLE) {
-		    h /= 2;
-		} else {
-		    h = 0;
+	for (i = 0, areaPtr = areas; i < numAreas; i++, areaPtr++) {
+	    canvasPtr->drawableXOrigin = areaPtr->x1 - Overlap;
+	    canvasPtr->drawableYOrigin = areaPtr->y1 - Overlap;
+	    pixmaps[i] = TkGetBufferPixmap(tkwin,
+		(areaPtr->x2 + Overlap - canvasPtr->drawableXOrigin),
+		(areaPtr->y2 + Overlap - canvasPtr->drawableYOrigin));
+
+	    /*
+	     * Clear the area to be redrawn.
+	     */
+
+	    width = areaPtr->x2 - areaPtr->x1;
+	    height = areaPtr->y2 - areaPtr->y1;
+	    if (tile != NULL) {
+		int w=0; int h=0;
+		int flags = canvasPtr->tsoffset.flags;
+		if (flags & (TK_OFFSET_CENTER|TK_OFFSET_MIDDLE)) {
+		    Tk_SizeOfTile(tile, &w, &h);
+		    if (flags & TK_OFFSET_CENTER) {
+			w /= 2;
+		    } else {
+			w = 0;
+		    }
+		    if (flags & TK_OFFSET_MIDDLE) {
+			h /= 2;
+		    } else {
+			h = 0;
+		    }
 		}
+		canvasPtr->tsoffset.xoffset -= w;
+		canvasPtr->tsoffset.yoffset -= h;
+		Tk_CanvasSetOffset((Tk_Canvas) canvasPtr, canvasPtr->pixmapGC,
+			&canvasPtr->tsoffset);
+		canvasPtr->tsoffset.xoffset += w;
+		canvasPtr->tsoffset.yoffset += h;
 	    }
-	    canvasPtr->tsoffset.xoffset -= w;
-	    canvasPtr->tsoffset.yoffset -= h;
-	    Tk_CanvasSetOffset((Tk_Canvas) canvasPtr, canvasPtr->pixmapGC, &canvasPtr->tsoffset);
-	    canvasPtr->tsoffset.xoffset += w;
-	    canvasPtr->tsoffset.yoffset += h;
-	}
 
-	XFillRectangle(Tk_Display(tkwin), pixmap, canvasPtr->pixmapGC,
-		screenX1 - canvasPtr->drawableXOrigin,
-		screenY1 - canvasPtr->drawableYOrigin, (unsigned int) width,
-		(unsigned int) height);
-	if (tile != NULL) {
-	    XSetTSOrigin(Tk_Display(tkwin), canvasPtr->pixmapGC, 0, 0);
+	    XFillRectangle(Tk_Display(tkwin), pixmaps[i], canvasPtr->pixmapGC,
+		    areaPtr->x1 - canvasPtr->drawableXOrigin,
+		    areaPtr->y1 - canvasPtr->drawableYOrigin,
+		    (unsigned int) width, (unsigned int) height);
+	    if (tile != NULL) {
+		XSetTSOrigin(Tk_Display(tkwin), canvasPtr->pixmapGC, 0, 0);
+	    }
+	    canvasPtr->redrawRects++;
+	    canvasPtr->redrawPixels += (double) width * height;
 	}
+	canvasPtr->redrawCount++;
 
 	/*
 	 * Scan through the item list, redrawing those items that need it.
-	 * An item must be redraw if either (a) it intersects the smaller
-	 * on-screen area or (b) it intersects the full canvas area and its
-	 * type requests that it be redrawn always (e.g. so subwindows can
-	 * be unmapped when they move off-screen).
+	 * An item must be redraw if either (a) it intersects one of the
+	 * on-screen areas or (b) it intersects the full damaged area and
+	 * its type requests that it be redrawn always (e.g. so subwindows
+	 * can be unmapped when they move off-screen).  Items of the second
+	 * kind are displayed once, into the first area's pixmap;  items of
+	 * the first kind into the pixmap of every area they intersect.
 	 */
 
 	for (itemPtr = canvasPtr->firstItemPtr; itemPtr != NULL;
 		itemPtr = itemPtr->nextPtr) {
-	    if ((itemPtr->x1 >= screenX2)
-		    || (itemPtr->y1 >= screenY2)
-		    || (itemPtr->x2 < screenX1)
-		    || (itemPtr->y2 < screenY1)) {
+	    hit = 0;
+	    for (i = 0, areaPtr = areas; i < numAreas; i++, areaPtr++) {
+		if (!ItemOutside(itemPtr, areaPtr->x1, areaPtr->y1,
+			areaPtr->x2, areaPtr->y2)) {
+		    hit = 1;
+		    break;
+		}
+	    }
+	    if (!hit) {
 		if (!(itemPtr->typePtr->alwaysRedraw & 1)
-			|| (itemPtr->x1 >= canvasPtr->redrawX2)
-			|| (itemPtr->y1 >= canvasPtr->redrawY2)
-			|| (itemPtr->x2 < canvasPtr->redrawX1)
-			|| (itemPtr->y2 < canvasPtr->redrawY1)) {
+			|| ItemOutside(itemPtr, canvasPtr->redrawX1,
+			    canvasPtr->redrawY1, canvasPtr->redrawX2,
+			    canvasPtr->redrawY2)) {
 		    if (!(itemPtr->redraw_flags & NEEDS_DISPLAY)) {
 			continue;
 		    }
@@ -2592,24 +2692,37 @@ DisplayCanvas(clientData)
 		continue;
 	    }
 	    itemPtr->redraw_flags &= ~NEEDS_DISPLAY;
-	    (*itemPtr->typePtr->displayProc)((Tk_Canvas) canvasPtr, itemPtr,
-		    canvasPtr->display, pixmap, screenX1, screenY1, width,
-		    height);
+	    for (i = 0, areaPtr = areas; i < numAreas; i++, areaPtr++) {
+		if (hit && ItemOutside(itemPtr, areaPtr->x1, areaPtr->y1,
+			areaPtr->x2, areaPtr->y2)) {
+		    continue;
+		}
+		canvasPtr->drawableXOrigin = areaPtr->x1 - Overlap;
+		canvasPtr->drawableYOrigin = areaPtr->y1 - Overlap;
+		(*itemPtr->typePtr->displayProc)((Tk_Canvas) canvasPtr,
+			itemPtr, canvasPtr->display, pixmaps[i],
+			areaPtr->x1, areaPtr->y1, areaPtr->x2 - areaPtr->x1,
+			areaPtr->y2 - areaPtr->y1);
+		if (!hit) {
+		    break;
+		}
+	    }
 	}
 
 	/*
-	 * Copy from the temporary pixmap to the screen, then free up
-	 * the temporary pixmap.
+	 * Copy from the temporary pixmaps to the screen, then free up
+	 * the temporary pixmaps.
 	 */
 
-	XCopyArea(Tk_Display(tkwin), pixmap, Tk_WindowId(tkwin),
-		canvasPtr->pixmapGC,
-		screenX1 - canvasPtr->drawableXOrigin,
-		screenY1 - canvasPtr->drawableYOrigin,
-		(unsigned) (screenX2 - screenX1),
-		(unsigned) (screenY2 - screenY1),
-		screenX1 - canvasPtr->xOrigin, screenY1 - canvasPtr->yOrigin);
-	Tk_FreePixmap(Tk_Display(tkwin), pixmap);
+	for (i = 0, areaPtr = areas; i < numAreas; i++, areaPtr++) {
+	    XCopyArea(Tk_Display(tkwin), pixmaps[i], Tk_WindowId(tkwin),
+		    canvasPtr->pixmapGC, Overlap, Overlap,
+		    (unsigned) (areaPtr->x2 - areaPtr->x1),
+		    (unsigned) (areaPtr->y2 - areaPtr->y1),
+		    areaPtr->x1 - canvasPtr->xOrigin,
+		    areaPtr->y1 - canvasPtr->yOrigin);
+	    TkFreeBufferPixmap(tkwin, pixmaps[i]);
+	}
     }
 
     /*
@@ -2646,6 +2759,7 @@ DisplayCanvas(clientData)
 
     done:
     canvasPtr->flags &= ~(REDRAW_PENDING|BBOX_NOT_EMPTY);
+    canvasPtr->numDamage = 0;
     canvasPtr->redrawX1 = canvasPtr->redrawX2 = 0;
     canvasPtr->redrawY1 = canvasPtr->redrawY2 = 0;
     if (canvasPtr->flags & UPDATE_SCROLLBARS) {
@@ -2714,6 +2828,18 @@ CanvasEventProc(clientData, eventPtr)
 	Tk_CanvasEventuallyRedraw((Tk_Canvas) canvasPtr, x, y,
 		x + eventPtr->xexpose.width,
 		y + eventPtr->xexpose.height);
+	if ((canvasPtr->shiftX != 0) || (canvasPtr->shiftY != 0)) {
+	    /*
+	     * A pending scroll copy will carry the exposed pixels along;
+	     * redraw where they will end up too.
+	     */
+
+	    x += canvasPtr->shiftX;
+	    y += canvasPtr->shiftY;
+	    Tk_CanvasEventuallyRedraw((Tk_Canvas) canvasPtr, x, y,
+		    x + eventPtr->xexpose.width,
+		    y + eventPtr->xexpose.height);
+	}
 	if ((eventPtr->xexpose.x < canvasPtr->inset)
 		|| (eventPtr->xexpose.y < canvasPtr->inset)
 		|| ((eventPtr->xexpose.x + eventPtr->xexpose.width)
@@ -2853,6 +2979,43 @@ Tk_CanvasEventuallyRedraw(canvas, x1, y1, x2, y2)
 	    (y1 >= canvasPtr->yOrigin + Tk_Height(canvasPtr->tkwin))) {
 	return;
     }
+    AddDamage(canvasPtr, x1, y1, x2, y2);
+    if (!(canvasPtr->flags & REDRAW_PENDING)) {
+	Tcl_DoWhenIdle(DisplayCanvas, (ClientData) canvasPtr);
+	canvasPtr->flags |= REDRAW_PENDING;
+    }
+}
+
+/*
+ *--------------------------------------------------------------
+ *
+ * AddDamage --
+ *
+ *      Record that an area of the canvas needs to be redrawn.  The
+ *      area is added to the overall bounding box of the damage and,
+ *      clipped to the window, to the list of damage rectangles.
+ *      Rectangles are merged when that costs little, or when the
+ *      list is full.
+ *
+ * Results:
+ *      None.
+ *
+ * Side effects:
+ *      The damage information in canvasPtr is updated.
+ *
+ *--------------------------------------------------------------
+ */
+
+static void
+AddDamage(canvasPtr, x1, y1, x2, y2)
+    TkCanvas *canvasPtr;        /* Information about widget. */
+    int x1, y1;                 /* Upper left corner of area to redraw. */
+    int x2, y2;                 /* Lower right corner of area to redraw. */
+{
+    TkCanvasDamage *dPtr;
+    long area, unionArea, growth, bestGrowth;
+    int i, best, ux1, uy1, ux2, uy2;
+
     if (canvasPtr->flags & BBOX_NOT_EMPTY) {
 	if (x1 <= canvasPtr->redrawX1) {
 	    canvasPtr->redrawX1 = x1;
@@ -2873,10 +3036,90 @@ Tk_CanvasEventuallyRedraw(canvas, x1, y1, x2, y2)
 	canvasPtr->redrawY2 = y2;
 	canvasPtr->flags |= BBOX_NOT_EMPTY;
     }
-    if (!(canvasPtr->flags & REDRAW_PENDING)) {
-	Tcl_DoWhenIdle(DisplayCanvas, (ClientData) canvasPtr);
-	canvasPtr->flags |= REDRAW_PENDING;
+
+    /*
+     * Only the part inside the window can ever be painted; the overall
+     * bounding box above still covers the rest, for items such as
+     * windows that must be told when they are off-screen.
+     */
+
+    if (x1 < canvasPtr->xOrigin) {
+	x1 = canvasPtr->xOrigin;
+    }
+    if (y1 < canvasPtr->yOrigin) {
+	y1 = canvasPtr->yOrigin;
     }
+    if (x2 > canvasPtr->xOrigin + Tk_Width(canvasPtr->tkwin)) {
+	x2 = canvasPtr->xOrigin + Tk_Width(canvasPtr->tkwin);
+    }
+    if (y2 > canvasPtr->yOrigin + Tk_Height(canvasPtr->tkwin)) {
+	y2 = canvasPtr->yOrigin + Tk_Height(canvasPtr->tkwin);
+    }
+    if ((x1 >= x2) || (y1 >= y2)) {
+	return;
+    }
+
+    /*
+     * Fold the new area into any rectangle it can share cheaply with.
+     * The grown rectangle may now be worth merging with others, so
+     * start over each time.
+     */
+
+    area = (long) (x2 - x1) * (y2 - y1);
+    while (1) {
+	best = -1;
+	bestGrowth = 0;
+	for (i = 0, dPtr = canvasPtr->damage; i < canvasPtr->numDamage;
+		i++, dPtr++) {
+	    ux1 = (dPtr->x1 < x1) ? dPtr->x1 : x1;
+	    uy1 = (dPtr->y1 < y1) ? dPtr->y1 : y1;
+	    ux2 = (dPtr->x2 > x2) ? dPtr->x2 : x2;
+	    uy2 = (dPtr->y2 > y2) ? dPtr->y2 : y2;
+	    unionArea = (long) (ux2 - ux1) * (uy2 - uy1);
+	    growth = unionArea - (long) (dPtr->x2 - dPtr->x1)
+		    * (dPtr->y2 - dPtr->y1);
+	    if (unionArea <= (long) (dPtr->x2 - dPtr->x1)
+		    * (dPtr->y2 - dPtr->y1) + area + DAMAGE_MERGE_SLACK) {
+		best = i;
+		break;
+	    }
+	    if ((canvasPtr->numDamage == CANVAS_MAX_DAMAGE)
+		    && ((best < 0) || (growth < bestGrowth))) {
+		best = i;
+		bestGrowth = growth;
+	    }
+	}
+	if (best < 0) {
+	    break;
+	}
+
+	/*
+	 * Take the chosen rectangle out of the list and continue with
+	 * the union.
+	 */
+
+	dPtr = &canvasPtr->damage[best];
+	if (dPtr->x1 < x1) {
+	    x1 = dPtr->x1;
+	}
+	if (dPtr->y1 < y1) {
+	    y1 = dPtr->y1;
+	}
+	if (dPtr->x2 > x2) {
+	    x2 = dPtr->x2;
+	}
+	if (dPtr->y2 > y2) {
+	    y2 = dPtr->y2;
+	}
+	area = (long) (x2 - x1) * (y2 - y1);
+	canvasPtr->numDamage--;
+	*dPtr = canvasPtr->damage[canvasPtr->numDamage];
+    }
+    dPtr = &canvasPtr->damage[canvasPtr->numDamage++];
+    dPtr->x1 = x1;
+    dPtr->y1 = y1;
+    dPtr->x2 = x2;
+    dPtr->y2 = y2;
 }
 
 /*
@@ -2903,7 +3146,7 @@ EventuallyRedrawItem(canvas, itemPtr)
 {
     TkCanvas *canvasPtr = (TkCanvas *) canvas;
     if (itemPtr->group) {
-	(itemPtr->group->typePtr->bboxProc)(canvas,itemPtr->group);
+	TkGroupUpdateBbox(canvas, itemPtr);
 	EventuallyRedrawItem(canvas, itemPtr->group);
     }
     if ((itemPtr->x1 >= itemPtr->x2) || (itemPtr->y1 >= itemPtr->y2) ||
@@ -2917,27 +3160,8 @@ EventuallyRedrawItem(canvas, itemPtr)
     }
 
     if (!(itemPtr->redraw_flags & FORCE_REDRAW)) {
-
-	if (canvasPtr->flags & BBOX_NOT_EMPTY) {
-	    if (itemPtr->x1 <= canvasPtr->redrawX1) {
-		canvasPtr->redrawX1 = itemPtr->x1;
-	    }
-	    if (itemPtr->y1 <= canvasPtr->redrawY1) {
-		canvasPtr->redrawY1 = itemPtr->y1;
-	    }
-	    if (itemPtr->x2 >= canvasPtr->redrawX2) {
-		canvasPtr->redrawX2 = itemPtr->x2;
-	    }
-	    if (itemPtr->y2 >= canvasPtr->redrawY2) {
-		canvasPtr->redrawY2 = itemPtr->y2;
-	    }
-	} else {
-	    canvasPtr->redrawX1 = itemPtr->x1;
-	    canvasPtr->redrawY1 = itemPtr->y1;
-	    canvasPtr->redrawX2 = itemPtr->x2;
-	    canvasPtr->redrawY2 = itemPtr->y2;
-	    canvasPtr->flags |= BBOX_NOT_EMPTY;
-	}
+	AddDamage(canvasPtr, itemPtr->x1, itemPtr->y1,
+		itemPtr->x2, itemPtr->y2);
 	itemPtr->redraw_flags |= FORCE_REDRAW;
     }
     while (itemPtr->group) {
@@ -3389,27 +3613,35 @@ TagSearchScan(canvasPtr, tagObj, searchPtrPtr)
     if (*searchPtrPtr) {
 	searchPtr = *searchPtrPtr;
     } else {
-	/* Allocate primary search struct on first call */
-	*searchPtrPtr = searchPtr = (TagSearch *) ckalloc(sizeof(TagSearch));
+	/*
+	 * Allocate primary search struct on first call.  It and the
+	 * rewrite buffer last only as long as the widget command, so
+	 * they come from the arena; the caller gives them back.
+	 */
+	*searchPtrPtr = searchPtr =
+		(TagSearch *) Tcl_ArenaAlloc(sizeof(TagSearch));
 	searchPtr->expr = NULL;
 
 	/* Allocate buffer for rewritten tags (after de-escaping) */
 	searchPtr->rewritebufferAllocated = 100;
 	searchPtr->rewritebuffer =
-	    ckalloc(searchPtr->rewritebufferAllocated);
+	    Tcl_ArenaAlloc(searchPtr->rewritebufferAllocated);
     }
     TagSearchExprInit(&(searchPtr->expr));
 
     /* How long is the tagOrId ? */
     searchPtr->stringLength = strlen(tag);
 
-    /* Make sure there is enough buffer to hold rewritten tags */
+    /*
+     * Make sure there is enough buffer to hold rewritten tags.  Its
+     * contents are not kept from one scan to the next, so a new one
+     * need not be copied from the old.
+     */
     if ((unsigned int)searchPtr->stringLength >=
 	    searchPtr->rewritebufferAllocated) {
 	searchPtr->rewritebufferAllocated = searchPtr->stringLength + 100;
 	searchPtr->rewritebuffer =
-	    ckrealloc(searchPtr->rewritebuffer,
-		    searchPtr->rewritebufferAllocated);
+	    Tcl_ArenaAlloc(searchPtr->rewritebufferAllocated);
     }
 
     /* Initialize search */
@@ -3509,7 +3741,9 @@ TagSearchScan(canvasPtr, tagObj, searchPtrPtr)
  * TagSearchDestroy --
  *
  *      This procedure destroys any dynamic structures that
- *      may have been allocated by TagSearchScan.
+ *      may have been allocated by TagSearchScan, other than those
+ *      taken from the arena, which are given back by releasing the
+ *      arena mark taken before the first scan.
  *
  * Results:
  *
@@ -3524,8 +3758,6 @@ TagSearchDestroy(searchPtr)
 {
     if (searchPtr) {
 	TagSearchExprDestroy(searchPtr->expr);
-	ckfree((char *)searchPtr->rewritebuffer);
-	ckfree((char *)searchPtr);
     }
 }
 
@@ -5763,6 +5995,27 @@ CanvasSetOrigin(canvasPtr, xOrigin, yOrigin)
 	return;
     }
 
+    /*
+     * If the window is on the screen, just remember how far its contents
+     * have to move: DisplayCanvas will copy the pixels that stay visible
+     * and redraw only the strips that scroll into view (see
+     * CanvasScrollContents).  Damage already recorded is in canvas
+     * coordinates, so it stays valid across the shift.
+     */
+
+    if (Tk_IsMapped(canvasPtr->tkwin)) {
+	canvasPtr->shiftX += canvasPtr->xOrigin - xOrigin;
+	canvasPtr->shiftY += canvasPtr->yOrigin - yOrigin;
+	canvasPtr->xOrigin = xOrigin;
+	canvasPtr->yOrigin = yOrigin;
+	canvasPtr->flags |= UPDATE_SCROLLBARS;
+	if (!(canvasPtr->flags & REDRAW_PENDING)) {
+	    Tcl_DoWhenIdle(DisplayCanvas, (ClientData) canvasPtr);
+	    canvasPtr->flags |= REDRAW_PENDING;
+	}
+	return;
+    }
+
     /*
      * Tricky point: must redisplay not only everything that's visible
      * in the window's final configuration, but also everything that was
@@ -5771,6 +6024,7 @@ CanvasSetOrigin(canvasPtr, xOrigin, yOrigin)
      * so they can explicitly undisplay themselves.
      */
 
+    canvasPtr->shiftX = canvasPtr->shiftY = 0;
     Tk_CanvasEventuallyRedraw((Tk_Canvas) canvasPtr,
 	    canvasPtr->xOrigin, canvasPtr->yOrigin,
 	    canvasPtr->xOrigin + Tk_Width(canvasPtr->tkwin),
@@ -5784,6 +6038,139 @@ CanvasSetOrigin(canvasPtr, xOrigin, yOrigin)
 	    canvasPtr->yOrigin + Tk_Height(canvasPtr->tkwin));
 }
 
+
+/*
+ *--------------------------------------------------------------
+ *
+ * CanvasScrollContents --
+ *
+ *      Called from DisplayCanvas to bring the window contents up to
+ *      date with origin changes made by CanvasSetOrigin since the
+ *      last redisplay.  Where possible the part of the old view that
+ *      is still visible is copied to its new place, so that only the
+ *      newly exposed strips (plus anything the copy could not get,
+ *      as reported by GraphicsExpose events) need to be redrawn.
+ *
+ * Results:
+ *      None.
+ *
+ * Side effects:
+ *      Pixels are copied within the canvas window and areas to
+ *      redraw are added to the damage area.  If the copy cannot be
+ *      used, both the old and the new view are scheduled for redraw.
+ *
+ *--------------------------------------------------------------
+ */
+
+static void
+CanvasScrollContents(canvasPtr)
+    TkCanvas *canvasPtr;        /* Information about canvas. */
+{
+    Tk_Window tkwin = canvasPtr->tkwin;
+    int dx = canvasPtr->shiftX, dy = canvasPtr->shiftY;
+    int x, y, width, height, blit;
+    Tk_Item *itemPtr;
+    Tk_Tile tile;
+    TkRegion damageRgn;
+    XRectangle rect;
+    XGCValues gcValues;
+
+    canvasPtr->shiftX = canvasPtr->shiftY = 0;
+    x = canvasPtr->inset;
+    y = canvasPtr->inset;
+    width = Tk_Width(tkwin) - 2*canvasPtr->inset;
+    height = Tk_Height(tkwin) - 2*canvasPtr->inset;
+
+    /*
+     * The copy is only usable if some of the old view is still visible
+     * and nothing else in the window depends on the view:  window items
+     * must be told when they move (or go off-screen), and a background
+     * tile whose offset is relative to the toplevel rather than to the
+     * canvas would not move with the contents.
+     */
+
+    blit = (dx > -width) && (dx < width) && (dy > -height) && (dy < height);
+    tile = canvasPtr->tile;
+    if (canvasPtr->canvas_state == TK_STATE_DISABLED &&
+	    canvasPtr->disabledTile != NULL) {
+	tile = canvasPtr->disabledTile;
+    }
+    if (blit && (tile != NULL)
+	    && (canvasPtr->tsoffset.flags & TK_OFFSET_RELATIVE)
+	    && !(canvasPtr->tsoffset.flags & TK_OFFSET_INDEX)) {
+	blit = 0;
+    }
+    for (itemPtr = canvasPtr->firstItemPtr; blit && (itemPtr != NULL);
+	    itemPtr = itemPtr->nextPtr) {
+	if (itemPtr->typePtr == &tkWindowType) {
+	    blit = 0;
+	}
+    }
+
+    if (!blit) {
+	/*
+	 * Redraw everything that was visible before and everything that
+	 * is visible now, as CanvasSetOrigin used to.  The old view may
+	 * not overlap the new one at all, so pass the union in one go.
+	 */
+
+	Tk_CanvasEventuallyRedraw((Tk_Canvas) canvasPtr,
+		canvasPtr->xOrigin + ((dx < 0) ? dx : 0),
+		canvasPtr->yOrigin + ((dy < 0) ? dy : 0),
+		canvasPtr->xOrigin + Tk_Width(tkwin) + ((dx > 0) ? dx : 0),
+		canvasPtr->yOrigin + Tk_Height(tkwin) + ((dy > 0) ? dy : 0));
+	return;
+    }
+
+    if (canvasPtr->scrollGC == None) {
+	gcValues.graphics_exposures = True;
+	canvasPtr->scrollGC = Tk_GetGC(tkwin, GCGraphicsExposures,
+		&gcValues);
+    }
+
+    /*
+     * Copy the part of the interior that stays visible.  Parts of the
+     * source that were obscured come back as damage, in window
+     * coordinates after the copy.
+     */
+
+    damageRgn = TkCreateRegion();
+    if (TkScrollWindow(tkwin, canvasPtr->scrollGC,
+	    x + ((dx < 0) ? -dx : 0), y + ((dy < 0) ? -dy : 0),
+	    width - ((dx < 0) ? -dx : dx), height - ((dy < 0) ? -dy : dy),
+	    dx, dy, damageRgn)) {
+	TkClipBox(damageRgn, &rect);
+	Tk_CanvasEventuallyRedraw((Tk_Canvas) canvasPtr,
+		canvasPtr->xOrigin + rect.x, canvasPtr->yOrigin + rect.y,
+		canvasPtr->xOrigin + rect.x + rect.width,
+		canvasPtr->yOrigin + rect.y + rect.height);
+    }
+    TkDestroyRegion(damageRgn);
+
+    /*
+     * Redraw the strips that scrolled into view.
+     */
+
+    if (dx > 0) {
+	Tk_CanvasEventuallyRedraw((Tk_Canvas) canvasPtr,
+		canvasPtr->xOrigin + x, canvasPtr->yOrigin + y,
+		canvasPtr->xOrigin + x + dx, canvasPtr->yOrigin + y + height);
+    } else if (dx < 0) {
+	Tk_CanvasEventuallyRedraw((Tk_Canvas) canvasPtr,
+		canvasPtr->xOrigin + x + width + dx, canvasPtr->yOrigin + y,
+		canvasPtr->xOrigin + x + width, canvasPtr->yOrigin + y + height);
+    }
+    if (dy > 0) {
+	Tk_CanvasEventuallyRedraw((Tk_Canvas) canvasPtr,
+		canvasPtr->xOrigin + x, canvasPtr->yOrigin + y,
+		canvasPtr->xOrigin + x + width, canvasPtr->yOrigin + y + dy);
+    } else if (dy < 0) {
+	Tk_CanvasEventuallyRedraw((Tk_Canvas) canvasPtr,
+		canvasPtr->xOrigin + x, canvasPtr->yOrigin + y + height + dy,
+		canvasPtr->xOrigin + x + width, canvasPtr->yOrigin + y + height);
+    }
+}
+
 /*
  *----------------------------------------------------------------------
  *
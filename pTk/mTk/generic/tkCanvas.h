@@ -35,6 +35,20 @@ struct TagSearchExpr_s {
 };
 #endif /* not USE_OLD_TAG_SEARCH */
 
+/*
+ * The area of a canvas that needs redrawing is kept as a short list of
+ * rectangles in canvas coordinates, so that small changes far apart do
+ * not force everything between them to be repainted.  When the list is
+ * full, new damage is merged into whichever rectangle grows least.
+ */
+
+#define CANVAS_MAX_DAMAGE	8
+
+typedef struct TkCanvasDamage {
+    int x1, y1;			/* Upper left corner, included. */
+    int x2, y2;			/* Lower right corner, not included. */
+} TkCanvasDamage;
+
 /*
  * The record below describes a canvas widget.  It is made available
  * to the item procedures so they can access certain shared fields such
@@ -78,6 +92,9 @@ typedef struct TkCanvas {
 				 * room for borders. */
     GC pixmapGC;		/* Used to copy bits from a pixmap to the
 				 * screen and also to clear the pixmap. */
+    GC scrollGC;		/* Used to copy the still-visible part of
+				 * the window when the view is scrolled.
+				 * Created on first use; None until then. */
     int width, height;		/* Dimensions to request for canvas window,
 				 * specified in pixels. */
     int redrawX1, redrawY1;	/* Upper left corner of area to redraw,
@@ -87,6 +104,21 @@ typedef struct TkCanvas {
     int redrawX2, redrawY2;	/* Lower right corner of area to redraw,
 				 * in integer canvas coordinates.  Border
 				 * pixels will *not* be redrawn. */
+    int numDamage;		/* Number of rectangles in damage. */
+    TkCanvasDamage damage[CANVAS_MAX_DAMAGE];
+				/* Parts of the visible area to redraw;
+				 * their union lies within redrawX1..
+				 * redrawY2, which may also cover parts
+				 * of the canvas that are off-screen. */
+    long redrawCount;		/* Number of redisplays that painted
+				 * something, for "redrawstats". */
+    long redrawRects;		/* Number of damage rectangles painted. */
+    double redrawPixels;	/* Number of pixels painted. */
+    int shiftX, shiftY;		/* Distance in pixels by which the window
+				 * contents must still be copied to catch
+				 * up with view changes since the last
+				 * redisplay.  Only meaningful while
+				 * REDRAW_PENDING is set. */
     int confine;		/* Non-zero means constrain view to keep
 				 * as much of canvas visible as possible. */
 
@@ -327,6 +359,8 @@ extern int 		TkCanvTranslatePath _ANSI_ARGS_((TkCanvas *canvPtr,
 )
 
 EXTERN void		TkGroupRemoveItem _ANSI_ARGS_((Tk_Item *item));
+EXTERN void		TkGroupUpdateBbox _ANSI_ARGS_((Tk_Canvas canvas,
+			    Tk_Item *item));
 
 #endif /* _TKCANVAS */
 
@@ -1838,8 +1838,7 @@ DisplayEntry(clientData)
      * no point in time where the on-screen image has been cleared.
      */
 
-    pixmap = Tk_GetPixmap(entryPtr->display, Tk_WindowId(tkwin),
-	    Tk_Width(tkwin), Tk_Height(tkwin), Tk_Depth(tkwin));
+    pixmap = TkGetBufferPixmap(tkwin, Tk_Width(tkwin), Tk_Height(tkwin));
 
     /*
      * Compute x-coordinate of the pixel just after last visible
@@ -2068,7 +2067,7 @@ DisplayEntry(clientData)
     XCopyArea(entryPtr->display, pixmap, Tk_WindowId(tkwin), entryPtr->textGC,
 	    0, 0, (unsigned) Tk_Width(tkwin), (unsigned) Tk_Height(tkwin),
 	    0, 0);
-    Tk_FreePixmap(entryPtr->display, pixmap);
+    TkFreeBufferPixmap(tkwin, pixmap);
     entryPtr->flags &= ~BORDER_NEEDED;
 }
 
@@ -21,6 +21,9 @@
 /* This does not belong here it belong in the platform window manager code! */
 extern Window XmuClientWindow _ANSI_ARGS_((Display *dpy, Window win));
 
+/* Names of event types, from tkBind.c; used to label the profile. */
+extern char *eventTypeName[];
+
 /*
  * There's a potential problem if a handler is deleted while it's
  * current (i.e. its procedure is executing), since Tk_HandleEvent
@@ -162,6 +165,7 @@ static Tcl_ThreadDataKey dataKey;
  */
 
 static void		DelayedMotionProc _ANSI_ARGS_((ClientData clientData));
+static void		HandleEvent _ANSI_ARGS_((XEvent *eventPtr));
 static int		WindowEventProc _ANSI_ARGS_((Tcl_Event *evPtr,
 			    int flags));
 static int		TkXErrorHandler _ANSI_ARGS_((ClientData clientData,
@@ -618,7 +622,8 @@ ParentXId(display, w)
  *	None.
  *
  * Side effects:
- *	Depends on the handlers.
+ *	Depends on the handlers.  When profiling is on the time
+ *	taken is counted against the event's type.
  *
  *--------------------------------------------------------------
  */
@@ -626,6 +631,21 @@ ParentXId(display, w)
 void
 Tk_HandleEvent(eventPtr)
     XEvent *eventPtr;		/* Event to dispatch. */
+{
+    int type = eventPtr->type;
+    double start = LangProfileStart();
+
+    HandleEvent(eventPtr);
+    if (start) {
+	LangProfileRecord("event", (type >= 0 && type < TK_LASTEVENT
+		&& eventTypeName[type]) ? eventTypeName[type] : "Other",
+		NULL, start);
+    }
+}
+
+static void
+HandleEvent(eventPtr)
+    XEvent *eventPtr;		/* Event to dispatch. */
 {
     register TkEventHandler *handlerPtr;
     register GenericHandler *genericPtr;
@@ -2,7 +2,9 @@
  * tkGC.c --
  *
  *	This file maintains a database of read-only graphics contexts
- *	for the Tk toolkit, in order to allow GC's to be shared.
+ *	for the Tk toolkit, in order to allow GC's to be shared.  It
+ *	also keeps a pool of off-screen pixmaps that widgets use to
+ *	double-buffer their redisplay.
  *
  * Copyright (c) 1990-1994 The Regents of the University of California.
  * Copyright (c) 1994 Sun Microsystems, Inc.
@@ -38,10 +40,42 @@ typedef struct {
     int depth;			/* and depth for which GC is valid. */
 } ValueKey;
 
+/*
+ * One of the following exists for each pixmap in a display's pool of
+ * redisplay buffers.  Widgets take a buffer for the duration of one
+ * redisplay and give it back at the end, so the same few pixmaps are
+ * used over and over instead of being created and freed in the server
+ * on every redisplay.
+ */
+
+typedef struct TkBufferPixmap {
+    Pixmap pixmap;		/* The off-screen buffer. */
+    int width, height;		/* Its size:  a size class, at least as
+				 * big as was asked for. */
+    int depth;			/* Depth and screen of the pixmap;  a buffer */
+    int screenNum;		/* is only reused for matching windows. */
+    int inUse;			/* Non-zero while a widget has it. */
+    int used;			/* Non-zero if taken since the last trim. */
+    struct TkBufferPixmap *nextPtr;
+				/* Next buffer of the display, or NULL. */
+} TkBufferPixmap;
+
+/*
+ * At most BUFFER_POOL_MAX buffers are kept per display.  Every
+ * BUFFER_TRIM_INTERVAL milliseconds, buffers that have not been used
+ * since the previous trim are freed, so an idle application does not
+ * hold on to server memory.
+ */
+
+#define BUFFER_POOL_MAX		16
+#define BUFFER_TRIM_INTERVAL	5000
+
 /*
  * Forward declarations for procedures defined in this file:
  */
 
+static int		BufferSizeClass _ANSI_ARGS_((int size));
+static void		BufferTrimProc _ANSI_ARGS_((ClientData clientData));
 static void		GCInit _ANSI_ARGS_((TkDisplay *dispPtr));
 
 /*
@@ -396,3 +430,305 @@ GCInit(dispPtr)
     Tcl_InitHashTable(&dispPtr->gcValueTable, sizeof(ValueKey)/sizeof(int));
     Tcl_InitHashTable(&dispPtr->gcIdTable, TCL_ONE_WORD_KEYS);
 }
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * BufferSizeClass --
+ *
+ *	Round a buffer dimension up so that requests of similar sizes
+ *	share pixmaps.  The step is an eighth of the next power of two,
+ *	so at most an eighth of each dimension is wasted.
+ *
+ * Results:
+ *	The rounded size, at least 32.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+BufferSizeClass(size)
+    int size;			/* Size wanted, in pixels. */
+{
+    int step;
+
+    if (size <= 32) {
+	return 32;
+    }
+    for (step = 32; step*8 < size; step <<= 1) {
+	/* Empty loop body. */
+    }
+    step /= 8;
+    if (step < 4) {
+	step = 4;
+    }
+    return ((size + step - 1) / step) * step;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkGetBufferPixmap --
+ *
+ *	Get an off-screen pixmap in which to redisplay part of a window.
+ *	A free pixmap of a suitable size is taken from the display's pool
+ *	if there is one;  otherwise a new one is created.
+ *
+ * Results:
+ *	A pixmap with the depth of tkwin, at least width by height
+ *	pixels in size (it may be bigger).  The caller must give it
+ *	back with TkFreeBufferPixmap, not Tk_FreePixmap.
+ *
+ * Side effects:
+ *	A pixmap may be created and added to the pool.
+ *
+ *----------------------------------------------------------------------
+ */
+
+Pixmap
+TkGetBufferPixmap(tkwin, width, height)
+    Tk_Window tkwin;		/* Window the pixmap will be copied to. */
+    int width, height;		/* Minimum size of the pixmap. */
+{
+    TkDisplay *dispPtr = ((TkWindow *) tkwin)->dispPtr;
+    TkBufferPixmap *bufPtr, *bestPtr, *freePtr;
+    int depth = Tk_Depth(tkwin);
+    int screenNum = Tk_ScreenNumber(tkwin);
+    int count;
+    double maxArea, area, bestArea;
+    Pixmap pixmap;
+
+    /*
+     * Look for the smallest free buffer that is big enough, but not
+     * more than twice the area of what a new one would be.
+     */
+
+    maxArea = 2.0 * BufferSizeClass(width) * BufferSizeClass(height);
+    bestPtr = freePtr = NULL;
+    bestArea = 0.0;
+    count = 0;
+    for (bufPtr = dispPtr->bufferPixmaps; bufPtr != NULL;
+	    bufPtr = bufPtr->nextPtr) {
+	count++;
+	if (bufPtr->inUse) {
+	    continue;
+	}
+	freePtr = bufPtr;
+	if ((bufPtr->depth != depth) || (bufPtr->screenNum != screenNum)
+		|| (bufPtr->width < width) || (bufPtr->height < height)) {
+	    continue;
+	}
+	area = (double) bufPtr->width * bufPtr->height;
+	if ((area <= maxArea) && ((bestPtr == NULL) || (area < bestArea))) {
+	    bestPtr = bufPtr;
+	    bestArea = area;
+	}
+    }
+    if (bestPtr != NULL) {
+	bestPtr->inUse = 1;
+	bestPtr->used = 1;
+	dispPtr->bufferHits++;
+	return bestPtr->pixmap;
+    }
+
+    dispPtr->bufferMisses++;
+    width = BufferSizeClass(width);
+    height = BufferSizeClass(height);
+    pixmap = Tk_GetPixmap(Tk_Display(tkwin), Tk_WindowId(tkwin),
+	    width, height, depth);
+    if (count >= BUFFER_POOL_MAX) {
+	if (freePtr == NULL) {
+	    /*
+	     * The pool is full and every buffer is in use:  this pixmap
+	     * is not kept, TkFreeBufferPixmap will free it.
+	     */
+
+	    return pixmap;
+	}
+
+	/*
+	 * Replace a free buffer that did not fit.
+	 */
+
+	Tk_FreePixmap(dispPtr->display, freePtr->pixmap);
+	bufPtr = freePtr;
+    } else {
+	bufPtr = (TkBufferPixmap *) ckalloc(sizeof(TkBufferPixmap));
+	bufPtr->nextPtr = dispPtr->bufferPixmaps;
+	dispPtr->bufferPixmaps = bufPtr;
+    }
+    bufPtr->pixmap = pixmap;
+    bufPtr->width = width;
+    bufPtr->height = height;
+    bufPtr->depth = depth;
+    bufPtr->screenNum = screenNum;
+    bufPtr->inUse = 1;
+    bufPtr->used = 1;
+    if (dispPtr->bufferTrimTimer == NULL) {
+	dispPtr->bufferTrimTimer = Tcl_CreateTimerHandler(BUFFER_TRIM_INTERVAL,
+		BufferTrimProc, (ClientData) dispPtr);
+    }
+    return pixmap;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkFreeBufferPixmap --
+ *
+ *	Give back a pixmap obtained from TkGetBufferPixmap.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The pixmap is returned to the pool, or freed if it was not
+ *	kept there.
+ *
+ *----------------------------------------------------------------------
+ */
+
+void
+TkFreeBufferPixmap(tkwin, pixmap)
+    Tk_Window tkwin;		/* Window passed to TkGetBufferPixmap. */
+    Pixmap pixmap;		/* Pixmap it returned. */
+{
+    TkDisplay *dispPtr = ((TkWindow *) tkwin)->dispPtr;
+    TkBufferPixmap *bufPtr;
+
+    for (bufPtr = dispPtr->bufferPixmaps; bufPtr != NULL;
+	    bufPtr = bufPtr->nextPtr) {
+	if (bufPtr->pixmap == pixmap) {
+	    bufPtr->inUse = 0;
+	    return;
+	}
+    }
+    Tk_FreePixmap(dispPtr->display, pixmap);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkGetBufferPixmapStats --
+ *
+ *	Report on the pool of redisplay buffers of a window's display.
+ *
+ * Results:
+ *	Fills in statsPtr with, in order:  the number of pixmaps in the
+ *	pool, the number of them in use, the total number of bytes they
+ *	occupy, and the number of requests that did (hits) and did not
+ *	(misses) find a pixmap in the pool.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+void
+TkGetBufferPixmapStats(tkwin, statsPtr)
+    Tk_Window tkwin;		/* Any window on the display. */
+    double *statsPtr;		/* Array of 5 values to fill in. */
+{
+    TkDisplay *dispPtr = ((TkWindow *) tkwin)->dispPtr;
+    TkBufferPixmap *bufPtr;
+
+    statsPtr[0] = statsPtr[1] = statsPtr[2] = 0.0;
+    for (bufPtr = dispPtr->bufferPixmaps; bufPtr != NULL;
+	    bufPtr = bufPtr->nextPtr) {
+	statsPtr[0] += 1.0;
+	if (bufPtr->inUse) {
+	    statsPtr[1] += 1.0;
+	}
+	statsPtr[2] += (double) bufPtr->width * bufPtr->height
+		* ((bufPtr->depth + 7) / 8);
+    }
+    statsPtr[3] = (double) dispPtr->bufferHits;
+    statsPtr[4] = (double) dispPtr->bufferMisses;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * BufferTrimProc --
+ *
+ *	Timer callback that frees the redisplay buffers that have not
+ *	been used since it last ran.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Pixmaps may be freed.  The timer is restarted while the pool
+ *	is not empty.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+BufferTrimProc(clientData)
+    ClientData clientData;	/* Display whose pool to trim. */
+{
+    TkDisplay *dispPtr = (TkDisplay *) clientData;
+    TkBufferPixmap *bufPtr, **prevPtrPtr;
+
+    dispPtr->bufferTrimTimer = NULL;
+    prevPtrPtr = &dispPtr->bufferPixmaps;
+    while ((bufPtr = *prevPtrPtr) != NULL) {
+	if (!bufPtr->inUse && !bufPtr->used) {
+	    *prevPtrPtr = bufPtr->nextPtr;
+	    Tk_FreePixmap(dispPtr->display, bufPtr->pixmap);
+	    ckfree((char *) bufPtr);
+	} else {
+	    bufPtr->used = 0;
+	    prevPtrPtr = &bufPtr->nextPtr;
+	}
+    }
+    if (dispPtr->bufferPixmaps != NULL) {
+	dispPtr->bufferTrimTimer = Tcl_CreateTimerHandler(BUFFER_TRIM_INTERVAL,
+		BufferTrimProc, (ClientData) dispPtr);
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkBufferPixmapCleanup --
+ *
+ *	Frees the pool of redisplay buffers of a display that is
+ *	being closed.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Pixmaps are freed and the trim timer is cancelled.
+ *
+ *----------------------------------------------------------------------
+ */
+
+void
+TkBufferPixmapCleanup(dispPtr)
+    TkDisplay *dispPtr;		/* Display to clean up resources in. */
+{
+    TkBufferPixmap *bufPtr;
+
+    if (dispPtr->bufferTrimTimer != NULL) {
+	Tcl_DeleteTimerHandler(dispPtr->bufferTrimTimer);
+	dispPtr->bufferTrimTimer = NULL;
+    }
+    while ((bufPtr = dispPtr->bufferPixmaps) != NULL) {
+	dispPtr->bufferPixmaps = bufPtr->nextPtr;
+
+	/*
+	 * Not Tk_FreePixmap:  the display is no longer on the display
+	 * list, so Tk_FreeXId cannot find it to take the id back.
+	 */
+
+	XFreePixmap(dispPtr->display, bufPtr->pixmap);
+	ckfree((char *) bufPtr);
+    }
+}
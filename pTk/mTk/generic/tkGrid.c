@@ -93,6 +93,17 @@ typedef struct SlotInfo {
      				 * calculating adjusted weights when
      				 * shrinking the layout below its
      				 * nominal size. */
+	int natural;		/* Cached from the last layout: the size
+				 * needed by the slaves lying entirely
+				 * within this slot, including minSize
+				 * and pad.  Used by GridUpdateSlaves to
+				 * decide whether a slave's new size can
+				 * change the layout. */
+	int numNatural;		/* How many things hold the slot at its
+				 * natural size:  span-1 slaves that need
+				 * exactly that much, plus one if minSize
+				 * does.  A slave may shrink away from the
+				 * natural size while another holds it. */
 } SlotInfo;
 
 /*
@@ -204,6 +215,8 @@ typedef struct Gridder {
     struct Gridder *binNextPtr;	/* Link to next span>1 slave in this bin. */
     int size;			/* Nominal size (width or height) in pixels
     				 * of the slave.  This includes the padding. */
+    int lastWidth, lastHeight;	/* Nominal width and height of the slave
+				 * used by the last layout. */
 } Gridder;
 
 /* Flag values for "sticky"ness  The 16 combinations subsume the packer's
@@ -241,10 +254,23 @@ typedef struct UniformGroup {
  *				size.  0 means if this window is a master
  *				then Tk will set its requested size to fit
  *				the needs of its slaves.
+ *
+ * REQUESTED_UPDATE:		1 means a Tcl_DoWhenIdle request has been
+ *				made to GridUpdateSlaves for this master.
+ *
+ * LAYOUT_VALID:		1 means the slot offsets and the slaves'
+ *				lastWidth/lastHeight describe the layout
+ *				made by the last complete ArrangeGrid.
+ *
+ * SIZE_CHANGED:		1 means this slave's requested size changed
+ *				since it was last arranged.
  */
 
 #define REQUESTED_RELAYOUT	1
 #define DONT_PROPAGATE		2
+#define REQUESTED_UPDATE	4
+#define LAYOUT_VALID		8
+#define SIZE_CHANGED		16
 
 /*
  * Prototypes for procedures used only in this file:
@@ -255,6 +281,8 @@ static void	AdjustForSticky _ANSI_ARGS_((Gridder *slavePtr, int *xPtr,
 static int	AdjustOffsets _ANSI_ARGS_((int width,
 			int elements, SlotInfo *slotPtr));
 static void	ArrangeGrid _ANSI_ARGS_((ClientData clientData));
+static void	ArrangeSlave _ANSI_ARGS_((Gridder *masterPtr,
+			Gridder *slavePtr));
 static int	CheckSlotData _ANSI_ARGS_((Gridder *masterPtr, int slot,
 			int slotType, int checkOnly));
 static int	ConfigureSlaves _ANSI_ARGS_((Tcl_Interp *interp,
@@ -283,6 +311,9 @@ static void	GridLostSlaveProc _ANSI_ARGS_((ClientData clientData,
 			Tk_Window tkwin));
 static void	GridReqProc _ANSI_ARGS_((ClientData clientData,
 			Tk_Window tkwin));
+static void	GridUpdateSlaves _ANSI_ARGS_((ClientData clientData));
+static int	SlotUnchanged _ANSI_ARGS_((SlotInfo *slotPtr, int slot,
+			int span, int oldSize, int newSize));
 static void 	InitMasterData _ANSI_ARGS_((Gridder *masterPtr));
 static Tcl_Obj *NewPairObj _ANSI_ARGS_((Tcl_Interp*, int, int));
 static Tcl_Obj *NewQuadObj _ANSI_ARGS_((Tcl_Interp*, int, int, int, int));
@@ -576,6 +607,9 @@ GridForgetRemoveCommand(tkwin, interp, objc, objv)
 		if (slavePtr->flags & REQUESTED_RELAYOUT) {
 		    Tcl_CancelIdleCall(ArrangeGrid, (ClientData) slavePtr);
 		}
+		if (slavePtr->flags & REQUESTED_UPDATE) {
+		    Tcl_CancelIdleCall(GridUpdateSlaves, (ClientData) slavePtr);
+		}
 		slavePtr->flags = 0;
 		slavePtr->sticky = 0;
 	    }
@@ -1210,13 +1244,166 @@ GridReqProc(clientData, tkwin)
 {
     register Gridder *gridPtr = (Gridder *) clientData;
 
+    /*
+     * Rather than re-solving the whole layout, note which slave changed
+     * and let GridUpdateSlaves decide whether the rows and columns it
+     * occupies are affected at all.
+     */
+
+    gridPtr->flags |= SIZE_CHANGED;
     gridPtr = gridPtr->masterPtr;
-    if (gridPtr && !(gridPtr->flags & REQUESTED_RELAYOUT)) {
-	gridPtr->flags |= REQUESTED_RELAYOUT;
-	Tcl_DoWhenIdle(ArrangeGrid, (ClientData) gridPtr);
+    if (gridPtr && !(gridPtr->flags & (REQUESTED_RELAYOUT|REQUESTED_UPDATE))) {
+	gridPtr->flags |= REQUESTED_UPDATE;
+	Tcl_DoWhenIdle(GridUpdateSlaves, (ClientData) gridPtr);
     }
 }
 
+/*
+ *--------------------------------------------------------------
+ *
+ * SlotUnchanged --
+ *
+ *	Decide whether a slave whose nominal size along one axis went
+ *	from oldSize to newSize can alter the size of the slot it
+ *	occupies.  Slaves that tie for the largest size in a slot are
+ *	counted, so one of them may shrink while another is left.
+ *
+ * Results:
+ *	1 if the slot (and so the whole layout) is certainly unaffected,
+ *	0 if the layout has to be recomputed.
+ *
+ * Side effects:
+ *	The slot's count of slaves at its natural size is kept up to
+ *	date when 1 is returned.
+ *
+ *--------------------------------------------------------------
+ */
+
+static int
+SlotUnchanged(slotPtr, slot, span, oldSize, newSize)
+    SlotInfo *slotPtr;		/* Row or column constraints of master. */
+    int slot;			/* First slot occupied by the slave. */
+    int span;			/* Number of slots the slave spans. */
+    int oldSize, newSize;	/* Old and new nominal size of the slave. */
+{
+    int natural;
+
+    if (oldSize == newSize) {
+	return 1;
+    }
+    if ((span != 1) || (slotPtr[slot].uniform != NULL)) {
+	return 0;
+    }
+
+    /*
+     * The slot keeps its size if the slave does not outgrow it and, if
+     * it was the largest one in it, something else is as large.
+     */
+
+    natural = slotPtr[slot].natural;
+    oldSize += slotPtr[slot].pad;
+    newSize += slotPtr[slot].pad;
+    if (newSize > natural) {
+	return 0;
+    }
+    if (oldSize == natural) {
+	if (slotPtr[slot].numNatural <= 1) {
+	    return 0;
+	}
+	slotPtr[slot].numNatural--;
+    } else if (newSize == natural) {
+	slotPtr[slot].numNatural++;
+    }
+    return 1;
+}
+
+/*
+ *--------------------------------------------------------------
+ *
+ * GridUpdateSlaves --
+ *
+ *	This procedure is invoked (using the Tcl_DoWhenIdle
+ *	mechanism) after slaves of a master changed their requested
+ *	size.  Slaves whose change cannot affect the size of any row
+ *	or column are simply re-arranged in their cells; otherwise
+ *	the whole master is laid out again.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Slaves of masterPtr may get resized or moved.
+ *
+ *--------------------------------------------------------------
+ */
+
+static void
+GridUpdateSlaves(clientData)
+    ClientData clientData;	/* Structure describing master whose slaves
+				 * changed size. */
+{
+    register Gridder *masterPtr = (Gridder *) clientData;
+    register Gridder *slavePtr;
+    GridMaster *slotPtr = masterPtr->masterDataPtr;
+    int abort;
+
+    masterPtr->flags &= ~REQUESTED_UPDATE;
+    if (masterPtr->flags & REQUESTED_RELAYOUT) {
+	return;
+    }
+    if (!(masterPtr->flags & LAYOUT_VALID) || (slotPtr == NULL)
+	    || (masterPtr->abortPtr != NULL)) {
+	ArrangeGrid(clientData);
+	return;
+    }
+
+    for (slavePtr = masterPtr->slavePtr; slavePtr != NULL;
+	    slavePtr = slavePtr->nextPtr) {
+	int width, height;
+
+	if (!(slavePtr->flags & SIZE_CHANGED)) {
+	    continue;
+	}
+	width = Tk_ReqWidth(slavePtr->tkwin) + slavePtr->padX
+		+ slavePtr->iPadX + slavePtr->doubleBw;
+	height = Tk_ReqHeight(slavePtr->tkwin) + slavePtr->padY
+		+ slavePtr->iPadY + slavePtr->doubleBw;
+	if (!SlotUnchanged(slotPtr->columnPtr, slavePtr->column,
+		    slavePtr->numCols, slavePtr->lastWidth, width)
+		|| !SlotUnchanged(slotPtr->rowPtr, slavePtr->row,
+		    slavePtr->numRows, slavePtr->lastHeight, height)) {
+	    ArrangeGrid(clientData);
+	    return;
+	}
+    }
+
+    /*
+     * No row or column changes size, so neither does the master:
+     * just fit each changed slave into its cell again.
+     */
+
+    masterPtr->abortPtr = &abort;
+    abort = 0;
+    Tcl_Preserve((ClientData) masterPtr);
+    for (slavePtr = masterPtr->slavePtr; slavePtr != NULL && !abort;
+	    slavePtr = slavePtr->nextPtr) {
+	if (!(slavePtr->flags & SIZE_CHANGED)) {
+	    continue;
+	}
+	slavePtr->flags &= ~SIZE_CHANGED;
+	slavePtr->lastWidth = Tk_ReqWidth(slavePtr->tkwin) + slavePtr->padX
+		+ slavePtr->iPadX + slavePtr->doubleBw;
+	slavePtr->lastHeight = Tk_ReqHeight(slavePtr->tkwin) + slavePtr->padY
+		+ slavePtr->iPadY + slavePtr->doubleBw;
+	ArrangeSlave(masterPtr, slavePtr);
+    }
+    if (abort) {
+	masterPtr->flags &= ~LAYOUT_VALID;
+    }
+    masterPtr->abortPtr = NULL;
+    Tcl_Release((ClientData) masterPtr);
+}
+
 /*
  *--------------------------------------------------------------
  *
@@ -1474,6 +1661,86 @@ AdjustForSticky(slavePtr, xPtr, yPtr, widthPtr, heightPtr)
     }
 }
 
+/*
+ *--------------------------------------------------------------
+ *
+ * ArrangeSlave --
+ *
+ *	Fit one slave into its cell, using the slot offsets computed
+ *	by the last call to ResolveConstraints.  Must be called with
+ *	masterPtr->abortPtr set.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The slave may get resized, moved, mapped or unmapped.
+ *
+ *--------------------------------------------------------------
+ */
+
+static void
+ArrangeSlave(masterPtr, slavePtr)
+    Gridder *masterPtr;		/* Master of the grid. */
+    Gridder *slavePtr;		/* Slave to arrange. */
+{
+    GridMaster *slotPtr = masterPtr->masterDataPtr;
+    int x, y;			/* top left coordinate */
+    int width, height;		/* slot or slave size */
+    int col = slavePtr->column;
+    int row = slavePtr->row;
+
+    x = (col>0) ? slotPtr->columnPtr[col-1].offset : 0;
+    y = (row>0) ? slotPtr->rowPtr[row-1].offset : 0;
+
+    width = slotPtr->columnPtr[slavePtr->numCols+col-1].offset - x;
+    height = slotPtr->rowPtr[slavePtr->numRows+row-1].offset - y;
+
+    x += slotPtr->startX;
+    y += slotPtr->startY;
+
+    AdjustForSticky(slavePtr, &x, &y, &width, &height);
+
+    /*
+     * Now put the window in the proper spot.  (This was taken directly
+     * from tkPack.c.)  If the slave is a child of the master, then
+     * do this here.  Otherwise let Tk_MaintainGeometry do the work.
+     */
+
+    if (masterPtr->tkwin == Tk_Parent(slavePtr->tkwin)) {
+        if ((width <= 0) || (height <= 0)) {
+            Tk_UnmapWindow(slavePtr->tkwin);
+        } else {
+            if ((x != Tk_X(slavePtr->tkwin))
+                    || (y != Tk_Y(slavePtr->tkwin))
+                    || (width != Tk_Width(slavePtr->tkwin))
+                    || (height != Tk_Height(slavePtr->tkwin))) {
+                Tk_MoveResizeWindow(slavePtr->tkwin, x, y, width, height);
+            }
+            if (*masterPtr->abortPtr) {
+                return;
+            }
+
+            /*
+             * Don't map the slave if the master isn't mapped: wait
+             * until the master gets mapped later.
+             */
+
+            if (Tk_IsMapped(masterPtr->tkwin)) {
+                Tk_MapWindow(slavePtr->tkwin);
+            }
+        }
+    } else {
+        if ((width <= 0) || (height <= 0)) {
+            Tk_UnmaintainGeometry(slavePtr->tkwin, masterPtr->tkwin);
+            Tk_UnmapWindow(slavePtr->tkwin);
+        } else {
+            Tk_MaintainGeometry(slavePtr->tkwin, masterPtr->tkwin,
+                    x, y, width, height);
+        }
+    }
+}
+
 /*
  *--------------------------------------------------------------
  *
@@ -1506,7 +1773,7 @@ ArrangeGrid(clientData)
     int width, height;		/* requested size of layout, in pixels */
     int realWidth, realHeight;	/* actual size layout should take-up */
 
-    masterPtr->flags &= ~REQUESTED_RELAYOUT;
+    masterPtr->flags &= ~(REQUESTED_RELAYOUT|LAYOUT_VALID);
 
     /*
      * If the parent has no slaves anymore, then don't do anything
@@ -1597,60 +1864,10 @@ ArrangeGrid(clientData)
 
     for (slavePtr = masterPtr->slavePtr; slavePtr != NULL && !abort;
 	    slavePtr = slavePtr->nextPtr) {
-	int x, y;			/* top left coordinate */
-	int width, height;		/* slot or slave size */
-	int col = slavePtr->column;
-	int row = slavePtr->row;
-
-	x = (col>0) ? slotPtr->columnPtr[col-1].offset : 0;
-	y = (row>0) ? slotPtr->rowPtr[row-1].offset : 0;
-
-	width = slotPtr->columnPtr[slavePtr->numCols+col-1].offset - x;
-	height = slotPtr->rowPtr[slavePtr->numRows+row-1].offset - y;
-
-        x += slotPtr->startX;
-        y += slotPtr->startY;
-
-	AdjustForSticky(slavePtr, &x, &y, &width, &height);
-
-	/*
-	 * Now put the window in the proper spot.  (This was taken directly
-	 * from tkPack.c.)  If the slave is a child of the master, then
-         * do this here.  Otherwise let Tk_MaintainGeometry do the work.
-         */
-
-        if (masterPtr->tkwin == Tk_Parent(slavePtr->tkwin)) {
-            if ((width <= 0) || (height <= 0)) {
-                Tk_UnmapWindow(slavePtr->tkwin);
-            } else {
-                if ((x != Tk_X(slavePtr->tkwin))
-                        || (y != Tk_Y(slavePtr->tkwin))
-                        || (width != Tk_Width(slavePtr->tkwin))
-                        || (height != Tk_Height(slavePtr->tkwin))) {
-                    Tk_MoveResizeWindow(slavePtr->tkwin, x, y, width, height);
-                }
-                if (abort) {
-                    break;
-                }
-
-                /*
-                 * Don't map the slave if the master isn't mapped: wait
-                 * until the master gets mapped later.
-                 */
-
-                if (Tk_IsMapped(masterPtr->tkwin)) {
-                    Tk_MapWindow(slavePtr->tkwin);
-                }
-            }
-        } else {
-            if ((width <= 0) || (height <= 0)) {
-                Tk_UnmaintainGeometry(slavePtr->tkwin, masterPtr->tkwin);
-                Tk_UnmapWindow(slavePtr->tkwin);
-            } else {
-                Tk_MaintainGeometry(slavePtr->tkwin, masterPtr->tkwin,
-                        x, y, width, height);
-            }
-        }
+	ArrangeSlave(masterPtr, slavePtr);
+    }
+    if (!abort) {
+	masterPtr->flags |= LAYOUT_VALID;
     }
 
     masterPtr->abortPtr = NULL;
@@ -1794,6 +2011,7 @@ ResolveConstraints(masterPtr, slotType, maxOffset)
 		int rightEdge = slavePtr->column + slavePtr->numCols - 1;
 		slavePtr->size = Tk_ReqWidth(slavePtr->tkwin) +
 			slavePtr->padX + slavePtr->iPadX + slavePtr->doubleBw;
+		slavePtr->lastWidth = slavePtr->size;
 		if (slavePtr->numCols > 1) {
 		    slavePtr->binNextPtr = layoutPtr[rightEdge].binNextPtr;
 		    layoutPtr[rightEdge].binNextPtr = slavePtr;
@@ -1811,6 +2029,8 @@ ResolveConstraints(masterPtr, slotType, maxOffset)
 		int rightEdge = slavePtr->row + slavePtr->numRows - 1;
 		slavePtr->size = Tk_ReqHeight(slavePtr->tkwin) +
 			slavePtr->padY + slavePtr->iPadY + slavePtr->doubleBw;
+		slavePtr->lastHeight = slavePtr->size;
+		slavePtr->flags &= ~SIZE_CHANGED;
 		if (slavePtr->numRows > 1) {
 		    slavePtr->binNextPtr = layoutPtr[rightEdge].binNextPtr;
 		    layoutPtr[rightEdge].binNextPtr = slavePtr;
@@ -1824,6 +2044,21 @@ ResolveConstraints(masterPtr, slotType, maxOffset)
 	    break;
 	}
 
+    for (slot = 0; slot < gridCount; slot++) {
+	slotPtr[slot].natural = layoutPtr[slot].minSize;
+	slotPtr[slot].numNatural = ((slot < constraintCount)
+		&& (slotPtr[slot].minSize == layoutPtr[slot].minSize));
+    }
+    for (slavePtr = masterPtr->slavePtr; slavePtr != NULL;
+	    slavePtr = slavePtr->nextPtr) {
+	slot = (slotType == COLUMN) ? slavePtr->column : slavePtr->row;
+	if ((((slotType == COLUMN) ? slavePtr->numCols : slavePtr->numRows)
+		== 1) && (slavePtr->size + layoutPtr[slot].pad
+		== slotPtr[slot].natural)) {
+	    slotPtr[slot].numNatural++;
+	}
+    }
+
     /*
      * Step 2b.
      * Consider demands on uniform sizes.
@@ -2479,6 +2714,9 @@ GridStructureProc(clientData, eventPtr)
 	if (gridPtr->flags & REQUESTED_RELAYOUT) {
 	    Tcl_CancelIdleCall(ArrangeGrid, (ClientData) gridPtr);
 	}
+	if (gridPtr->flags & REQUESTED_UPDATE) {
+	    Tcl_CancelIdleCall(GridUpdateSlaves, (ClientData) gridPtr);
+	}
 	gridPtr->tkwin = NULL;
 	Tcl_EventuallyFree((ClientData) gridPtr, DestroyGrid);
     } else if (eventPtr->type == MapNotify) {
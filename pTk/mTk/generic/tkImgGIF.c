@@ -94,8 +94,53 @@ static CONST char GIF89a[] = {			/* ASCII GIF89a */
  * 0==from file; 1==from base64 encoded data; 2==from binary data
  */
 
+/*
+ * Reading image N of a multi-image GIF means walking past images 0 to
+ * N-1.  So that loading every frame of an animation one after the other
+ * does not walk the file over and over, the positions of the images met
+ * on the way are remembered in a GIFIndex, together with what the
+ * extensions before them said.  A later read of the same source starts
+ * from the nearest known image.  The index for the source read last is
+ * kept; it is checked against the identity of the source (device, inode,
+ * size and modification time of a file; address, length and if need be
+ * a hash of inline data) and against the image descriptor found at each
+ * position, so a changed source is simply walked again.
+ */
+
+typedef struct GIFPos {
+    Tcl_WideInt offset;		/* Offset in the file, or in the (possibly
+				 * base64 encoded) inline data. */
+    int c, state;		/* Base64 decoder state at that offset. */
+} GIFPos;
+
+typedef struct GIFFrame {
+    GIFPos pos;			/* Position just after the image separator. */
+    unsigned char descriptor[9];/* Image descriptor found there. */
+    int transparent;		/* Transparent color index in effect for
+				 * the image, or -1. */
+    TkGIFFrameInfo info;	/* Placement, delay and disposal. */
+} GIFFrame;
+
+typedef struct GIFIndex {
+    int fromData;		/* How the source was read:  see below. */
+    char *name;			/* File name, or NULL for inline data. */
+    unsigned long dev, ino;	/* Device and inode of the file. */
+    unsigned long mtime;	/* Its modification time. */
+    Tcl_WideInt size;		/* Length of the file or inline data. */
+    unsigned long hash;		/* Hash of inline data, else 0. */
+    int loop;			/* Loop count from a NETSCAPE2.0 extension:
+				 * 0 means forever, -1 that there was none. */
+    int complete;		/* Non-zero once the terminator was seen. */
+    int numFrames;		/* Number of images indexed so far. */
+    int maxFrames;		/* Space allocated in frames. */
+    GIFFrame *frames;		/* Images in file order. */
+} GIFIndex;
+
 typedef struct ThreadSpecificData {
     int fromData;
+    unsigned char *dataBase;	/* Start of inline data being read. */
+    int dataLength;		/* Its length in bytes. */
+    GIFIndex *indexPtr;		/* Index of the source read last, or NULL. */
 } ThreadSpecificData;
 static Tcl_ThreadDataKey dataKey;
 
@@ -150,7 +195,16 @@ Tk_PhotoImageFormat tkImgFmtGIF = {
  */
 
 static int		DoExtension _ANSI_ARGS_((Tcl_Channel chan, int label,
-			    int *transparent));
+			    int *transparent, int *delayPtr, int *disposalPtr,
+			    int *loopPtr));
+static int		FindGIFFrame _ANSI_ARGS_((Tcl_Interp *interp,
+			    Tcl_Channel chan, Tcl_Obj *fileName, int index,
+			    unsigned char *buf, int *transparentPtr));
+static void		FreeGIFIndex _ANSI_ARGS_((GIFIndex *idxPtr));
+static GIFIndex *	GetGIFIndex _ANSI_ARGS_((Tcl_Channel chan,
+			    Tcl_Obj *fileName));
+static int		GIFSeek _ANSI_ARGS_((Tcl_Channel chan, GIFPos *posPtr));
+static void		GIFTell _ANSI_ARGS_((Tcl_Channel chan, GIFPos *posPtr));
 static int		GetCode _ANSI_ARGS_((Tcl_Channel chan, int code_size,
 			    int flag));
 static int		GetDataBlock _ANSI_ARGS_((Tcl_Channel chan,
@@ -165,6 +219,7 @@ static int		ReadImage _ANSI_ARGS_((Tcl_Interp *interp,
 			    unsigned char cmap[MAXCOLORMAPSIZE][4],
 			    int width, int height, int srcX, int srcY,
 			    int interlace, int transparent));
+static int		SkipImage _ANSI_ARGS_((Tcl_Channel chan));
 
 /*
  * these are for the BASE64 image reader code only
@@ -251,8 +306,7 @@ FileReadGIF(interp, chan, fileName, format, imageHandle, destX, destY,
     Tcl_Obj **objv;
     Tk_PhotoImageBlock block;
     unsigned char buf[100];
-    unsigned char *trashBuffer = NULL;
-    int bitPixel;
+    int bitPixel, result;
     unsigned char colorMap[MAXCOLORMAPSIZE][4];
     int transparent = -1;
     static CONST char *optionStrings[] = {
@@ -325,109 +379,21 @@ FileReadGIF(interp, chan, fileName, format, imageHandle, destX, destY,
     block.offset[3] = 3;
     block.pixelPtr = NULL;
 
-    while (1) {
-	if (Fread(buf, 1, 1, chan) != 1) {
-	    /*
-	     * Premature end of image.  We should really notify
-	     * the user, but for now just show garbage.
-	     */
-
-	    break;
-	}
-
-	if (buf[0] == GIF_TERMINATOR) {
-	    /*
-	     * GIF terminator.
-	     */
-
-	    Tcl_AppendResult(interp,"no image data for this index",
-		    (char *) NULL);
-	    goto error;
-	}
-
-	if (buf[0] == GIF_EXTENSION) {
-	    /*
-	     * This is a GIF extension.
-	     */
-
-	    if (Fread(buf, 1, 1, chan) != 1) {
-		Tcl_SetResult(interp,
-			"error reading extension function code in GIF image",
-			TCL_STATIC);
-		goto error;
-	    }
-	    if (DoExtension(chan, buf[0], &transparent) < 0) {
-		Tcl_SetResult(interp, "error reading extension in GIF image",
-			TCL_STATIC);
-		goto error;
-	    }
-	    continue;
-	}
-
-	if (buf[0] != GIF_START) {
-	    /*
-	     * Not a valid start character; ignore it.
-	     */
-	    continue;
-	}
-
-	if (Fread(buf, 1, 9, chan) != 9) {
-	    Tcl_SetResult(interp,
-		    "couldn't read left/top/width/height in GIF image",
-		    TCL_STATIC);
-	    goto error;
-	}
+    result = FindGIFFrame(interp, chan, fileName, index, buf, &transparent);
+    if (result == TCL_ERROR) {
+	goto error;
+    }
+    if (result == TCL_OK) {
+	/*
+	 * On a premature end of image (TCL_CONTINUE) we should really
+	 * notify the user, but for now just show garbage.
+	 */
 
 	fileWidth = LM_to_uint(buf[4],buf[5]);
 	fileHeight = LM_to_uint(buf[6],buf[7]);
 
 	bitPixel = 1<<((buf[8]&0x07)+1);
 
-	if (index--) {
-	    /*
-	     * This is not the image we want to read: skip it.
-	     */
-	    if (BitSet(buf[8], LOCALCOLORMAP)) {
-		if (!ReadColorMap(chan, bitPixel, colorMap)) {
-		    Tcl_AppendResult(interp,
-			    "error reading color map", (char *) NULL);
-		    goto error;
-		}
-	    }
-
-	    /*
-	     * If we've not yet allocated a trash buffer, do so now.
-	     */
-	    if (trashBuffer == NULL) {
-		nBytes = fileWidth * fileHeight * 3;
-		trashBuffer =
-		    (unsigned char *) ckalloc((unsigned int) nBytes);
-	    }
-
-	    /*
-	     * Slurp!  Process the data for this image and stuff it in
-	     * a trash buffer.
-	     *
-	     * Yes, it might be more efficient here to *not* store the
-	     * data (we're just going to throw it away later).
-	     * However, I elected to implement it this way for good
-	     * reasons.  First, I wanted to avoid duplicating the
-	     * (fairly complex) LWZ decoder in ReadImage.  Fine, you
-	     * say, why didn't you just modify it to allow the use of
-	     * a NULL specifier for the output buffer?  I tried that,
-	     * but it negatively impacted the performance of what I
-	     * think will be the common case: reading the first image
-	     * in the file.  Rather than marginally improve the speed
-	     * of the less frequent case, I chose to maintain high
-	     * performance for the common case.
-	     */
-	    if (ReadImage(interp, (char *) trashBuffer, chan, fileWidth,
-		    fileHeight, colorMap, 0, 0, 0, 0, 0, -1) != TCL_OK) {
-		goto error;
-	    }
-	    continue;
-	}
-
 	if (BitSet(buf[8], LOCALCOLORMAP)) {
 	    if (!ReadColorMap(chan, bitPixel, colorMap)) {
 		    Tcl_AppendResult(interp, "error reading color map",
@@ -475,19 +441,12 @@ FileReadGIF(interp, chan, fileName, format, imageHandle, destX, destY,
 		BitSet(buf[8], INTERLACE), transparent) != TCL_OK) {
 	    goto error;
 	}
-	break;
     }
 
     Tk_PhotoPutBlock(imageHandle, &block, destX, destY, width, height,
 	    TK_PHOTO_COMPOSITE_SET);
 
     noerror:
-    /*
-     * If a trash buffer has been allocated, free it now.
-     */
-    if (trashBuffer != NULL) {
-	ckfree((char *)trashBuffer);
-    }
     if (block.pixelPtr) {
 	ckfree((char *) block.pixelPtr);
     }
@@ -495,12 +454,6 @@ FileReadGIF(interp, chan, fileName, format, imageHandle, destX, destY,
     return TCL_OK;
 
     error:
-    /*
-     * If a trash buffer has been allocated, free it now.
-     */
-    if (trashBuffer != NULL) {
-	ckfree((char *)trashBuffer);
-    }
     if (block.pixelPtr) {
 	ckfree((char *) block.pixelPtr);
     }
@@ -613,7 +566,8 @@ StringReadGIF(interp, dataObj, format, imageHandle,
     /*
      * Check whether the data is Base64 encoded
      */
-    data = (char *) Tcl_GetByteArrayFromObj(dataObj, NULL);
+    data = (char *) Tcl_GetByteArrayFromObj(dataObj, &tsdPtr->dataLength);
+    tsdPtr->dataBase = (unsigned char *) data;
     if ((strncmp(GIF87a, data, 6) != 0) && (strncmp(GIF89a, data, 6) != 0)) {
 	mInit((unsigned char *)data, &handle);
 	tsdPtr->fromData = 1;
@@ -628,9 +582,220 @@ StringReadGIF(interp, dataObj, format, imageHandle,
 	    format, imageHandle, destX, destY, width, height, srcX, srcY);
     Tcl_DecrRefCount(name);
     tsdPtr->fromData = 0;
+    tsdPtr->dataBase = NULL;
     return result;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * FindGIFFrame --
+ *
+ *	Positions a GIF source just after the image descriptor of image
+ *	"index", starting from the nearest image recorded in the index
+ *	of the source (see GetGIFIndex) and recording the images passed
+ *	on the way.  Images that are passed over are not decoded: their
+ *	data sub-blocks are just skipped.
+ *
+ * Results:
+ *	TCL_OK if the image was found:  its descriptor is left in buf
+ *	and the transparent color in effect for it in *transparentPtr.
+ *	TCL_CONTINUE if the source ended prematurely, and TCL_ERROR,
+ *	with a message in the interp's result, if there is no such
+ *	image or the source could not be read.
+ *
+ * Side effects:
+ *	The access position of chan advances, and the index of the
+ *	source may be extended or replaced.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+FindGIFFrame(interp, chan, fileName, index, buf, transparentPtr)
+    Tcl_Interp *interp;		/* Interpreter to use for reporting errors. */
+    Tcl_Channel chan;		/* Source, positioned after the global color
+				 * map. */
+    Tcl_Obj *fileName;		/* The name of the image file. */
+    int index;			/* Which image to find. */
+    unsigned char *buf;		/* At least 9 bytes for the descriptor. */
+    int *transparentPtr;	/* Transparent color index, updated from
+				 * the extensions passed. */
+{
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
+    GIFIndex *idxPtr;
+    GIFFrame *framePtr;
+    GIFPos start, pos;
+    int frame = 0, delay = 0, disposal = 0;
+
+    idxPtr = GetGIFIndex(chan, fileName);
+    if ((idxPtr != NULL) && (idxPtr->numFrames > 0)) {
+	GIFTell(chan, &start);
+	frame = (index < idxPtr->numFrames) ? index : idxPtr->numFrames - 1;
+	framePtr = &idxPtr->frames[frame];
+	if (GIFSeek(chan, &framePtr->pos)
+		&& (Fread(buf, 1, 9, chan) == 9)
+		&& (memcmp(buf, framePtr->descriptor, 9) == 0)) {
+	    *transparentPtr = framePtr->transparent;
+	    if (frame == index) {
+		return TCL_OK;
+	    }
+	    if (idxPtr->complete) {
+		Tcl_AppendResult(interp,"no image data for this index",
+			(char *) NULL);
+		return TCL_ERROR;
+	    }
+	    goto skip;
+	}
+
+	/*
+	 * The source has changed under us: forget what we knew about it
+	 * and walk it from the start.
+	 */
+
+	FreeGIFIndex(idxPtr);
+	tsdPtr->indexPtr = NULL;
+	frame = 0;
+	if (!GIFSeek(chan, &start)) {
+	    Tcl_AppendResult(interp, "error seeking in GIF image \"",
+		    Tcl_GetString(fileName), "\"", (char *) NULL);
+	    return TCL_ERROR;
+	}
+	idxPtr = GetGIFIndex(chan, fileName);
+    }
+
+    while (1) {
+	if (Fread(buf, 1, 1, chan) != 1) {
+	    return TCL_CONTINUE;
+	}
+
+	if (buf[0] == GIF_TERMINATOR) {
+	    /*
+	     * GIF terminator.
+	     */
+
+	    if (idxPtr != NULL) {
+		idxPtr->complete = 1;
+	    }
+	    Tcl_AppendResult(interp,"no image data for this index",
+		    (char *) NULL);
+	    return TCL_ERROR;
+	}
+
+	if (buf[0] == GIF_EXTENSION) {
+	    /*
+	     * This is a GIF extension.
+	     */
+
+	    if (Fread(buf, 1, 1, chan) != 1) {
+		Tcl_SetResult(interp,
+			"error reading extension function code in GIF image",
+			TCL_STATIC);
+		return TCL_ERROR;
+	    }
+	    if (DoExtension(chan, buf[0], transparentPtr, &delay, &disposal,
+		    (idxPtr != NULL) ? &idxPtr->loop : NULL) < 0) {
+		Tcl_SetResult(interp, "error reading extension in GIF image",
+			TCL_STATIC);
+		return TCL_ERROR;
+	    }
+	    continue;
+	}
+
+	if (buf[0] != GIF_START) {
+	    /*
+	     * Not a valid start character; ignore it.
+	     */
+	    continue;
+	}
+
+	if (idxPtr != NULL) {
+	    GIFTell(chan, &pos);
+	}
+	if (Fread(buf, 1, 9, chan) != 9) {
+	    Tcl_SetResult(interp,
+		    "couldn't read left/top/width/height in GIF image",
+		    TCL_STATIC);
+	    return TCL_ERROR;
+	}
+
+	if ((idxPtr != NULL) && (frame == idxPtr->numFrames)) {
+	    if (idxPtr->numFrames == idxPtr->maxFrames) {
+		idxPtr->maxFrames = (idxPtr->maxFrames == 0) ? 16
+			: 2 * idxPtr->maxFrames;
+		idxPtr->frames = (GIFFrame *) ckrealloc(
+			(char *) idxPtr->frames,
+			idxPtr->maxFrames * sizeof(GIFFrame));
+	    }
+	    framePtr = &idxPtr->frames[idxPtr->numFrames++];
+	    framePtr->pos = pos;
+	    memcpy(framePtr->descriptor, buf, 9);
+	    framePtr->transparent = *transparentPtr;
+	    framePtr->info.left = LM_to_uint(buf[0],buf[1]);
+	    framePtr->info.top = LM_to_uint(buf[2],buf[3]);
+	    framePtr->info.width = LM_to_uint(buf[4],buf[5]);
+	    framePtr->info.height = LM_to_uint(buf[6],buf[7]);
+	    framePtr->info.delay = delay;
+	    framePtr->info.disposal = disposal;
+	}
+	delay = disposal = 0;
+
+	if (frame == index) {
+	    return TCL_OK;
+	}
+
+	/*
+	 * This is not the image we want to read: skip it.
+	 */
+
+    skip:
+	if (BitSet(buf[8], LOCALCOLORMAP)
+		&& !ReadColorMap(chan, 1<<((buf[8]&0x07)+1), NULL)) {
+	    Tcl_AppendResult(interp, "error reading color map", (char *) NULL);
+	    return TCL_ERROR;
+	}
+	if (SkipImage(chan) < 0) {
+	    Tcl_AppendResult(interp, "error reading GIF image: ",
+		    Tcl_PosixError(interp), (char *) NULL);
+	    return TCL_ERROR;
+	}
+	frame++;
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * SkipImage --
+ *
+ *	Passes over the LZW data of an image without decoding it.
+ *
+ * Results:
+ *	0 on success, -1 if the data could not be read.
+ *
+ * Side effects:
+ *	The access position of chan advances past the image.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+SkipImage(chan)
+    Tcl_Channel chan;
+{
+    unsigned char buf[256];
+    int count;
+
+    if (! ReadOK(chan, buf, 1)) {	/* LZW minimum code size */
+	return -1;
+    }
+    do {
+	count = GetDataBlock(chan, buf);
+    } while (count > 0);
+    return count;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -708,10 +873,14 @@ ReadColorMap(chan, number, buffer)
 
 
 static int
-DoExtension(chan, label, transparent)
+DoExtension(chan, label, transparent, delayPtr, disposalPtr, loopPtr)
     Tcl_Channel chan;
     int label;
     int *transparent;
+    int *delayPtr;		/* Delay and disposal method from a */
+    int *disposalPtr;		/* Graphic Control Extension go here. */
+    int *loopPtr;		/* Loop count from a NETSCAPE2.0 extension
+				 * goes here, if not NULL. */
 {
     static unsigned char buf[256];
     int count;
@@ -721,6 +890,19 @@ DoExtension(chan, label, transparent)
 	break;
 
     case 0xff:		/* Application Extension */
+	count = GetDataBlock(chan, (unsigned char*) buf);
+	if (count <= 0) {
+	    return count;
+	}
+	if ((count == 11) && (memcmp(buf, "NETSCAPE2.0", 11) == 0)) {
+	    count = GetDataBlock(chan, (unsigned char*) buf);
+	    if (count <= 0) {
+		return count;
+	    }
+	    if ((count >= 3) && (buf[0] == 1) && (loopPtr != NULL)) {
+		*loopPtr = LM_to_uint(buf[1],buf[2]);
+	    }
+	}
 	break;
 
     case 0xfe:		/* Comment Extension */
@@ -737,6 +919,8 @@ DoExtension(chan, label, transparent)
 	if ((buf[0] & 0x1) != 0) {
 	    *transparent = buf[3];
 	}
+	*disposalPtr = (buf[0] >> 2) & 0x7;
+	*delayPtr = LM_to_uint(buf[1],buf[2]);
 
 	do {
 	    count = GetDataBlock(chan, (unsigned char*) buf);
@@ -1335,6 +1519,301 @@ Fread(dst, hunk, count, chan)
     }
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * GetGIFIndex --
+ *
+ *	Returns the frame index for a GIF source, creating an empty one
+ *	if the source is not the one read last.  Files are told apart by
+ *	name, device, inode, size and modification time, and inline data
+ *	by its length and a hash of its contents: perl may reuse a buffer
+ *	for other data, or change it in place, so its address tells
+ *	nothing.
+ *
+ * Results:
+ *	The index, or NULL if the source cannot be repositioned (a pipe,
+ *	say) and so cannot be indexed.
+ *
+ * Side effects:
+ *	The index of the previous source may be freed.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static GIFIndex *
+GetGIFIndex(chan, fileName)
+    Tcl_Channel chan;
+    Tcl_Obj *fileName;
+{
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
+    GIFIndex *idxPtr = tsdPtr->indexPtr;
+    CONST char *name = NULL;
+    struct stat statBuf;
+    Tcl_WideInt size, here;
+    unsigned long hash = 0;
+    int i;
+
+    if (tsdPtr->fromData) {
+	if (tsdPtr->dataBase == NULL) {
+	    return NULL;
+	}
+	size = tsdPtr->dataLength;
+	hash = 2166136261UL;		/* FNV-1a */
+	for (i = 0; i < tsdPtr->dataLength; i++) {
+	    hash = ((hash ^ tsdPtr->dataBase[i]) * 16777619UL) & 0xffffffffUL;
+	}
+	if ((idxPtr != NULL) && (idxPtr->fromData == tsdPtr->fromData)
+		&& (idxPtr->size == size) && (idxPtr->hash == hash)) {
+	    return idxPtr;
+	}
+    } else {
+	name = Tcl_GetString(fileName);
+	if (stat(name, &statBuf) != 0) {
+	    return NULL;
+	}
+	here = Tcl_Seek(chan, (Tcl_WideInt) 0, SEEK_CUR);
+	if (here < 0) {
+	    return NULL;
+	}
+	size = Tcl_Seek(chan, (Tcl_WideInt) 0, SEEK_END);
+	if (Tcl_Seek(chan, here, SEEK_SET) != here) {
+	    return NULL;
+	}
+	if ((size < 0) || (size != (Tcl_WideInt) statBuf.st_size)) {
+	    return NULL;
+	}
+	if ((idxPtr != NULL) && !idxPtr->fromData
+		&& (idxPtr->dev == (unsigned long) statBuf.st_dev)
+		&& (idxPtr->ino == (unsigned long) statBuf.st_ino)
+		&& (idxPtr->mtime == (unsigned long) statBuf.st_mtime)
+		&& (idxPtr->size == size)
+		&& (strcmp(idxPtr->name, name) == 0)) {
+	    return idxPtr;
+	}
+    }
+
+    if (idxPtr != NULL) {
+	FreeGIFIndex(idxPtr);
+    }
+
+    idxPtr = (GIFIndex *) ckalloc(sizeof(GIFIndex));
+    idxPtr->fromData = tsdPtr->fromData;
+    idxPtr->name = NULL;
+    if (name != NULL) {
+	idxPtr->name = ckalloc((unsigned) strlen(name) + 1);
+	strcpy(idxPtr->name, name);
+	idxPtr->dev = (unsigned long) statBuf.st_dev;
+	idxPtr->ino = (unsigned long) statBuf.st_ino;
+	idxPtr->mtime = (unsigned long) statBuf.st_mtime;
+    } else {
+	idxPtr->dev = idxPtr->ino = idxPtr->mtime = 0;
+    }
+    idxPtr->size = size;
+    idxPtr->hash = hash;
+    idxPtr->loop = -1;
+    idxPtr->complete = 0;
+    idxPtr->numFrames = 0;
+    idxPtr->maxFrames = 0;
+    idxPtr->frames = NULL;
+    tsdPtr->indexPtr = idxPtr;
+    return idxPtr;
+}
+
+static void
+FreeGIFIndex(idxPtr)
+    GIFIndex *idxPtr;
+{
+    if (idxPtr->name != NULL) {
+	ckfree(idxPtr->name);
+    }
+    if (idxPtr->frames != NULL) {
+	ckfree((char *) idxPtr->frames);
+    }
+    ckfree((char *) idxPtr);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * GIFTell, GIFSeek --
+ *
+ *	Record and restore the read position of a GIF source, be it a
+ *	channel or (possibly base64 encoded) inline data.
+ *
+ * Results:
+ *	GIFSeek returns 1 on success and 0 if the position could not be
+ *	restored.
+ *
+ * Side effects:
+ *	GIFSeek moves the read position.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+GIFTell(chan, posPtr)
+    Tcl_Channel chan;
+    GIFPos *posPtr;
+{
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
+    MFile *handle;
+
+    if (tsdPtr->fromData) {
+	handle = (MFile *) chan;
+	posPtr->offset = handle->data - tsdPtr->dataBase;
+	posPtr->c = handle->c;
+	posPtr->state = handle->state;
+    } else {
+	posPtr->offset = Tcl_Seek(chan, (Tcl_WideInt) 0, SEEK_CUR);
+	posPtr->c = posPtr->state = 0;
+    }
+}
+
+static int
+GIFSeek(chan, posPtr)
+    Tcl_Channel chan;
+    GIFPos *posPtr;
+{
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
+    MFile *handle;
+
+    if (posPtr->offset < 0) {
+	return 0;
+    }
+    if (tsdPtr->fromData) {
+	if (posPtr->offset > tsdPtr->dataLength) {
+	    return 0;
+	}
+	handle = (MFile *) chan;
+	handle->data = tsdPtr->dataBase + posPtr->offset;
+	handle->c = posPtr->c;
+	handle->state = posPtr->state;
+	return 1;
+    }
+    return (Tcl_Seek(chan, posPtr->offset, SEEK_SET) == posPtr->offset);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkGetGIFFrameInfo --
+ *
+ *	Walks every image of a GIF file (or of GIF data, if isData is
+ *	non-zero) and reports where each goes and how long it is shown,
+ *	as needed to animate the images in turn.  Image data is not
+ *	decoded.
+ *
+ * Results:
+ *	A standard Tcl result.  On success *framesPtr points to a
+ *	ckalloc'ed array, which the caller must free, of *numFramesPtr
+ *	entries, and *loopPtr holds the NETSCAPE2.0 loop count: 0 to
+ *	loop forever, -1 if the source did not say.
+ *
+ * Side effects:
+ *	The index kept for the source makes reading its images with
+ *	"-index" quicker afterwards.
+ *
+ *----------------------------------------------------------------------
+ */
+
+#undef TkGetGIFFrameInfo
+int
+TkGetGIFFrameInfo(interp, source, isData, framesPtr, numFramesPtr, loopPtr)
+    Tcl_Interp *interp;		/* Interpreter to use for reporting errors. */
+    Tcl_Obj *source;		/* File name, or the data itself. */
+    int isData;			/* Non-zero if source is the data. */
+    TkGIFFrameInfo **framesPtr;	/* Returns the frames. */
+    int *numFramesPtr;		/* Returns the number of frames. */
+    int *loopPtr;		/* Returns the loop count. */
+{
+    ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
+	    Tcl_GetThreadData(&dataKey, sizeof(ThreadSpecificData));
+    Tcl_Channel chan = NULL;
+    Tcl_Obj *name;
+    MFile handle;
+    GIFIndex *idxPtr;
+    unsigned char buf[100], *data;
+    int width, height, transparent = -1, result = TCL_ERROR, i;
+
+    if (isData) {
+	data = Tcl_GetByteArrayFromObj(source, &tsdPtr->dataLength);
+	tsdPtr->dataBase = data;
+	tsdPtr->fromData = ((tsdPtr->dataLength >= 6)
+		&& ((strncmp(GIF87a, (char *) data, 6) == 0)
+		|| (strncmp(GIF89a, (char *) data, 6) == 0))) ? 2 : 1;
+	mInit(data, &handle);
+	chan = (Tcl_Channel) &handle;
+	name = Tcl_NewStringObj("inline data", -1);
+    } else {
+	chan = Tcl_OpenFileChannel(interp, Tcl_GetString(source), "r", 0);
+	if (chan == NULL) {
+	    return TCL_ERROR;
+	}
+	if (Tcl_SetChannelOption(interp, chan, "-translation", "binary")
+		!= TCL_OK) {
+	    Tcl_Close(NULL, chan);
+	    return TCL_ERROR;
+	}
+	name = source;
+    }
+    Tcl_IncrRefCount(name);
+
+    if (!ReadGIFHeader(chan, &width, &height)) {
+	Tcl_AppendResult(interp, "couldn't read GIF header from \"",
+		Tcl_GetString(name), "\"", NULL);
+	goto done;
+    }
+    if (Fread(buf, 1, 3, chan) != 3) {
+	Tcl_AppendResult(interp, "error reading GIF image", (char *) NULL);
+	goto done;
+    }
+    if (BitSet(buf[0], LOCALCOLORMAP)
+	    && !ReadColorMap(chan, 2<<(buf[0]&0x07), NULL)) {
+	Tcl_AppendResult(interp, "error reading color map", (char *) NULL);
+	goto done;
+    }
+
+    /*
+     * Ask for an image past the last one:  this walks and indexes them
+     * all.  Running out of data early still leaves the images that
+     * were complete.
+     */
+
+    i = FindGIFFrame(interp, chan, name, INT_MAX, buf, &transparent);
+    idxPtr = tsdPtr->indexPtr;
+    if ((idxPtr == NULL) || ((i == TCL_ERROR) && !idxPtr->complete)) {
+	if (i != TCL_ERROR) {
+	    Tcl_AppendResult(interp, "couldn't index GIF image",
+		    (char *) NULL);
+	}
+	goto done;
+    }
+    Tcl_ResetResult(interp);
+
+    *framesPtr = (TkGIFFrameInfo *) ckalloc((unsigned)
+	    (idxPtr->numFrames + 1) * sizeof(TkGIFFrameInfo));
+    for (i = 0; i < idxPtr->numFrames; i++) {
+	(*framesPtr)[i] = idxPtr->frames[i].info;
+    }
+    *numFramesPtr = idxPtr->numFrames;
+    *loopPtr = idxPtr->loop;
+    result = TCL_OK;
+
+    done:
+    Tcl_DecrRefCount(name);
+    if (isData) {
+	tsdPtr->fromData = 0;
+	tsdPtr->dataBase = NULL;
+    } else {
+	Tcl_Close(NULL, chan);
+    }
+    return result;
+}
+
 
 /*
  * ChanWriteGIF - writes a image in GIF format.
@@ -242,6 +242,7 @@ struct SubcommandOptions {
     Tcl_Obj *format;            /* Value specified for -format option. */
     XColor *background;         /* Value specified for -background option. */
     int compositingRule;        /* Value specified for -compositingrule opt */
+    int filter;                 /* Value specified for -filter option. */
 };
 
 /*
@@ -253,6 +254,7 @@ struct SubcommandOptions {
  *
  * OPT_BACKGROUND:              Set if -format option allowed/specified.
  * OPT_COMPOSITE:               Set if -compositingrule option allowed/spec'd.
+ * OPT_FILTER:                  Set if -filter option allowed/specified.
  * OPT_FORMAT:                  Set if -format option allowed/specified.
  * OPT_FROM:                    Set if -from option allowed/specified.
  * OPT_GRAYSCALE:               Set if -grayscale option allowed/specified.
@@ -264,13 +266,22 @@ struct SubcommandOptions {
 
 #define OPT_BACKGROUND  1
 #define OPT_COMPOSITE   2
-#define OPT_FORMAT      4
-#define OPT_FROM        8
-#define OPT_GRAYSCALE   0x10
-#define OPT_SHRINK      0x20
-#define OPT_SUBSAMPLE   0x40
-#define OPT_TO          0x80
-#define OPT_ZOOM        0x100
+#define OPT_FILTER      4
+#define OPT_FORMAT      8
+#define OPT_FROM        0x10
+#define OPT_GRAYSCALE   0x20
+#define OPT_SHRINK      0x40
+#define OPT_SUBSAMPLE   0x80
+#define OPT_TO          0x100
+#define OPT_ZOOM        0x200
+
+/*
+ * Values for the -filter option of the copy subcommand.  These must
+ * match the order of the filterNames table in ParseSubcommandOptions.
+ */
+
+#define FILTER_NONE     0
+#define FILTER_BOX      1
 
 /*
  * List of option names.  The order here must match the order of
@@ -280,6 +291,7 @@ struct SubcommandOptions {
 static char *optionNames[] = {
     "-background",
     "-compositingrule",
+    "-filter",
     "-format",
     "-from",
     "-grayscale",
@@ -383,6 +395,38 @@ static Tcl_HashTable imgPhotoColorHash;
 static int imgPhotoColorHashInitialized;
 #define N_COLOR_HASH    (sizeof(ColorTableId) / sizeof(int))
 
+/*
+ * Applications often create photos from the same few icon files over
+ * and over, in every dialog they open.  When enabled with
+ * TkPhotoCacheLimit, the decoded pixels of images read with -file are
+ * kept in a process-wide cache so such photos are filled without
+ * opening the file again.  Entries are keyed by the identity of the
+ * file (device, inode, size and modification time, plus the name),
+ * and by the -format option, which can select e.g. a frame of a GIF.
+ * The least recently used entries are dropped to stay within the
+ * limit on the memory used.
+ */
+
+typedef struct PhotoCacheEntry {
+    Tcl_HashEntry *hPtr;	/* Entry in photoCache.table. */
+    struct PhotoCacheEntry *prevPtr, *nextPtr;
+				/* Neighbours in the list of entries, most
+				 * recently used first. */
+    int width, height;		/* Size of the image. */
+    unsigned char *pixels;	/* Its pixels, 4 bytes (RGBA) each. */
+} PhotoCacheEntry;
+
+static struct {
+    int initialized;
+    Tcl_HashTable table;	/* Entries keyed by PhotoCacheKey. */
+    PhotoCacheEntry *firstPtr;	/* Most recently used entry. */
+    PhotoCacheEntry *lastPtr;	/* Least recently used entry. */
+    long limit;			/* Bytes of pixels to keep; 0 means the
+				 * cache is disabled. */
+    long bytes;			/* Bytes of pixels kept. */
+    long hits, misses, evictions;
+} photoCache;
+
 /*
  * Forward declarations
  */
@@ -409,6 +453,14 @@ static void             ImgPhotoBlendComplexAlpha _ANSI_ARGS_((
 			    int xOffset, int yOffset, int width, int height));
 static int		ImgPhotoSetSize _ANSI_ARGS_((PhotoMaster *masterPtr,
 			    int width, int height));
+static int		PhotoCacheKey _ANSI_ARGS_((PhotoMaster *masterPtr,
+			    Tcl_DString *keyPtr));
+static int		PhotoCacheRead _ANSI_ARGS_((PhotoMaster *masterPtr));
+static void		PhotoCacheSave _ANSI_ARGS_((PhotoMaster *masterPtr));
+static void		PhotoCacheTrim _ANSI_ARGS_((long limit));
+static unsigned char *	BoxFilterBlock _ANSI_ARGS_((
+			    Tk_PhotoImageBlock *blockPtr,
+			    int subsampleX, int subsampleY));
 static void             ImgPhotoInstanceSetSize _ANSI_ARGS_((
 			    PhotoInstance *instancePtr));
 static int              ImgStringWrite _ANSI_ARGS_((Tcl_Interp *interp,
@@ -808,12 +860,12 @@ ImgPhotoCmd(clientData, interp, objc, objv)
 	options.compositingRule = TK_PHOTO_COMPOSITE_OVERLAY;
 	if (ParseSubcommandOptions(&options, interp,
 		OPT_FROM | OPT_TO | OPT_ZOOM | OPT_SUBSAMPLE | OPT_SHRINK |
-		OPT_COMPOSITE, &index, objc, objv) != TCL_OK) {
+		OPT_COMPOSITE | OPT_FILTER, &index, objc, objv) != TCL_OK) {
 	    return TCL_ERROR;
 	}
 	if (options.name == NULL || index < objc) {
 	    Tcl_WrongNumArgs(interp, 2, objv,
-		    "source-image ?-compositingrule rule? ?-from x1 y1 x2 y2? ?-to x1 y1 x2 y2? ?-zoom x y? ?-subsample x y?");
+		    "source-image ?-compositingrule rule? ?-filter filter? ?-from x1 y1 x2 y2? ?-to x1 y1 x2 y2? ?-zoom x y? ?-subsample x y?");
 	    return TCL_ERROR;
 	}
 
@@ -892,6 +944,24 @@ ImgPhotoCmd(clientData, interp, objc, objv)
 		+ options.fromY * block.pitch;
 	block.width = options.fromX2 - options.fromX;
 	block.height = options.fromY2 - options.fromY;
+	if (options.filter == FILTER_BOX) {
+	    /*
+	     * Average each subsampled cell into a scratch block, which
+	     * is then copied without further subsampling.
+	     */
+
+	    unsigned char *filtered = BoxFilterBlock(&block,
+		    options.subsampleX, options.subsampleY);
+
+	    if (filtered != NULL) {
+		Tk_PhotoPutZoomedBlock((Tk_PhotoHandle) masterPtr, &block,
+			options.toX, options.toY, options.toX2 - options.toX,
+			options.toY2 - options.toY, options.zoomX,
+			options.zoomY, 1, 1, options.compositingRule);
+		ckfree((char *) filtered);
+		return TCL_OK;
+	    }
+	}
 	Tk_PhotoPutZoomedBlock((Tk_PhotoHandle) masterPtr, &block,
 		options.toX, options.toY, options.toX2 - options.toX,
 		options.toY2 - options.toY, options.zoomX, options.zoomY,
@@ -1708,6 +1778,29 @@ ParseSubcommandOptions(optPtr, interp, allowedOptions, optIndexPtr, objc, objv)
 			"requires a value", (char *) NULL);
 		return TCL_ERROR;
 	    }
+	} else if (bit == OPT_FILTER) {
+	    /*
+	     * The -filter option names how pixels are combined when
+	     * subsampling.
+	     */
+
+	    if (index + 1 < objc) {
+		static CONST char *filterNames[] = {
+		    "none", "box",
+		    NULL
+		};
+
+		index++;
+		if (Tcl_GetIndexFromObj(interp, objv[index], filterNames,
+			"filter", 0, &optPtr->filter) != TCL_OK) {
+		    return TCL_ERROR;
+		}
+		*optIndexPtr = index;
+	    } else {
+		Tcl_AppendResult(interp, "the \"-filter\" option ",
+			"requires a value", (char *) NULL);
+		return TCL_ERROR;
+	    }
 	} else if ((bit != OPT_SHRINK) && (bit != OPT_GRAYSCALE)) {
 	    char *val;
 	    maxValues = ((bit == OPT_FROM) || (bit == OPT_TO))? 4: 2;
@@ -1818,6 +1911,113 @@ ParseSubcommandOptions(optPtr, interp, allowedOptions, optIndexPtr, objc, objv)
     return TCL_OK;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * BoxFilterBlock --
+ *
+ *      Reduce a block of pixels by averaging each subsampleX by
+ *      subsampleY cell of source pixels, rather than picking one pixel
+ *      out of each cell as plain subsampling does.  Negative factors
+ *      flip the result as they do for -subsample.  Colours are
+ *      weighted by alpha so that transparent pixels do not darken
+ *      their neighbours.
+ *
+ * Results:
+ *      A newly allocated 32-bit RGBA buffer; blockPtr is updated to
+ *      describe it.  The caller must ckfree the buffer.  Returns NULL,
+ *      leaving blockPtr untouched, if either factor is zero.
+ *
+ * Side effects:
+ *      None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static unsigned char *
+BoxFilterBlock(blockPtr, subsampleX, subsampleY)
+    Tk_PhotoImageBlock *blockPtr;	/* Source block; replaced on return
+					 * with the filtered block. */
+    int subsampleX, subsampleY;		/* Cell size; sign selects flip. */
+{
+    int sx = (subsampleX < 0) ? -subsampleX : subsampleX;
+    int sy = (subsampleY < 0) ? -subsampleY : subsampleY;
+    int width, height, i, j, x, y, x0, x1, y0, y1;
+    int greenOffset, blueOffset, alphaOffset;
+    unsigned char *buffer, *destPtr, *srcPtr;
+    unsigned long r, g, b, a, n;
+
+    if (sx == 0 || sy == 0) {
+	return NULL;
+    }
+    width = (blockPtr->width + sx - 1) / sx;
+    height = (blockPtr->height + sy - 1) / sy;
+    greenOffset = blockPtr->offset[1] - blockPtr->offset[0];
+    blueOffset = blockPtr->offset[2] - blockPtr->offset[0];
+    alphaOffset = blockPtr->offset[3];
+    if ((alphaOffset >= blockPtr->pixelSize) || (alphaOffset < 0)) {
+	alphaOffset = 0;
+    } else {
+	alphaOffset -= blockPtr->offset[0];
+    }
+
+    buffer = (unsigned char *) ckalloc((unsigned) (width * height * 4));
+    destPtr = buffer;
+    for (j = 0; j < height; j++) {
+	if (subsampleY > 0) {
+	    y0 = j * sy;
+	    y1 = MIN(y0 + sy, blockPtr->height);
+	} else {
+	    y1 = blockPtr->height - j * sy;
+	    y0 = MAX(y1 - sy, 0);
+	}
+	for (i = 0; i < width; i++) {
+	    if (subsampleX > 0) {
+		x0 = i * sx;
+		x1 = MIN(x0 + sx, blockPtr->width);
+	    } else {
+		x1 = blockPtr->width - i * sx;
+		x0 = MAX(x1 - sx, 0);
+	    }
+	    r = g = b = a = 0;
+	    n = (unsigned long) (x1 - x0) * (y1 - y0);
+	    for (y = y0; y < y1; y++) {
+		srcPtr = blockPtr->pixelPtr + y * blockPtr->pitch
+			+ x0 * blockPtr->pixelSize + blockPtr->offset[0];
+		for (x = x0; x < x1; x++) {
+		    unsigned long alpha = alphaOffset ? srcPtr[alphaOffset] : 255;
+
+		    r += srcPtr[0] * alpha;
+		    g += srcPtr[greenOffset] * alpha;
+		    b += srcPtr[blueOffset] * alpha;
+		    a += alpha;
+		    srcPtr += blockPtr->pixelSize;
+		}
+	    }
+	    if (a) {
+		*destPtr++ = (unsigned char) ((r + a/2) / a);
+		*destPtr++ = (unsigned char) ((g + a/2) / a);
+		*destPtr++ = (unsigned char) ((b + a/2) / a);
+		*destPtr++ = (unsigned char) ((a + n/2) / n);
+	    } else {
+		destPtr[0] = destPtr[1] = destPtr[2] = destPtr[3] = 0;
+		destPtr += 4;
+	    }
+	}
+    }
+
+    blockPtr->pixelPtr = buffer;
+    blockPtr->width = width;
+    blockPtr->height = height;
+    blockPtr->pitch = width * 4;
+    blockPtr->pixelSize = 4;
+    blockPtr->offset[0] = 0;
+    blockPtr->offset[1] = 1;
+    blockPtr->offset[2] = 2;
+    blockPtr->offset[3] = 3;
+    return buffer;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -1992,6 +2192,19 @@ ImgPhotoConfigureMaster(interp, masterPtr, objc, objv, flags)
 	    goto errorExit;
 	}
 
+	result = PhotoCacheRead(masterPtr);
+	if (result == TCL_ERROR) {
+	    Tcl_ResetResult(interp);
+	    Tcl_AppendStringsToObj(Tcl_GetObjResult(interp),
+		    TK_PHOTO_ALLOC_FAILURE_MESSAGE, (char *) NULL);
+	    goto errorExit;
+	}
+	if (result == TCL_OK) {
+	    Tcl_ResetResult(interp);
+	    masterPtr->flags |= IMAGE_CHANGED;
+	    goto fileDone;
+	}
+
 	chan = Tcl_OpenFileChannel(interp, Tcl_GetString(masterPtr->fileString), "r", 0);
 	if (chan == NULL) {
 	    goto errorExit;
@@ -2027,10 +2240,12 @@ ImgPhotoConfigureMaster(interp, masterPtr, objc, objv, flags)
 	if (result != TCL_OK) {
 	    goto errorExit;
 	}
+	PhotoCacheSave(masterPtr);
 
 	Tcl_ResetResult(interp);
 	masterPtr->flags |= IMAGE_CHANGED;
     }
+    fileDone:
 
     if ((masterPtr->fileString == NULL) && (masterPtr->dataString != NULL)
 	    && ((masterPtr->dataString != oldData)
@@ -2119,6 +2334,287 @@ ImgPhotoConfigureMaster(interp, masterPtr, objc, objv, flags)
     return TCL_ERROR;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * PhotoCacheKey --
+ *
+ *	Builds the decoded image cache key for the -file and -format
+ *	options of a photo image.
+ *
+ * Results:
+ *	1 if the key was built, 0 if the image cannot be cached (the
+ *	cache is disabled, the file cannot be stat'ed, or the image has
+ *	a size set by the user, which may crop what is read).
+ *
+ * Side effects:
+ *	The key is left in *keyPtr, which the caller must free.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+PhotoCacheKey(masterPtr, keyPtr)
+    PhotoMaster *masterPtr;
+    Tcl_DString *keyPtr;
+{
+    struct stat statBuf;
+    char *fileName;
+    char buf[4 * TCL_INTEGER_SPACE];
+
+    if ((photoCache.limit <= 0) || (masterPtr->userWidth > 0)
+	    || (masterPtr->userHeight > 0)) {
+	return 0;
+    }
+    fileName = Tcl_GetString(masterPtr->fileString);
+    if (stat(fileName, &statBuf) != 0) {
+	return 0;
+    }
+    sprintf(buf, "%lu:%lu:%lu:%lu:", (unsigned long) statBuf.st_dev,
+	    (unsigned long) statBuf.st_ino, (unsigned long) statBuf.st_size,
+	    (unsigned long) statBuf.st_mtime);
+    Tcl_DStringInit(keyPtr);
+    Tcl_DStringAppend(keyPtr, buf, -1);
+    if (masterPtr->format != NULL) {
+	Tcl_DStringAppend(keyPtr, Tcl_GetString(masterPtr->format), -1);
+    }
+    Tcl_DStringAppend(keyPtr, "\n", 1);
+    Tcl_DStringAppend(keyPtr, fileName, -1);
+    return 1;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * PhotoCacheRead --
+ *
+ *	Fills a photo image from the decoded image cache, if its -file
+ *	and -format options are found there.
+ *
+ * Results:
+ *	TCL_OK if the image was filled from the cache, TCL_CONTINUE if
+ *	it must be read from the file, and TCL_ERROR if memory for the
+ *	image could not be allocated.
+ *
+ * Side effects:
+ *	The cache entry becomes the most recently used one.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+PhotoCacheRead(masterPtr)
+    PhotoMaster *masterPtr;
+{
+    Tcl_DString key;
+    Tcl_HashEntry *hPtr;
+    PhotoCacheEntry *entryPtr;
+    Tk_PhotoImageBlock block;
+
+    if (!PhotoCacheKey(masterPtr, &key)) {
+	return TCL_CONTINUE;
+    }
+    hPtr = Tcl_FindHashEntry(&photoCache.table, Tcl_DStringValue(&key));
+    Tcl_DStringFree(&key);
+    if (hPtr == NULL) {
+	photoCache.misses++;
+	return TCL_CONTINUE;
+    }
+    photoCache.hits++;
+    entryPtr = (PhotoCacheEntry *) Tcl_GetHashValue(hPtr);
+
+    if (entryPtr != photoCache.firstPtr) {
+	entryPtr->prevPtr->nextPtr = entryPtr->nextPtr;
+	if (entryPtr->nextPtr != NULL) {
+	    entryPtr->nextPtr->prevPtr = entryPtr->prevPtr;
+	} else {
+	    photoCache.lastPtr = entryPtr->prevPtr;
+	}
+	entryPtr->prevPtr = NULL;
+	entryPtr->nextPtr = photoCache.firstPtr;
+	photoCache.firstPtr->prevPtr = entryPtr;
+	photoCache.firstPtr = entryPtr;
+    }
+
+    if (ImgPhotoSetSize(masterPtr, entryPtr->width, entryPtr->height)
+	    != TCL_OK) {
+	return TCL_ERROR;
+    }
+    block.pixelPtr = entryPtr->pixels;
+    block.width = entryPtr->width;
+    block.height = entryPtr->height;
+    block.pitch = entryPtr->width * 4;
+    block.pixelSize = 4;
+    block.offset[0] = 0;
+    block.offset[1] = 1;
+    block.offset[2] = 2;
+    block.offset[3] = 3;
+    Tk_PhotoPutBlock((Tk_PhotoHandle) masterPtr, &block, 0, 0,
+	    entryPtr->width, entryPtr->height, TK_PHOTO_COMPOSITE_SET);
+    return TCL_OK;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * PhotoCacheSave --
+ *
+ *	Adds the pixels of a photo image just read from its -file to
+ *	the decoded image cache.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Less recently used entries may be dropped to make room.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+PhotoCacheSave(masterPtr)
+    PhotoMaster *masterPtr;
+{
+    Tcl_DString key;
+    Tcl_HashEntry *hPtr;
+    PhotoCacheEntry *entryPtr;
+    long bytes = (long) masterPtr->width * masterPtr->height * 4;
+    int new;
+
+    if ((masterPtr->pix32 == NULL) || (bytes <= 0)
+	    || (bytes > photoCache.limit)
+	    || !PhotoCacheKey(masterPtr, &key)) {
+	return;
+    }
+    hPtr = Tcl_CreateHashEntry(&photoCache.table, Tcl_DStringValue(&key),
+	    &new);
+    Tcl_DStringFree(&key);
+    if (!new) {
+	return;
+    }
+    PhotoCacheTrim(photoCache.limit - bytes);
+
+    entryPtr = (PhotoCacheEntry *) ckalloc(sizeof(PhotoCacheEntry));
+    entryPtr->hPtr = hPtr;
+    entryPtr->width = masterPtr->width;
+    entryPtr->height = masterPtr->height;
+    entryPtr->pixels = (unsigned char *) ckalloc((unsigned) bytes);
+    memcpy(entryPtr->pixels, masterPtr->pix32, (size_t) bytes);
+    entryPtr->prevPtr = NULL;
+    entryPtr->nextPtr = photoCache.firstPtr;
+    if (photoCache.firstPtr != NULL) {
+	photoCache.firstPtr->prevPtr = entryPtr;
+    } else {
+	photoCache.lastPtr = entryPtr;
+    }
+    photoCache.firstPtr = entryPtr;
+    photoCache.bytes += bytes;
+    Tcl_SetHashValue(hPtr, (ClientData) entryPtr);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * PhotoCacheTrim --
+ *
+ *	Drops least recently used entries from the decoded image cache
+ *	until it holds no more than limit bytes of pixels.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Memory is freed.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+PhotoCacheTrim(limit)
+    long limit;
+{
+    PhotoCacheEntry *entryPtr;
+
+    while ((photoCache.bytes > limit) && (photoCache.lastPtr != NULL)) {
+	entryPtr = photoCache.lastPtr;
+	photoCache.lastPtr = entryPtr->prevPtr;
+	if (photoCache.lastPtr != NULL) {
+	    photoCache.lastPtr->nextPtr = NULL;
+	} else {
+	    photoCache.firstPtr = NULL;
+	}
+	photoCache.bytes -= (long) entryPtr->width * entryPtr->height * 4;
+	photoCache.evictions++;
+	Tcl_DeleteHashEntry(entryPtr->hPtr);
+	ckfree((char *) entryPtr->pixels);
+	ckfree((char *) entryPtr);
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkPhotoCacheLimit --
+ *
+ *	Sets how many bytes of decoded pixels the photo image cache may
+ *	keep.  The cache is disabled (the default) when this is 0.
+ *
+ * Results:
+ *	The previous limit.
+ *
+ * Side effects:
+ *	Entries are dropped if the new limit is lower.
+ *
+ *----------------------------------------------------------------------
+ */
+
+long
+TkPhotoCacheLimit(limit)
+    long limit;			/* New limit, or < 0 to leave it alone. */
+{
+    long oldLimit = photoCache.limit;
+
+    if (!photoCache.initialized) {
+	Tcl_InitHashTable(&photoCache.table, TCL_STRING_KEYS);
+	photoCache.initialized = 1;
+    }
+    if (limit >= 0) {
+	photoCache.limit = limit;
+	PhotoCacheTrim(limit);
+    }
+    return oldLimit;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkPhotoCacheStats --
+ *
+ *	Reports on the decoded photo image cache:  the number of
+ *	entries, the bytes of pixels they hold, the limit, and the
+ *	number of hits, misses and evictions so far.
+ *
+ * Results:
+ *	The six values are stored in statsPtr.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+void
+TkPhotoCacheStats(statsPtr)
+    double *statsPtr;
+{
+    statsPtr[0] = photoCache.initialized ? photoCache.table.numEntries : 0;
+    statsPtr[1] = (double) photoCache.bytes;
+    statsPtr[2] = (double) photoCache.limit;
+    statsPtr[3] = (double) photoCache.hits;
+    statsPtr[4] = (double) photoCache.misses;
+    statsPtr[5] = (double) photoCache.evictions;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -4584,6 +5080,7 @@ Tk_PhotoPutZoomedBlock(handle, blockPtr, x, y, width, height, zoomX, zoomY,
     int pitch;
     int xRepeat, yRepeat;
     int blockXSkip, blockYSkip;
+    int opaqueCopy;
     XRectangle rect;
 
     if (zoomX==1 && zoomY==1 && subsampleX==1 && subsampleY==1) {
@@ -4682,7 +5179,20 @@ Tk_PhotoPutZoomedBlock(handle, blockPtr, x, y, width, height, zoomX, zoomY,
 	srcOrigPtr += (blockPtr->height - 1) * blockPtr->pitch;
     }
 
+    /*
+     * When each destination pixel depends only on its source pixel (no
+     * alpha to blend, or the "set" rule) rows can be built a whole
+     * pixel at a time, and the 2nd and later rows of each zoomed row
+     * are byte copies of the first.  That does not hold when the block
+     * is a view of this image's own pixels, since writing a row may
+     * change the source for the next one.
+     */
+
     pitch = masterPtr->width * 4;
+    opaqueCopy = (!alphaOffset || compRule == TK_PHOTO_COMPOSITE_SET)
+	    && ((blockPtr->pixelPtr < masterPtr->pix32)
+	    || (blockPtr->pixelPtr >= masterPtr->pix32
+		    + masterPtr->height * pitch));
     for (hLeft = height; hLeft > 0; ) {
 	hCopy = MIN(hLeft, blockHt);
 	hLeft -= hCopy;
@@ -4690,7 +5200,30 @@ Tk_PhotoPutZoomedBlock(handle, blockPtr, x, y, width, height, zoomX, zoomY,
 	srcLinePtr = srcOrigPtr;
 	for (; hCopy > 0; --hCopy) {
 	    destPtr = destLinePtr;
-	    for (wLeft = width; wLeft > 0;) {
+	    if (opaqueCopy && yRepeat < zoomY) {
+		memcpy(destPtr, destPtr - pitch, (size_t) (width * 4));
+	    } else if (opaqueCopy) {
+		for (wLeft = width; wLeft > 0;) {
+		    wCopy = MIN(wLeft, blockWid);
+		    wLeft -= wCopy;
+		    srcPtr = srcLinePtr;
+		    for (; wCopy > 0; wCopy -= zoomX) {
+			unsigned char pixel[4];
+
+			pixel[0] = srcPtr[0];
+			pixel[1] = srcPtr[greenOffset];
+			pixel[2] = srcPtr[blueOffset];
+			pixel[3] = alphaOffset ? srcPtr[alphaOffset] : 255;
+			for (xRepeat = MIN(wCopy, zoomX); xRepeat > 0;
+				xRepeat--) {
+			    memcpy(destPtr, pixel, 4);
+			    destPtr += 4;
+			}
+			srcPtr += blockXSkip;
+		    }
+		}
+	    }
+	    for (wLeft = opaqueCopy ? 0 : width; wLeft > 0;) {
 		wCopy = MIN(wLeft, blockWid);
 		wLeft -= wCopy;
 		srcPtr = srcLinePtr;
@@ -506,6 +506,30 @@ typedef struct TkDisplay {
 				 * display.  This is not a pointer. */
     int iconDataSize;		/* Size of default iconphoto image data */
     unsigned char *iconDataPtr;	/* Default iconphoto image data, if set */
+
+    /*
+     * Information used by tkGC.c to pool redisplay buffers:
+     */
+
+    struct TkBufferPixmap *bufferPixmaps;
+				/* Off-screen pixmaps available for widget
+				 * redisplay, see TkGetBufferPixmap. */
+    Tcl_TimerToken bufferTrimTimer;
+				/* Timer that frees unused buffers, or NULL. */
+    long bufferHits;		/* Number of buffer requests served from */
+    long bufferMisses;		/* the pool, and not served from it. */
+
+    /*
+     * Information used by tkTableGeom.c only:
+     */
+
+    int tableInit;		/* 0 means tables below need initializing. */
+    Tcl_HashTable tableMasterTable;
+				/* Maps from Tk_Window token to the Table
+				 * structure for a window managing slaves. */
+    Tcl_HashTable tableSlaveTable;
+				/* Maps from Tk_Window token to the
+				 * TableSlave structure for a managed slave. */
 } TkDisplay;
 
 /*
@@ -859,6 +883,19 @@ typedef struct TkpClipMask {
 #define TKP_CLIP_PIXMAP 0
 #define TKP_CLIP_REGION 1
 
+/*
+ * One image of a multi-image GIF, as reported by TkGetGIFFrameInfo.
+ */
+
+typedef struct TkGIFFrameInfo {
+    int left, top;		/* Position within the logical screen. */
+    int width, height;		/* Size of the image. */
+    int delay;			/* Time to show it, in 1/100 seconds. */
+    int disposal;		/* What to do with it afterwards:  0 or 1
+				 * leave it, 2 restore the background, 3
+				 * restore what was there before. */
+} TkGIFFrameInfo;
+
 /*
  * Pointer to first entry in list of all displays currently known.
  */
@@ -1067,6 +1104,9 @@ EXTERN int		Tk_SendObjCmd _ANSI_ARGS_((ClientData clientData,
 EXTERN int		Tk_SpinboxObjCmd _ANSI_ARGS_((ClientData clientData,
 			    Tcl_Interp *interp, int objc,
                             Tcl_Obj *CONST objv[]));
+EXTERN int		Tk_TableObjCmd _ANSI_ARGS_((ClientData clientData,
+			    Tcl_Interp *interp, int objc,
+			    Tcl_Obj *CONST objv[]));
 EXTERN int		Tk_TextCmd _ANSI_ARGS_((ClientData clientData,
 			    Tcl_Interp *interp, int argc, char **argv));
 EXTERN int		Tk_TkObjCmd _ANSI_ARGS_((ClientData clientData,
@@ -1173,6 +1213,20 @@ EXTERN Tcl_Obj *	TkTilePrintProc _ANSI_ARGS_((
 			    ClientData clientData, Tk_Window tkwin,
 			    char *widgRec, int offset,
 			    Tcl_FreeProc **freeProcPtr));
+EXTERN Pixmap		TkGetBufferPixmap _ANSI_ARGS_((Tk_Window tkwin,
+			    int width, int height));
+EXTERN void		TkFreeBufferPixmap _ANSI_ARGS_((Tk_Window tkwin,
+			    Pixmap pixmap));
+EXTERN void		TkGetBufferPixmapStats _ANSI_ARGS_((Tk_Window tkwin,
+			    double *statsPtr));
+EXTERN void		TkBufferPixmapCleanup _ANSI_ARGS_((
+			    TkDisplay *dispPtr));
+EXTERN long		TkPhotoCacheLimit _ANSI_ARGS_((long limit));
+EXTERN void		TkPhotoCacheStats _ANSI_ARGS_((double *statsPtr));
+EXTERN int		TkGetGIFFrameInfo _ANSI_ARGS_((Tcl_Interp *interp,
+			    Tcl_Obj *source, int isData,
+			    TkGIFFrameInfo **framesPtr, int *numFramesPtr,
+			    int *loopPtr));
 
 /*
  * Unsupported commands.
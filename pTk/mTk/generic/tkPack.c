@@ -69,6 +69,27 @@ typedef struct Packer {
 				 * is deleted. */
     int flags;			/* Miscellaneous flags;  see below
 				 * for definitions. */
+    int frameX, frameY, frameWidth, frameHeight;
+				/* Frame allocated to this window by the
+				 * last call to ArrangePacking. */
+    int lastWidth, lastHeight;	/* Requested size of the window (including
+				 * border) when its master was last
+				 * arranged. */
+    int need;			/* Space needed by the master, across the
+				 * side this window is packed against, to
+				 * hold this window as of the last
+				 * ArrangePacking.  For a master, the
+				 * width or height it needed is kept in
+				 * needWidth and needHeight instead. */
+    int needWidth, needHeight;	/* Size needed by the slaves of this window
+				 * as of the last ArrangePacking. */
+    int numNeedWidth, numNeedHeight;
+				/* How many things need exactly needWidth
+				 * (needHeight):  slaves whose need it is,
+				 * plus one if the slaves along the other
+				 * sides or the master's minimum size do.
+				 * A slave may shrink away from the needed
+				 * size while another still needs it. */
 } Packer;
 
 /*
@@ -92,6 +113,16 @@ typedef struct Packer {
  *				size.  0 means if this window is a master
  *				then Tk will set its requested size to fit
  *				the needs of its slaves.
+ * REQUESTED_UPDATE:		1 means a Tcl_DoWhenIdle request has been
+ *				made to PackUpdateSlaves for this master.
+ * LAYOUT_VALID:		1 means the frame and need fields of the
+ *				slaves describe the last complete run of
+ *				ArrangePacking for this master.
+ * SIZE_CHANGED:		1 means this slave's requested size changed
+ *				since it was last arranged.
+ * EXPAND_DEPENDS:		1 means the share of extra space given to
+ *				some earlier expandable slave depends on
+ *				this slave's size across its side.
  */
 
 #define REQUESTED_REPACK	1
@@ -100,6 +131,10 @@ typedef struct Packer {
 #define EXPAND			8
 #define OLD_STYLE		16
 #define DONT_PROPAGATE		32
+#define REQUESTED_UPDATE	64
+#define LAYOUT_VALID		128
+#define SIZE_CHANGED		256
+#define EXPAND_DEPENDS		512
 
 /*
  * The following structure is the official type record for the
@@ -126,6 +161,7 @@ static int		ConfigureSlaves _ANSI_ARGS_((Tcl_Interp *interp,
 			    Tk_Window tkwin, int objc, Tcl_Obj *CONST objv[]));
 static void             DestroyPacker _ANSI_ARGS_((char *memPtr));
 static Packer *		GetPacker _ANSI_ARGS_((Tk_Window tkwin));
+static void		PackUpdateSlaves _ANSI_ARGS_((ClientData clientData));
 static int		PackAfter _ANSI_ARGS_((Tcl_Interp *interp,
 			    Packer *prevPtr, Packer *masterPtr, int objc,
 			    Tcl_Obj *CONST objv[]));
@@ -133,6 +169,8 @@ static void		PackReqProc _ANSI_ARGS_((ClientData clientData,
 			    Tk_Window tkwin));
 static void		PackStructureProc _ANSI_ARGS_((ClientData clientData,
 			    XEvent *eventPtr));
+static void		PlaceSlave _ANSI_ARGS_((Packer *masterPtr,
+			    Packer *slavePtr));
 static void		Unlink _ANSI_ARGS_((Packer *packPtr));
 static int		XExpansion _ANSI_ARGS_((Packer *slavePtr,
 			    int cavityWidth));
@@ -486,11 +524,141 @@ PackReqProc(clientData, tkwin)
 {
     register Packer *packPtr = (Packer *) clientData;
 
+    packPtr->flags |= SIZE_CHANGED;
     packPtr = packPtr->masterPtr;
-    if (!(packPtr->flags & REQUESTED_REPACK)) {
-	packPtr->flags |= REQUESTED_REPACK;
-	Tcl_DoWhenIdle(ArrangePacking, (ClientData) packPtr);
+    if (!(packPtr->flags & (REQUESTED_REPACK|REQUESTED_UPDATE))) {
+	packPtr->flags |= REQUESTED_UPDATE;
+	Tcl_DoWhenIdle(PackUpdateSlaves, (ClientData) packPtr);
+    }
+}
+
+/*
+ *--------------------------------------------------------------
+ *
+ * PackUpdateSlaves --
+ *
+ *	This procedure is invoked (using the Tcl_DoWhenIdle
+ *	mechanism) after slaves of a master changed their requested
+ *	size.  If none of the changes can move the frame of any
+ *	slave or change the size needed by the master, the changed
+ *	slaves are just re-placed in their frames.  Otherwise the
+ *	whole master is repacked.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Slaves of masterPtr may get resized or moved.
+ *
+ *--------------------------------------------------------------
+ */
+
+static void
+PackUpdateSlaves(clientData)
+    ClientData clientData;	/* Structure describing parent whose slaves
+				 * changed size. */
+{
+    register Packer *masterPtr = (Packer *) clientData;
+    register Packer *slavePtr;
+    int abort;
+
+    masterPtr->flags &= ~REQUESTED_UPDATE;
+    if (masterPtr->flags & REQUESTED_REPACK) {
+	return;
+    }
+    if (!(masterPtr->flags & LAYOUT_VALID)
+	    || (masterPtr->abortPtr != NULL)) {
+	ArrangePacking(clientData);
+	return;
+    }
+
+    /*
+     * A slave's frame depends on the sizes of the slaves before it
+     * along the sides they are packed against, so a slave may only
+     * change size across its own side.  Even then it must not grow
+     * beyond what the master needs, nor shrink from it unless another
+     * slave needs as much, and no earlier slave may be expanding into
+     * space it leaves.
+     */
+
+    for (slavePtr = masterPtr->slavePtr; slavePtr != NULL;
+	    slavePtr = slavePtr->nextPtr) {
+	int width, height, need, *maxPtr, *countPtr;
+
+	if (!(slavePtr->flags & SIZE_CHANGED)) {
+	    continue;
+	}
+	width = Tk_ReqWidth(slavePtr->tkwin) + slavePtr->doubleBw;
+	height = Tk_ReqHeight(slavePtr->tkwin) + slavePtr->doubleBw;
+	if ((width == slavePtr->lastWidth)
+		&& (height == slavePtr->lastHeight)) {
+	    continue;
+	}
+	if (slavePtr->flags & EXPAND_DEPENDS) {
+	    goto repack;
+	}
+	if ((slavePtr->side == TOP) || (slavePtr->side == BOTTOM)) {
+	    if (height != slavePtr->lastHeight) {
+		goto repack;
+	    }
+	    need = slavePtr->need + width - slavePtr->lastWidth;
+	    maxPtr = &masterPtr->needWidth;
+	    countPtr = &masterPtr->numNeedWidth;
+	} else {
+	    if (width != slavePtr->lastWidth) {
+		goto repack;
+	    }
+	    need = slavePtr->need + height - slavePtr->lastHeight;
+	    maxPtr = &masterPtr->needHeight;
+	    countPtr = &masterPtr->numNeedHeight;
+	}
+	if (need > *maxPtr) {
+	    goto repack;
+	}
+	if (need == slavePtr->need) {
+	    continue;
+	}
+	if (slavePtr->need == *maxPtr) {
+	    if (*countPtr <= 1) {
+		goto repack;
+	    }
+	    (*countPtr)--;
+	} else if (need == *maxPtr) {
+	    (*countPtr)++;
+	}
+    }
+
+    masterPtr->abortPtr = &abort;
+    abort = 0;
+    Tcl_Preserve((ClientData) masterPtr);
+    for (slavePtr = masterPtr->slavePtr; slavePtr != NULL && !abort;
+	    slavePtr = slavePtr->nextPtr) {
+	int width, height;
+
+	if (!(slavePtr->flags & SIZE_CHANGED)) {
+	    continue;
+	}
+	slavePtr->flags &= ~SIZE_CHANGED;
+	width = Tk_ReqWidth(slavePtr->tkwin) + slavePtr->doubleBw;
+	height = Tk_ReqHeight(slavePtr->tkwin) + slavePtr->doubleBw;
+	if ((slavePtr->side == TOP) || (slavePtr->side == BOTTOM)) {
+	    slavePtr->need += width - slavePtr->lastWidth;
+	} else {
+	    slavePtr->need += height - slavePtr->lastHeight;
+	}
+	slavePtr->lastWidth = width;
+	slavePtr->lastHeight = height;
+	PlaceSlave(masterPtr, slavePtr);
+    }
+    if (abort) {
+	masterPtr->flags &= ~LAYOUT_VALID;
     }
+    masterPtr->abortPtr = NULL;
+    Tcl_Release((ClientData) masterPtr);
+    return;
+
+    repack:
+    ArrangePacking(clientData);
 }
 
 /*
@@ -561,16 +729,14 @@ ArrangePacking(clientData)
     int frameX, frameY, frameWidth, frameHeight;
 				/* These variables keep track of the frame
 				 * allocated to the current window. */
-    int x, y, width, height;	/* These variables are used to hold the
-				 * actual geometry of the current window. */
+    int width, height;		/* Space used so far by the slaves. */
     int abort;			/* May get set to non-zero to abort this
 				 * repacking operation. */
-    int borderX, borderY;
-    int borderTop, borderBtm;
-    int borderLeft, borderRight;
+    int expandX, expandY;	/* Non-zero once an expandable slave has
+				 * been packed left/right or top/bottom. */
     int maxWidth, maxHeight, tmp;
 
-    masterPtr->flags &= ~REQUESTED_REPACK;
+    masterPtr->flags &= ~(REQUESTED_REPACK|LAYOUT_VALID);
 
     /*
      * If the parent has no slaves anymore, then don't do anything
@@ -620,23 +786,27 @@ ArrangePacking(clientData)
 	    Tk_InternalBorderBottom(masterPtr->tkwin);
     for (slavePtr = masterPtr->slavePtr; slavePtr != NULL;
 	    slavePtr = slavePtr->nextPtr) {
+	slavePtr->flags &= ~SIZE_CHANGED;
+	slavePtr->lastWidth = Tk_ReqWidth(slavePtr->tkwin)
+		+ slavePtr->doubleBw;
+	slavePtr->lastHeight = Tk_ReqHeight(slavePtr->tkwin)
+		+ slavePtr->doubleBw;
 	if ((slavePtr->side == TOP) || (slavePtr->side == BOTTOM)) {
-	    tmp = Tk_ReqWidth(slavePtr->tkwin) + slavePtr->doubleBw
-		    + slavePtr->padX + slavePtr->iPadX + width;
+	    tmp = slavePtr->lastWidth + slavePtr->padX + slavePtr->iPadX
+		    + width;
 	    if (tmp > maxWidth) {
 		maxWidth = tmp;
 	    }
-	    height += Tk_ReqHeight(slavePtr->tkwin) + slavePtr->doubleBw
-		    + slavePtr->padY + slavePtr->iPadY;
+	    height += slavePtr->lastHeight + slavePtr->padY + slavePtr->iPadY;
 	} else {
-	    tmp = Tk_ReqHeight(slavePtr->tkwin) + slavePtr->doubleBw
-		    + slavePtr->padY + slavePtr->iPadY + height;
+	    tmp = slavePtr->lastHeight + slavePtr->padY + slavePtr->iPadY
+		    + height;
 	    if (tmp > maxHeight) {
 		maxHeight = tmp;
 	    }
-	    width += Tk_ReqWidth(slavePtr->tkwin) + slavePtr->doubleBw
-		    + slavePtr->padX + slavePtr->iPadX;
+	    width += slavePtr->lastWidth + slavePtr->padX + slavePtr->iPadX;
 	}
+	slavePtr->need = tmp;
     }
     if (width > maxWidth) {
 	maxWidth = width;
@@ -651,6 +821,20 @@ ArrangePacking(clientData)
     if (maxHeight < Tk_MinReqHeight(masterPtr->tkwin)) {
 	maxHeight = Tk_MinReqHeight(masterPtr->tkwin);
     }
+    masterPtr->needWidth = maxWidth;
+    masterPtr->needHeight = maxHeight;
+    masterPtr->numNeedWidth = ((width == maxWidth)
+	    || (Tk_MinReqWidth(masterPtr->tkwin) == maxWidth));
+    masterPtr->numNeedHeight = ((height == maxHeight)
+	    || (Tk_MinReqHeight(masterPtr->tkwin) == maxHeight));
+    for (slavePtr = masterPtr->slavePtr; slavePtr != NULL;
+	    slavePtr = slavePtr->nextPtr) {
+	if ((slavePtr->side == TOP) || (slavePtr->side == BOTTOM)) {
+	    masterPtr->numNeedWidth += (slavePtr->need == maxWidth);
+	} else {
+	    masterPtr->numNeedHeight += (slavePtr->need == maxHeight);
+	}
+    }
 
     /*
      * If the total amount of space needed in the parent window has
@@ -680,17 +864,26 @@ ArrangePacking(clientData)
      * frame, depending on anchor.
      */
 
-    cavityX = x = Tk_InternalBorderLeft(masterPtr->tkwin);
-    cavityY = y = Tk_InternalBorderTop(masterPtr->tkwin);
+    cavityX = Tk_InternalBorderLeft(masterPtr->tkwin);
+    cavityY = Tk_InternalBorderTop(masterPtr->tkwin);
     cavityWidth = Tk_Width(masterPtr->tkwin) -
 	    Tk_InternalBorderLeft(masterPtr->tkwin) -
 	    Tk_InternalBorderRight(masterPtr->tkwin);
     cavityHeight = Tk_Height(masterPtr->tkwin) -
 	    Tk_InternalBorderTop(masterPtr->tkwin) -
 	    Tk_InternalBorderBottom(masterPtr->tkwin);
+    expandX = expandY = 0;
     for (slavePtr = masterPtr->slavePtr; slavePtr != NULL;
 	    slavePtr = slavePtr->nextPtr) {
 	if ((slavePtr->side == TOP) || (slavePtr->side == BOTTOM)) {
+	    if (expandX) {
+		slavePtr->flags |= EXPAND_DEPENDS;
+	    } else {
+		slavePtr->flags &= ~EXPAND_DEPENDS;
+	    }
+	    if (slavePtr->flags & EXPAND) {
+		expandY = 1;
+	    }
 	    frameWidth = cavityWidth;
 	    frameHeight = Tk_ReqHeight(slavePtr->tkwin) + slavePtr->doubleBw
 		    + slavePtr->padY + slavePtr->iPadY;
@@ -710,6 +903,14 @@ ArrangePacking(clientData)
 		frameY = cavityY + cavityHeight;
 	    }
 	} else {
+	    if (expandY) {
+		slavePtr->flags |= EXPAND_DEPENDS;
+	    } else {
+		slavePtr->flags &= ~EXPAND_DEPENDS;
+	    }
+	    if (slavePtr->flags & EXPAND) {
+		expandX = 1;
+	    }
 	    frameHeight = cavityHeight;
 	    frameWidth = Tk_ReqWidth(slavePtr->tkwin) + slavePtr->doubleBw
 		    + slavePtr->padX + slavePtr->iPadX;
@@ -730,121 +931,11 @@ ArrangePacking(clientData)
 	    }
 	}
 
-	/*
-	 * Now that we've got the size of the frame for the window,
-	 * compute the window's actual size and location using the
-	 * fill, padding, and frame factors.  The variables "borderX"
-	 * and "borderY" are used to handle the differences between
-	 * old-style packing and the new style (in old-style, iPadX
-	 * and iPadY are always zero and padding is completely ignored
-	 * except when computing frame size).
-	 */
-
-	if (slavePtr->flags & OLD_STYLE) {
-	    borderX = borderY = 0;
-	    borderTop = borderBtm = 0;
-	    borderLeft = borderRight = 0;
-	} else {
-	    borderX = slavePtr->padX;
-	    borderY = slavePtr->padY;
-	    borderLeft = slavePtr->padLeft;
-	    borderRight = borderX - borderLeft;
-	    borderTop = slavePtr->padTop;
-	    borderBtm = borderY - borderTop;
-	}
-	width = Tk_ReqWidth(slavePtr->tkwin) + slavePtr->doubleBw
-		+ slavePtr->iPadX;
-	if ((slavePtr->flags & FILLX)
-		|| (width > (frameWidth - borderX))) {
-	    width = frameWidth - borderX;
-	}
-	height = Tk_ReqHeight(slavePtr->tkwin) + slavePtr->doubleBw
-		+ slavePtr->iPadY;
-	if ((slavePtr->flags & FILLY)
-		|| (height > (frameHeight - borderY))) {
-	    height = frameHeight - borderY;
-	}
-	switch (slavePtr->anchor) {
-	    case TK_ANCHOR_N:
-		x = frameX + (borderLeft + frameWidth - width - borderRight)/2;
-		y = frameY + borderTop;
-		break;
-	    case TK_ANCHOR_NE:
-		x = frameX + frameWidth - width - borderRight;
-		y = frameY + borderTop;
-		break;
-	    case TK_ANCHOR_E:
-		x = frameX + frameWidth - width - borderRight;
-		y = frameY + (borderTop + frameHeight - height - borderBtm)/2;
-		break;
-	    case TK_ANCHOR_SE:
-		x = frameX + frameWidth - width - borderRight;
-		y = frameY + frameHeight - height - borderBtm;
-		break;
-	    case TK_ANCHOR_S:
-		x = frameX + (borderLeft + frameWidth - width - borderRight)/2;
-		y = frameY + frameHeight - height - borderBtm;
-		break;
-	    case TK_ANCHOR_SW:
-		x = frameX + borderLeft;
-		y = frameY + frameHeight - height - borderBtm;
-		break;
-	    case TK_ANCHOR_W:
-		x = frameX + borderLeft;
-		y = frameY + (borderTop + frameHeight - height - borderBtm)/2;
-		break;
-	    case TK_ANCHOR_NW:
-		x = frameX + borderLeft;
-		y = frameY + borderTop;
-		break;
-	    case TK_ANCHOR_CENTER:
-		x = frameX + (borderLeft + frameWidth - width - borderRight)/2;
-		y = frameY + (borderTop + frameHeight - height - borderBtm)/2;
-		break;
-	    default:
-		panic("bad frame factor in ArrangePacking");
-	}
-	width -= slavePtr->doubleBw;
-	height -= slavePtr->doubleBw;
-
-	/*
-	 * The final step is to set the position, size, and mapped/unmapped
-	 * state of the slave.  If the slave is a child of the master, then
-	 * do this here.  Otherwise let Tk_MaintainGeometry do the work.
-	 */
-
-	if (masterPtr->tkwin == Tk_Parent(slavePtr->tkwin)) {
-	    if ((width <= 0) || (height <= 0)) {
-		Tk_UnmapWindow(slavePtr->tkwin);
-	    } else {
-		if ((x != Tk_X(slavePtr->tkwin))
-			|| (y != Tk_Y(slavePtr->tkwin))
-			|| (width != Tk_Width(slavePtr->tkwin))
-			|| (height != Tk_Height(slavePtr->tkwin))) {
-		    Tk_MoveResizeWindow(slavePtr->tkwin, x, y, width, height);
-		}
-		if (abort) {
-		    goto done;
-		}
-
-		/*
-		 * Don't map the slave if the master isn't mapped: wait
-		 * until the master gets mapped later.
-		 */
-
-		if (Tk_IsMapped(masterPtr->tkwin)) {
-		    Tk_MapWindow(slavePtr->tkwin);
-		}
-	    }
-	} else {
-	    if ((width <= 0) || (height <= 0)) {
-		Tk_UnmaintainGeometry(slavePtr->tkwin, masterPtr->tkwin);
-		Tk_UnmapWindow(slavePtr->tkwin);
-	    } else {
-		Tk_MaintainGeometry(slavePtr->tkwin, masterPtr->tkwin,
-			x, y, width, height);
-	    }
-	}
+	slavePtr->frameX = frameX;
+	slavePtr->frameY = frameY;
+	slavePtr->frameWidth = frameWidth;
+	slavePtr->frameHeight = frameHeight;
+	PlaceSlave(masterPtr, slavePtr);
 
 	/*
 	 * Changes to the window's structure could cause almost anything
@@ -856,12 +947,163 @@ ArrangePacking(clientData)
 	    goto done;
 	}
     }
+    masterPtr->flags |= LAYOUT_VALID;
 
     done:
     masterPtr->abortPtr = NULL;
     Tcl_Release((ClientData) masterPtr);
 }
 
+/*
+ *--------------------------------------------------------------
+ *
+ * PlaceSlave --
+ *
+ *	Set the size and position of a slave inside the frame that
+ *	ArrangePacking allocated to it.  Must be called with
+ *	masterPtr->abortPtr set.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The slave may get resized, moved, mapped or unmapped.
+ *
+ *--------------------------------------------------------------
+ */
+
+static void
+PlaceSlave(masterPtr, slavePtr)
+    Packer *masterPtr;		/* Master the slave is packed in. */
+    register Packer *slavePtr;	/* Slave to place. */
+{
+    int x, y, width, height;	/* These variables are used to hold the
+				 * actual geometry of the window. */
+    int borderX, borderY;
+    int borderTop, borderBtm;
+    int borderLeft, borderRight;
+    int frameX = slavePtr->frameX;
+    int frameY = slavePtr->frameY;
+    int frameWidth = slavePtr->frameWidth;
+    int frameHeight = slavePtr->frameHeight;
+
+    /*
+     * Now that we've got the size of the frame for the window,
+     * compute the window's actual size and location using the
+     * fill, padding, and frame factors.  The variables "borderX"
+     * and "borderY" are used to handle the differences between
+     * old-style packing and the new style (in old-style, iPadX
+     * and iPadY are always zero and padding is completely ignored
+     * except when computing frame size).
+     */
+
+    if (slavePtr->flags & OLD_STYLE) {
+	borderX = borderY = 0;
+	borderTop = borderBtm = 0;
+	borderLeft = borderRight = 0;
+    } else {
+	borderX = slavePtr->padX;
+	borderY = slavePtr->padY;
+	borderLeft = slavePtr->padLeft;
+	borderRight = borderX - borderLeft;
+	borderTop = slavePtr->padTop;
+	borderBtm = borderY - borderTop;
+    }
+    width = Tk_ReqWidth(slavePtr->tkwin) + slavePtr->doubleBw
+	    + slavePtr->iPadX;
+    if ((slavePtr->flags & FILLX)
+	    || (width > (frameWidth - borderX))) {
+	width = frameWidth - borderX;
+    }
+    height = Tk_ReqHeight(slavePtr->tkwin) + slavePtr->doubleBw
+	    + slavePtr->iPadY;
+    if ((slavePtr->flags & FILLY)
+	    || (height > (frameHeight - borderY))) {
+	height = frameHeight - borderY;
+    }
+    switch (slavePtr->anchor) {
+	case TK_ANCHOR_N:
+	    x = frameX + (borderLeft + frameWidth - width - borderRight)/2;
+	    y = frameY + borderTop;
+	    break;
+	case TK_ANCHOR_NE:
+	    x = frameX + frameWidth - width - borderRight;
+	    y = frameY + borderTop;
+	    break;
+	case TK_ANCHOR_E:
+	    x = frameX + frameWidth - width - borderRight;
+	    y = frameY + (borderTop + frameHeight - height - borderBtm)/2;
+	    break;
+	case TK_ANCHOR_SE:
+	    x = frameX + frameWidth - width - borderRight;
+	    y = frameY + frameHeight - height - borderBtm;
+	    break;
+	case TK_ANCHOR_S:
+	    x = frameX + (borderLeft + frameWidth - width - borderRight)/2;
+	    y = frameY + frameHeight - height - borderBtm;
+	    break;
+	case TK_ANCHOR_SW:
+	    x = frameX + borderLeft;
+	    y = frameY + frameHeight - height - borderBtm;
+	    break;
+	case TK_ANCHOR_W:
+	    x = frameX + borderLeft;
+	    y = frameY + (borderTop + frameHeight - height - borderBtm)/2;
+	    break;
+	case TK_ANCHOR_NW:
+	    x = frameX + borderLeft;
+	    y = frameY + borderTop;
+	    break;
+	case TK_ANCHOR_CENTER:
+	    x = frameX + (borderLeft + frameWidth - width - borderRight)/2;
+	    y = frameY + (borderTop + frameHeight - height - borderBtm)/2;
+	    break;
+	default:
+	    panic("bad frame factor in ArrangePacking");
+    }
+    width -= slavePtr->doubleBw;
+    height -= slavePtr->doubleBw;
+
+    /*
+     * The final step is to set the position, size, and mapped/unmapped
+     * state of the slave.  If the slave is a child of the master, then
+     * do this here.  Otherwise let Tk_MaintainGeometry do the work.
+     */
+
+    if (masterPtr->tkwin == Tk_Parent(slavePtr->tkwin)) {
+	if ((width <= 0) || (height <= 0)) {
+	    Tk_UnmapWindow(slavePtr->tkwin);
+	} else {
+	    if ((x != Tk_X(slavePtr->tkwin))
+		    || (y != Tk_Y(slavePtr->tkwin))
+		    || (width != Tk_Width(slavePtr->tkwin))
+		    || (height != Tk_Height(slavePtr->tkwin))) {
+		Tk_MoveResizeWindow(slavePtr->tkwin, x, y, width, height);
+	    }
+	    if (*masterPtr->abortPtr) {
+		return;
+	    }
+
+	    /*
+	     * Don't map the slave if the master isn't mapped: wait
+	     * until the master gets mapped later.
+	     */
+
+	    if (Tk_IsMapped(masterPtr->tkwin)) {
+		Tk_MapWindow(slavePtr->tkwin);
+	    }
+	}
+    } else {
+	if ((width <= 0) || (height <= 0)) {
+	    Tk_UnmaintainGeometry(slavePtr->tkwin, masterPtr->tkwin);
+	    Tk_UnmapWindow(slavePtr->tkwin);
+	} else {
+	    Tk_MaintainGeometry(slavePtr->tkwin, masterPtr->tkwin,
+		    x, y, width, height);
+	}
+    }
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -1494,6 +1736,9 @@ PackStructureProc(clientData, eventPtr)
 	if (packPtr->flags & REQUESTED_REPACK) {
 	    Tcl_CancelIdleCall(ArrangePacking, (ClientData) packPtr);
 	}
+	if (packPtr->flags & REQUESTED_UPDATE) {
+	    Tcl_CancelIdleCall(PackUpdateSlaves, (ClientData) packPtr);
+	}
 	packPtr->tkwin = NULL;
 	Tcl_EventuallyFree((ClientData) packPtr, DestroyPacker);
     } else if (eventPtr->type == MapNotify) {
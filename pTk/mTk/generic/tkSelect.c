@@ -31,6 +31,13 @@ typedef struct {
 				 * chunk. */
     char buffer[TCL_UTF_MAX];   /* A buffer to hold part of a UTF character
 				 * that is split across chunks.*/
+    Tcl_Obj *valuePtr;          /* If the command returned more than one
+				 * chunk, the value it returned; later
+				 * chunks are sliced from it without
+				 * invoking the command again.  NULL
+				 * otherwise. */
+    int valueOffset;            /* Byte offset within the selection of
+				 * the first byte of valuePtr. */
     LangCallback *command;      /* Command to invoke.  Actual space is
 				 * allocated as large as necessary.  This
 				 * must be the last entry in the structure. */
@@ -238,6 +245,7 @@ Tk_CreateXSelHandler(tkwin, selection, target, proc, clientData, format)
 			CommandInfo *src = (CommandInfo *) cd->clientData;
 			CommandInfo *dst = (CommandInfo *) ckalloc(sizeof(*src));
 			*dst = *src;
+			dst->valuePtr = NULL;
 			cd->clientData = (ClientData) dst;
 			dst->command = LangCopyCallback(src->command);
 		    }
@@ -286,10 +294,23 @@ Tk_Window tkwin;
 #ifdef WIN32
 	    return -1;
 #else
-	    char buffer[TK_SEL_BYTES_AT_ONCE];
-	    int count = (*cd->proc)(cd->clientData, offset, buffer, maxBytes);
-	    buffer[count] = '\0';
-	    return TkSelCvtToX(Xbuffer, buffer, type, tkwin, maxBytes);
+	    char staticSpace[TK_SEL_BYTES_AT_ONCE+1];
+	    char *buffer = staticSpace;
+	    int count;
+	    if (maxBytes > TK_SEL_BYTES_AT_ONCE) {
+		buffer = ckalloc((unsigned) maxBytes + 1);
+	    }
+	    count = (*cd->proc)(cd->clientData, offset, buffer, maxBytes);
+	    if (count < 0) {
+		count = -1;
+	    } else {
+		buffer[count] = '\0';
+		count = TkSelCvtToX(Xbuffer, buffer, type, tkwin, maxBytes);
+	    }
+	    if (buffer != staticSpace) {
+		ckfree(buffer);
+	    }
+	    return count;
 #endif
 	}
     }
@@ -703,9 +724,11 @@ Tk_GetXSelection(interp, tkwin, selection, target, proc, clientData)
     if (infoPtr != NULL) {
 	register TkSelHandler *selPtr;
 	int offset, result, count;
-	long buffer[TK_SEL_WORDS_AT_ONCE+1];
+	long *buffer;
 	TkSelInProgress ip;
 
+	buffer = (long *) ckalloc(TK_SEL_LOCAL_BYTES + sizeof(long));
+
 	for (selPtr = ((TkWindow *) infoPtr->owner)->selHandlerList;
 	     selPtr != NULL; selPtr = selPtr->nextPtr) {
 	    if  ((selPtr->target == target)
@@ -718,11 +741,12 @@ Tk_GetXSelection(interp, tkwin, selection, target, proc, clientData)
 	    int format = 8;
 
 	    count = TkSelDefaultSelection(infoPtr, target, buffer,
-		    TK_SEL_BYTES_AT_ONCE, &type, &format);
-	    if (count > TK_SEL_BYTES_AT_ONCE) {
+		    TK_SEL_LOCAL_BYTES, &type, &format);
+	    if (count > TK_SEL_LOCAL_BYTES) {
 		panic("selection handler returned too many bytes");
 	    }
 	    if (count < 0) {
+		ckfree((char *) buffer);
 		goto cantget;
 	    }
 	    result = (*proc)(clientData, interp, buffer, count, format, type, tkwin);
@@ -742,17 +766,18 @@ Tk_GetXSelection(interp, tkwin, selection, target, proc, clientData)
 	    tsdPtr->pendingPtr = &ip;
 	    while (1) {
 		count = (selPtr->proc)(selPtr->clientData, offset, buffer,
-			TK_SEL_BYTES_AT_ONCE, type, tkwin);
+			TK_SEL_LOCAL_BYTES, type, tkwin);
 		if ((count < 0) || (ip.selPtr == NULL)) {
 		    tsdPtr->pendingPtr = ip.nextPtr;
+		    ckfree((char *) buffer);
 		    goto cantget;
 		}
-		if (count > TK_SEL_BYTES_AT_ONCE) {
+		if (count > TK_SEL_LOCAL_BYTES) {
 		    panic("selection handler returned too many bytes");
 		}
 		((char *) buffer)[count] = '\0';
 		result = (*proc)(clientData, interp, buffer, count, format, type, tkwin);
-		if ((result != TCL_OK) || (count < TK_SEL_BYTES_AT_ONCE)
+		if ((result != TCL_OK) || (count < TK_SEL_LOCAL_BYTES)
 			|| (ip.selPtr == NULL)) {
 		    break;
 		}
@@ -760,6 +785,7 @@ Tk_GetXSelection(interp, tkwin, selection, target, proc, clientData)
 	    }
 	    tsdPtr->pendingPtr = ip.nextPtr;
 	}
+	ckfree((char *) buffer);
 	return result;
     }
 
@@ -808,7 +834,7 @@ Tk_Window tkwin;
 	    format);
 	return TCL_ERROR;
     }
-    portion[numItems] = '\0';
+    ((char *) portion)[numItems] = '\0';
     return (*info->proc)(info->clientData, interp, (char *) portion);
  } else {
 #ifdef WIN32
@@ -859,6 +885,10 @@ ClientData clientData;
   {
    CommandInfo *cmdInfoPtr = (CommandInfo *) cd->clientData;
    cmdInfoPtr->interp = NULL;
+   if (cmdInfoPtr->valuePtr != NULL)
+    {
+     Tcl_DecrRefCount(cmdInfoPtr->valuePtr);
+    }
    LangFreeCallback(cmdInfoPtr->command);
    ckfree((char *) cmdInfoPtr);
   }
@@ -1187,6 +1217,8 @@ Tk_SelectionObjCmd(clientData, interp, objc, objv)
 		cmdInfoPtr->charOffset = 0;
 		cmdInfoPtr->byteOffset = 0;
 		cmdInfoPtr->buffer[0] = '\0';
+		cmdInfoPtr->valuePtr = NULL;
+		cmdInfoPtr->valueOffset = 0;
 		cmdInfoPtr->cmdLength = cmdLength;
 		cmdInfoPtr->command = LangMakeCallback(objs[1]);
 		Tk_CreateSelHandler(tkwin, selection, target, HandleTclCommand,
@@ -1622,6 +1654,35 @@ HandleTclCommand(clientData, offset, buffer, maxBytes)
     Tcl_Preserve(clientData);
     Tcl_Preserve((ClientData) interp);
 
+    /*
+     * If the command handed us the whole selection last time, carry
+     * on slicing it rather than asking for the next piece.
+     */
+
+    if (cmdInfoPtr->valuePtr != NULL) {
+	if (offset == cmdInfoPtr->byteOffset) {
+	    string = Tcl_GetStringFromObj(cmdInfoPtr->valuePtr, &length);
+	    p = string + (offset - cmdInfoPtr->valueOffset);
+	    count = length - (p - string);
+	    if (count > maxBytes) {
+		count = maxBytes;
+	    }
+	    memcpy((VOID *) buffer, (VOID *) p, (size_t) count);
+	    buffer[count] = '\0';
+	    cmdInfoPtr->byteOffset += count;
+	    if (p + count >= string + length) {
+		cmdInfoPtr->charOffset += Tcl_NumUtfChars(string, length);
+		Tcl_DecrRefCount(cmdInfoPtr->valuePtr);
+		cmdInfoPtr->valuePtr = NULL;
+	    }
+	    Tcl_Release(clientData);
+	    Tcl_Release((ClientData) interp);
+	    return count;
+	}
+	Tcl_DecrRefCount(cmdInfoPtr->valuePtr);
+	cmdInfoPtr->valuePtr = NULL;
+    }
+
     /*
      * Compute the proper byte offset in the case where the last chunk
      * split a character.
@@ -1686,6 +1747,18 @@ HandleTclCommand(clientData, offset, buffer, maxBytes)
 	    if (length <= maxBytes) {
 		cmdInfoPtr->charOffset += Tcl_NumUtfChars(string, -1);
 		cmdInfoPtr->buffer[0] = '\0';
+	    } else if (length > 2 * maxBytes) {
+		/*
+		 * The command supplied far more than one chunk (typically
+		 * the whole value), so keep it and serve later chunks from
+		 * it.  charOffset is brought up to date once it has all
+		 * been sent.
+		 */
+
+		Tcl_IncrRefCount(objPtr);
+		cmdInfoPtr->valuePtr = objPtr;
+		cmdInfoPtr->valueOffset = offset + extraBytes;
+		cmdInfoPtr->buffer[0] = '\0';
 	    } else {
 		p = string;
 		string += count;
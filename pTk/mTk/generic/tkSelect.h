@@ -158,6 +158,17 @@ typedef struct TkSelInProgress {
 #define TK_SEL_BYTES_AT_ONCE 4000
 #define TK_SEL_WORDS_AT_ONCE 1001
 
+/*
+ * Large selections are moved in bigger chunks when the display allows
+ * it: the X transfer chunk is derived from the server's maximum request
+ * size (see TkSelChunkSize) but never exceeds TK_SEL_MAX_BYTES_AT_ONCE.
+ * Selections owned by this process are copied in TK_SEL_LOCAL_BYTES
+ * pieces.  Buffers for these sizes are allocated with ckalloc.
+ */
+
+#define TK_SEL_MAX_BYTES_AT_ONCE (1024*1024)
+#define TK_SEL_LOCAL_BYTES	 (64*1024)
+
 /*
  * Declarations for procedures that are used by the selection-related files
  * but shouldn't be used anywhere else in Tk (or by Tk clients):
@@ -168,6 +179,7 @@ extern TkSelInProgress *
 extern void             TkSelSetInProgress _ANSI_ARGS_((
                             TkSelInProgress *pendingPtr));
 
+extern int		TkSelChunkSize _ANSI_ARGS_((Tk_Window tkwin));
 extern void		TkSelClearSelection _ANSI_ARGS_((Tk_Window tkwin,
 			    XEvent *eventPtr));
 extern int		TkSelDefaultSelection _ANSI_ARGS_((
@@ -0,0 +1,1531 @@
+/*
+ * tkTableGeom.c --
+ *
+ *	This file contains code to implement the "table" geometry
+ *	manager used by Tk::Table.  Slaves are put in the cells of a
+ *	two dimensional table: every cell of a column is as wide as
+ *	the widest slave ever put in that column, and every cell of a
+ *	row as tall as the tallest slave ever put in that row.  A number
+ *	of leading rows and columns may be fixed; the remainder scroll
+ *	under them, and only the slaves in cells that can be seen are
+ *	mapped.
+ *
+ * See the file "license.terms" for information on usage and redistribution
+ * of this file, and for a DISCLAIMER OF ALL WARRANTIES.
+ */
+
+#include "tkPort.h"
+#include "tkInt.h"
+
+/*
+ * For each window managed by a table there is a structure of the
+ * following type.  A table's scrollbars are managed as slaves too,
+ * with row and col set to -1.
+ */
+
+typedef struct TableSlave {
+    Tk_Window tkwin;		/* Tk token for the slave window. */
+    struct Table *tablePtr;	/* Table the slave is in. */
+    int row, col;		/* Cell of the table holding the slave. */
+} TableSlave;
+
+/*
+ * For each window which has slaves managed by the table geometry
+ * manager there is a structure of the following type:
+ */
+
+typedef struct Table {
+    Tk_Window tkwin;		/* Tk token for window.  NULL means that
+				 * the window has been deleted, but the
+				 * structure hasn't been freed yet. */
+    Tcl_Interp *interp;		/* Interpreter used to set scrollbars. */
+    int numRows, numCols;	/* Number of rows and columns in which a
+				 * slave has ever been put. */
+    int rowSpace, colSpace;	/* Number of entries allocated in the
+				 * arrays below. */
+    int *height;		/* Height of each row, or -1 for a row which
+				 * has never held a slave.  Only ever grows,
+				 * as slaves ask for more. */
+    int *width;			/* Width of each column, likewise. */
+    TableSlave ***cells;	/* For each row, NULL if height is -1,
+				 * otherwise colSpace slots holding the
+				 * slave in each column or NULL. */
+    int pageRows, pageCols;	/* Number of rows and columns (-rows and
+				 * -columns) the table asks to be given
+				 * room to display. */
+    int fixedRows, fixedCols;	/* Number of leading rows and columns which
+				 * do not scroll. */
+    int top, left;		/* First row and column shown after the
+				 * fixed ones, counting from the first one
+				 * which scrolls. */
+    int bottom, right;		/* One past the last row and column shown
+				 * by the last ArrangeTable, counted the
+				 * same way. */
+    int shownRows[3];		/* Rows shown by the last ArrangeTable:
+				 * rows below shownRows[0] and rows from
+				 * shownRows[1] up to shownRows[2]. */
+    int shownCols[3];		/* Columns shown, likewise. */
+    int scrollbars;		/* Where scrollbars go: SB_* bits below. */
+    TableSlave *xsbPtr;		/* Horizontal scrollbar, or NULL. */
+    TableSlave *ysbPtr;		/* Vertical scrollbar, or NULL. */
+    double xView[2], yView[2];	/* Fractions last given to scrollbars. */
+    int flags;			/* Miscellaneous flags;  see below
+				 * for definitions. */
+} Table;
+
+/*
+ * Flag values for Table structures:
+ *
+ * ARRANGE_PENDING:		1 means a Tcl_DoWhenIdle request has
+ *				been made to run ArrangeTable.
+ * RESIZE_PENDING:		1 means the size of some row, column or
+ *				scrollbar, or the number of rows or columns
+ *				asked for, may have changed, so the table's
+ *				requested size must be recomputed.
+ */
+
+#define ARRANGE_PENDING		1
+#define RESIZE_PENDING		2
+
+/*
+ * Bits for Table scrollbars: which side of the table each scrollbar
+ * is on.  Only one of SB_N and SB_S is used, likewise SB_W and SB_E.
+ */
+
+#define SB_N	1
+#define SB_S	2
+#define SB_E	4
+#define SB_W	8
+
+#define CellSize(n)	((n) < 0 ? 0 : (n))
+
+/*
+ * The following structure is the official type record for the
+ * table geometry manager:
+ */
+
+static void		TableReqProc _ANSI_ARGS_((ClientData clientData,
+			    Tk_Window tkwin));
+static void		TableLostSlaveProc _ANSI_ARGS_((ClientData clientData,
+			    Tk_Window tkwin));
+
+static Tk_GeomMgr tableMgrType = {
+    "table",			/* name */
+    TableReqProc,		/* requestProc */
+    TableLostSlaveProc,		/* lostSlaveProc */
+};
+
+/*
+ * Forward declarations for procedures defined later in this file:
+ */
+
+static void		ArrangeTable _ANSI_ARGS_((ClientData clientData));
+static int		ConfigureTable _ANSI_ARGS_((Tcl_Interp *interp,
+			    Table *tablePtr, int objc, Tcl_Obj *CONST objv[]));
+static int		Constrain _ANSI_ARGS_((int first, int *sizes, int num,
+			    int fixed, int pixels));
+static void		DestroyTable _ANSI_ARGS_((char *memPtr));
+static Table *		FindTable _ANSI_ARGS_((Tk_Window tkwin));
+static TableSlave *	FindSlave _ANSI_ARGS_((Tk_Window tkwin));
+static Table *		GetTable _ANSI_ARGS_((Tk_Window tkwin));
+static void		GrowTable _ANSI_ARGS_((Table *tablePtr, int rows,
+			    int cols));
+static void		HideCells _ANSI_ARGS_((Table *tablePtr, int *rows,
+			    int *cols));
+static int		InShown _ANSI_ARGS_((int *shown, int n));
+static TableSlave *	LinkSlave _ANSI_ARGS_((Table *tablePtr,
+			    Tk_Window tkwin, int row, int col));
+static void		ScheduleArrange _ANSI_ARGS_((Table *tablePtr,
+			    int flags));
+static void		SetScrollbar _ANSI_ARGS_((Table *tablePtr,
+			    TableSlave *sbPtr, double *view, double first,
+			    double last));
+static int		SizeN _ANSI_ARGS_((int n, int *sizes, int num));
+static void		SlaveStructureProc _ANSI_ARGS_((ClientData clientData,
+			    XEvent *eventPtr));
+static void		TableStructureProc _ANSI_ARGS_((ClientData clientData,
+			    XEvent *eventPtr));
+static int		TableView _ANSI_ARGS_((Tcl_Interp *interp,
+			    Table *tablePtr, int vertical, int objc,
+			    Tcl_Obj *CONST objv[]));
+static void		UnlinkSlave _ANSI_ARGS_((TableSlave *slavePtr));
+
+/*
+ *--------------------------------------------------------------
+ *
+ * Tk_TableObjCmd --
+ *
+ *	This procedure is invoked to process the "table" Tcl command,
+ *	which implements the geometry management of Tk::Table.
+ *
+ * Results:
+ *	A standard Tcl result.
+ *
+ * Side effects:
+ *	See the user documentation.
+ *
+ *--------------------------------------------------------------
+ */
+
+int
+Tk_TableObjCmd(clientData, interp, objc, objv)
+    ClientData clientData;	/* Main window associated with
+				 * interpreter. */
+    Tcl_Interp *interp;		/* Current interpreter. */
+    int objc;			/* Number of arguments. */
+    Tcl_Obj *CONST objv[];	/* Argument objects. */
+{
+    Tk_Window tkwin = (Tk_Window) clientData;
+    Tk_Window window;
+    Table *tablePtr;
+    TableSlave *slavePtr;
+    int index, row, col, i;
+    static CONST char *optionStrings[] = {
+	"clear", "configure", "forget", "get", "info", "put", "see",
+	"size", "xview", "yview", (char *) NULL };
+    enum options {
+	TABLE_CLEAR, TABLE_CONFIGURE, TABLE_FORGET, TABLE_GET, TABLE_INFO,
+	TABLE_PUT, TABLE_SEE, TABLE_SIZE, TABLE_XVIEW, TABLE_YVIEW };
+
+    if (objc < 3) {
+	Tcl_WrongNumArgs(interp, 1, objv, "option window ?arg ...?");
+	return TCL_ERROR;
+    }
+    if (Tcl_GetIndexFromObj(interp, objv[1], optionStrings, "option", 0,
+	    &index) != TCL_OK) {
+	return TCL_ERROR;
+    }
+    if (TkGetWindowFromObj(interp, tkwin, objv[2], &window) != TCL_OK) {
+	return TCL_ERROR;
+    }
+
+    switch ((enum options) index) {
+      case TABLE_FORGET:
+	for (i = 2; i < objc; i++) {
+	    if (TkGetWindowFromObj(interp, tkwin, objv[i], &window)
+		    != TCL_OK) {
+		return TCL_ERROR;
+	    }
+	    slavePtr = FindSlave(window);
+	    if (slavePtr != NULL) {
+		Tk_ManageGeometry(window, (Tk_GeomMgr *) NULL,
+			(ClientData) NULL);
+		UnlinkSlave(slavePtr);
+		Tk_UnmapWindow(window);
+	    }
+	}
+	return TCL_OK;
+
+      case TABLE_INFO:
+	if (objc != 3) {
+	    Tcl_WrongNumArgs(interp, 2, objv, "slave");
+	    return TCL_ERROR;
+	}
+	slavePtr = FindSlave(window);
+	if (slavePtr != NULL && slavePtr->row >= 0) {
+	    Tcl_IntResults(interp, 2, 0, slavePtr->row, slavePtr->col);
+	}
+	return TCL_OK;
+
+      case TABLE_CONFIGURE:
+	if (!(objc & 1)) {
+	    Tcl_WrongNumArgs(interp, 2, objv, "window ?-option value ...?");
+	    return TCL_ERROR;
+	}
+	return ConfigureTable(interp, GetTable(window), objc-3, objv+3);
+
+      case TABLE_PUT:
+	if (objc != 6) {
+	    Tcl_WrongNumArgs(interp, 2, objv, "window row column slave");
+	    return TCL_ERROR;
+	}
+	if ((Tcl_GetIntFromObj(interp, objv[3], &row) != TCL_OK)
+		|| (Tcl_GetIntFromObj(interp, objv[4], &col) != TCL_OK)) {
+	    return TCL_ERROR;
+	}
+	if (row < 0 || col < 0) {
+	    Tcl_SetResult(interp, "row and column must be non-negative",
+		    TCL_STATIC);
+	    return TCL_ERROR;
+	}
+	{
+	    Tk_Window slave, ancestor;
+	    TableSlave *oldPtr = NULL;
+
+	    if (TkGetWindowFromObj(interp, tkwin, objv[5], &slave)
+		    != TCL_OK) {
+		return TCL_ERROR;
+	    }
+	    if (Tk_TopWinHierarchy(slave)) {
+		Tcl_AppendResult(interp, "can't put \"", Tk_PathName(slave),
+			"\" in a table: it's a top-level window",
+			(char *) NULL);
+		return TCL_ERROR;
+	    }
+
+	    /*
+	     * As for pack and grid, the table must be the slave's parent
+	     * or one of its descendants in the same top-level.
+	     */
+
+	    for (ancestor = window; ancestor != Tk_Parent(slave);
+		    ancestor = Tk_Parent(ancestor)) {
+		if (ancestor == slave || Tk_TopWinHierarchy(ancestor)) {
+		    Tcl_AppendResult(interp, "can't put ",
+			    Tk_PathName(slave), " inside ",
+			    Tk_PathName(window), (char *) NULL);
+		    return TCL_ERROR;
+		}
+	    }
+	    tablePtr = GetTable(window);
+	    slavePtr = FindSlave(slave);
+	    if (slavePtr != NULL) {
+		if (slavePtr->tablePtr == tablePtr && slavePtr->row == row
+			&& slavePtr->col == col) {
+		    return TCL_OK;
+		}
+		Tk_ManageGeometry(slave, (Tk_GeomMgr *) NULL,
+			(ClientData) NULL);
+		UnlinkSlave(slavePtr);
+		Tk_UnmapWindow(slave);
+	    }
+	    if (row < tablePtr->numRows && col < tablePtr->numCols
+		    && tablePtr->cells[row] != NULL) {
+		oldPtr = tablePtr->cells[row][col];
+	    }
+	    if (oldPtr != NULL) {
+		Tk_Window old = oldPtr->tkwin;
+
+		Tk_ManageGeometry(old, (Tk_GeomMgr *) NULL,
+			(ClientData) NULL);
+		UnlinkSlave(oldPtr);
+		Tk_UnmapWindow(old);
+		Tcl_SetObjResult(interp, LangWidgetObj(interp, old));
+	    }
+	    LinkSlave(tablePtr, slave, row, col);
+	}
+	return TCL_OK;
+    }
+
+    /*
+     * The remaining options all refer to the table window itself.
+     */
+
+    tablePtr = FindTable(window);
+    switch ((enum options) index) {
+      case TABLE_CLEAR:
+	if (tablePtr != NULL) {
+	    Tcl_Obj *resultPtr = Tcl_NewListObj(0, NULL);
+
+	    for (row = 0; row < tablePtr->numRows; row++) {
+		if (tablePtr->cells[row] == NULL) {
+		    continue;
+		}
+		for (col = 0; col < tablePtr->numCols; col++) {
+		    slavePtr = tablePtr->cells[row][col];
+		    if (slavePtr != NULL) {
+			Tk_Window slave = slavePtr->tkwin;
+
+			Tk_ManageGeometry(slave, (Tk_GeomMgr *) NULL,
+				(ClientData) NULL);
+			UnlinkSlave(slavePtr);
+			Tk_UnmapWindow(slave);
+			Tcl_ListObjAppendElement(interp, resultPtr,
+				LangWidgetObj(interp, slave));
+		    }
+		}
+		ckfree((char *) tablePtr->cells[row]);
+		tablePtr->cells[row] = NULL;
+	    }
+	    tablePtr->numRows = tablePtr->numCols = 0;
+	    tablePtr->top = tablePtr->left = 0;
+	    tablePtr->bottom = tablePtr->right = 0;
+	    memset(tablePtr->shownRows, 0, sizeof(tablePtr->shownRows));
+	    memset(tablePtr->shownCols, 0, sizeof(tablePtr->shownCols));
+	    ScheduleArrange(tablePtr, RESIZE_PENDING);
+	    Tcl_SetObjResult(interp, resultPtr);
+	}
+	return TCL_OK;
+
+      case TABLE_GET:
+	if (objc != 5) {
+	    Tcl_WrongNumArgs(interp, 2, objv, "window row column");
+	    return TCL_ERROR;
+	}
+	if ((Tcl_GetIntFromObj(interp, objv[3], &row) != TCL_OK)
+		|| (Tcl_GetIntFromObj(interp, objv[4], &col) != TCL_OK)) {
+	    return TCL_ERROR;
+	}
+	if (tablePtr != NULL && row >= 0 && row < tablePtr->numRows
+		&& col >= 0 && col < tablePtr->numCols
+		&& tablePtr->cells[row] != NULL
+		&& tablePtr->cells[row][col] != NULL) {
+	    Tcl_SetObjResult(interp,
+		    LangWidgetObj(interp, tablePtr->cells[row][col]->tkwin));
+	}
+	return TCL_OK;
+
+      case TABLE_SEE:
+	if (objc != 5) {
+	    Tcl_WrongNumArgs(interp, 2, objv, "window row column");
+	    return TCL_ERROR;
+	}
+	if ((Tcl_GetIntFromObj(interp, objv[3], &row) != TCL_OK)
+		|| (Tcl_GetIntFromObj(interp, objv[4], &col) != TCL_OK)) {
+	    return TCL_ERROR;
+	}
+	i = 1;
+	if (tablePtr != NULL) {
+	    if ((row -= tablePtr->fixedRows) >= 0) {
+		if (row < tablePtr->top) {
+		    tablePtr->top = row;
+		    i = 0;
+		} else if (row >= tablePtr->bottom) {
+		    tablePtr->top += row - tablePtr->bottom + 1;
+		    i = 0;
+		}
+	    }
+	    if ((col -= tablePtr->fixedCols) >= 0) {
+		if (col < tablePtr->left) {
+		    tablePtr->left = col;
+		    i = 0;
+		} else if (col >= tablePtr->right) {
+		    tablePtr->left += col - tablePtr->right + 1;
+		    i = 0;
+		}
+	    }
+	    if (!i) {
+		ScheduleArrange(tablePtr, 0);
+	    }
+	}
+	Tcl_SetObjResult(interp, Tcl_NewIntObj(i));
+	return TCL_OK;
+
+      case TABLE_SIZE:
+	if (tablePtr != NULL) {
+	    Tcl_IntResults(interp, 2, 0, tablePtr->numRows,
+		    tablePtr->numCols);
+	} else {
+	    Tcl_IntResults(interp, 2, 0, 0, 0);
+	}
+	return TCL_OK;
+
+      case TABLE_XVIEW:
+      case TABLE_YVIEW:
+	if (tablePtr == NULL) {
+	    tablePtr = GetTable(window);
+	}
+	return TableView(interp, tablePtr, index == TABLE_YVIEW,
+		objc-1, objv+1);
+
+      default:
+	break;
+    }
+    return TCL_OK;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * ConfigureTable --
+ *
+ *	This implements "table configure": it sets the number of rows
+ *	and columns the table asks room for, the number of fixed rows
+ *	and columns, and the scrollbars and where they go.
+ *
+ * Results:
+ *	A standard Tcl result.
+ *
+ * Side effects:
+ *	The table is rearranged when next idle.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+ConfigureTable(interp, tablePtr, objc, objv)
+    Tcl_Interp *interp;		/* Interpreter for error reporting. */
+    Table *tablePtr;		/* Table to configure. */
+    int objc;			/* Number of option/value arguments. */
+    Tcl_Obj *CONST objv[];	/* Option/value arguments. */
+{
+    static CONST char *optionStrings[] = {
+	"-columns", "-fixedcolumns", "-fixedrows", "-rows", "-scrollbars",
+	"-xscrollbar", "-yscrollbar", (char *) NULL };
+    enum options {
+	CONF_COLUMNS, CONF_FIXEDCOLUMNS, CONF_FIXEDROWS, CONF_ROWS,
+	CONF_SCROLLBARS, CONF_XSCROLLBAR, CONF_YSCROLLBAR };
+    int i, index, value;
+
+    for (i = 0; i < objc; i += 2) {
+	if (Tcl_GetIndexFromObj(interp, objv[i], optionStrings, "option", 0,
+		&index) != TCL_OK) {
+	    return TCL_ERROR;
+	}
+	if (index == CONF_SCROLLBARS) {
+	    char *p = Tcl_GetString(objv[i+1]);
+
+	    value = 0;
+	    if (strchr(p, 'n')) {
+		value |= SB_N;
+	    } else if (strchr(p, 's')) {
+		value |= SB_S;
+	    }
+	    if (strchr(p, 'w')) {
+		value |= SB_W;
+	    } else if (strchr(p, 'e')) {
+		value |= SB_E;
+	    }
+	    tablePtr->scrollbars = value;
+	} else if (index == CONF_XSCROLLBAR || index == CONF_YSCROLLBAR) {
+	    TableSlave **sbPtrPtr = (index == CONF_XSCROLLBAR)
+		    ? &tablePtr->xsbPtr : &tablePtr->ysbPtr;
+	    Tk_Window sb = NULL;
+
+	    if (*Tcl_GetString(objv[i+1]) != '\0' && TkGetWindowFromObj(interp,
+		    tablePtr->tkwin, objv[i+1], &sb) != TCL_OK) {
+		return TCL_ERROR;
+	    }
+	    if (*sbPtrPtr != NULL && (*sbPtrPtr)->tkwin == sb) {
+		continue;
+	    }
+	    if (*sbPtrPtr != NULL) {
+		Tk_Window old = (*sbPtrPtr)->tkwin;
+
+		Tk_ManageGeometry(old, (Tk_GeomMgr *) NULL,
+			(ClientData) NULL);
+		UnlinkSlave(*sbPtrPtr);
+		Tk_UnmapWindow(old);
+	    }
+	    if (sb != NULL) {
+		TableSlave *slavePtr = FindSlave(sb);
+
+		if (slavePtr != NULL) {
+		    Tk_ManageGeometry(sb, (Tk_GeomMgr *) NULL,
+			    (ClientData) NULL);
+		    UnlinkSlave(slavePtr);
+		}
+		*sbPtrPtr = LinkSlave(tablePtr, sb, -1, -1);
+		tablePtr->xView[0] = tablePtr->yView[0] = -1.0;
+	    }
+	} else {
+	    if (Tcl_GetIntFromObj(interp, objv[i+1], &value) != TCL_OK) {
+		return TCL_ERROR;
+	    }
+	    if (value < 0) {
+		value = 0;
+	    }
+	    switch ((enum options) index) {
+	      case CONF_COLUMNS:
+		tablePtr->pageCols = value;
+		break;
+	      case CONF_FIXEDCOLUMNS:
+		tablePtr->fixedCols = value;
+		break;
+	      case CONF_FIXEDROWS:
+		tablePtr->fixedRows = value;
+		break;
+	      case CONF_ROWS:
+		tablePtr->pageRows = value;
+		break;
+	      default:
+		break;
+	    }
+	}
+    }
+    ScheduleArrange(tablePtr, RESIZE_PENDING);
+    return TCL_OK;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TableView --
+ *
+ *	This implements "table xview" and "table yview".  With no
+ *	further arguments the fractions of the scrolling rows or
+ *	columns shown are returned; otherwise the usual "moveto" and
+ *	"scroll" forms are accepted.  Scrolling by a page moves by half
+ *	the number of rows or columns the table asked room for.
+ *
+ * Results:
+ *	A standard Tcl result.
+ *
+ * Side effects:
+ *	The table is rearranged when next idle.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+TableView(interp, tablePtr, vertical, objc, objv)
+    Tcl_Interp *interp;		/* Interpreter for error reporting. */
+    Table *tablePtr;		/* Table to scroll. */
+    int vertical;		/* Non-zero for yview. */
+    int objc;			/* Number of arguments from the view
+				 * subcommand on. */
+    Tcl_Obj *CONST objv[];	/* Arguments. */
+{
+    int *firstPtr = vertical ? &tablePtr->top : &tablePtr->left;
+    int num = vertical ? tablePtr->numRows - tablePtr->fixedRows
+	    : tablePtr->numCols - tablePtr->fixedCols;
+    int page = vertical ? tablePtr->pageRows : tablePtr->pageCols;
+    int count;
+    double fraction;
+
+    if (objc == 2) {
+	int last = vertical ? tablePtr->bottom : tablePtr->right;
+
+	if (num > 0) {
+	    Tcl_DoubleResults(interp, 2, 0, ((double) *firstPtr)/num,
+		    ((double) last)/num);
+	} else {
+	    Tcl_DoubleResults(interp, 2, 0, 0.0, 1.0);
+	}
+	return TCL_OK;
+    }
+    switch (Tk_GetScrollInfoObj(interp, objc, objv, &fraction, &count)) {
+      case TK_SCROLL_ERROR:
+	return TCL_ERROR;
+      case TK_SCROLL_MOVETO:
+	*firstPtr = (int) (num*fraction);
+	break;
+      case TK_SCROLL_PAGES:
+	*firstPtr += count*page/2;
+	break;
+      case TK_SCROLL_UNITS:
+	*firstPtr += count;
+	break;
+    }
+    if (*firstPtr < 0) {
+	*firstPtr = 0;
+    }
+    ScheduleArrange(tablePtr, 0);
+    return TCL_OK;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * SizeN --
+ *
+ *	Finds the largest total size of n consecutive rows or columns,
+ *	which is the room a table needs to show n of them wherever it
+ *	is scrolled to.
+ *
+ * Results:
+ *	The size in pixels.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+SizeN(n, sizes, num)
+    int n;			/* Number of rows or columns to show. */
+    int *sizes;			/* Size of each row or column. */
+    int num;			/* Number of rows or columns. */
+{
+    int i, sum = 0, max;
+
+    for (i = 0; i < num && i < n; i++) {
+	sum += CellSize(sizes[i]);
+    }
+    max = sum;
+    for ( ; i < num; i++) {
+	sum += CellSize(sizes[i]) - CellSize(sizes[i-n]);
+	if (sum > max) {
+	    max = sum;
+	}
+    }
+    return max;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * Constrain --
+ *
+ *	Adjusts the first scrolling row or column to be shown so that,
+ *	if the table has been scrolled near its end, earlier rows or
+ *	columns are brought back into view rather than leaving space
+ *	after the last one.
+ *
+ * Results:
+ *	The first scrolling row or column to show, counted from the
+ *	first one after the fixed ones.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+Constrain(first, sizes, num, fixed, pixels)
+    int first;			/* First scrolling row or column wanted. */
+    int *sizes;			/* Size of each row or column. */
+    int num;			/* Number of rows or columns. */
+    int fixed;			/* Number of them which are fixed. */
+    int pixels;			/* Space available to show them in. */
+{
+    int n = first + fixed;
+    int total = 0;
+    int i;
+
+    if (n > num) {
+	n = num;
+    }
+    if (n < fixed) {
+	n = fixed;
+    }
+    for (i = 0; i < fixed && i < num; i++) {
+	total += CellSize(sizes[i]);
+    }
+    for (i = n; total < pixels && i < num; i++) {
+	total += CellSize(sizes[i]);
+    }
+    while (n > fixed) {
+	n--;
+	total += CellSize(sizes[n]);
+	if (total > pixels) {
+	    n++;
+	    break;
+	}
+    }
+    return n - fixed;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * InShown --
+ *
+ *	Tells whether a row or column is one of those described by
+ *	a Table's shownRows or shownCols.
+ *
+ * Results:
+ *	Non-zero if it is.
+ *
+ * Side effects:
+ *	None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+InShown(shown, n)
+    int *shown;			/* shownRows or shownCols. */
+    int n;			/* Row or column. */
+{
+    return n < shown[0] || (n >= shown[1] && n < shown[2]);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * HideCells --
+ *
+ *	Unmaps the slaves shown by the last ArrangeTable which are not
+ *	in the rows and columns about to be shown.  Only cells which
+ *	were shown are visited, however large the table.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Slaves may be unmapped.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+HideCells(tablePtr, rows, cols)
+    Table *tablePtr;		/* Table being arranged. */
+    int *rows;			/* Rows about to be shown. */
+    int *cols;			/* Columns about to be shown. */
+{
+    int *oldRows = tablePtr->shownRows;
+    int *oldCols = tablePtr->shownCols;
+    int r, c, rowIn;
+
+    for (r = 0; r < oldRows[2] && r < tablePtr->numRows; r++) {
+	if (r == oldRows[0] && r < oldRows[1]) {
+	    r = oldRows[1];
+	    if (r >= oldRows[2] || r >= tablePtr->numRows) {
+		break;
+	    }
+	}
+	if (tablePtr->cells[r] == NULL) {
+	    continue;
+	}
+	rowIn = InShown(rows, r);
+	for (c = 0; c < oldCols[2] && c < tablePtr->numCols; c++) {
+	    TableSlave *slavePtr;
+
+	    if (c == oldCols[0] && c < oldCols[1]) {
+		c = oldCols[1];
+		if (c >= oldCols[2] || c >= tablePtr->numCols) {
+		    break;
+		}
+	    }
+	    slavePtr = tablePtr->cells[r][c];
+	    if (slavePtr != NULL && Tk_IsMapped(slavePtr->tkwin)
+		    && !(rowIn && InShown(cols, c))) {
+		Tk_UnmapWindow(slavePtr->tkwin);
+	    }
+	}
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * ArrangeTable --
+ *
+ *	This procedure is invoked (using the Tcl_DoWhenIdle mechanism)
+ *	to re-layout a table.  Rows and columns are shown in order from
+ *	the top left for as long as they fit: first the fixed ones, then
+ *	the scrolling ones from the current view.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The slaves in cells which can be seen are moved, resized and
+ *	mapped as needed, those no longer seen are unmapped, and the
+ *	scrollbars are placed and set.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+ArrangeTable(clientData)
+    ClientData clientData;	/* Structure describing table. */
+{
+    register Table *tablePtr = (Table *) clientData;
+    Tk_Window tkwin = tablePtr->tkwin;
+    int ladj, radj, tadj, badj;
+    int xsbX = 0, xsbY = 0, xsbHeight = 0;
+    int ysbX = 0, ysbY = 0, ysbWidth = 0;
+    int rows[3], cols[3];
+    int x, y, x0, x1, y0, y1, r, c, n;
+    TableSlave *xsbPtr, *ysbPtr;
+
+    tablePtr->flags &= ~ARRANGE_PENDING;
+    if (tkwin == NULL) {
+	return;
+    }
+
+    ladj = Tk_InternalBorderLeft(tkwin);
+    radj = Tk_InternalBorderRight(tkwin);
+    tadj = Tk_InternalBorderTop(tkwin);
+    badj = Tk_InternalBorderBottom(tkwin);
+    xsbPtr = (tablePtr->scrollbars & (SB_N|SB_S)) ? tablePtr->xsbPtr : NULL;
+    ysbPtr = (tablePtr->scrollbars & (SB_W|SB_E)) ? tablePtr->ysbPtr : NULL;
+    if (xsbPtr != NULL) {
+	xsbHeight = Tk_ReqHeight(xsbPtr->tkwin);
+	if (tablePtr->scrollbars & SB_N) {
+	    xsbY = tadj;
+	    tadj += xsbHeight;
+	} else {
+	    badj += xsbHeight;
+	    xsbY = Tk_Height(tkwin) - badj;
+	}
+    }
+    if (ysbPtr != NULL) {
+	ysbWidth = Tk_ReqWidth(ysbPtr->tkwin);
+	if (tablePtr->scrollbars & SB_W) {
+	    ysbX = ladj;
+	    ladj += ysbWidth;
+	} else {
+	    radj += ysbWidth;
+	    ysbX = Tk_Width(tkwin) - radj;
+	}
+    }
+
+    if (tablePtr->flags & RESIZE_PENDING) {
+	int width, height;
+
+	tablePtr->flags &= ~RESIZE_PENDING;
+	width = SizeN(tablePtr->pageCols, tablePtr->width, tablePtr->numCols)
+		+ ladj + radj;
+	height = SizeN(tablePtr->pageRows, tablePtr->height,
+		tablePtr->numRows) + tadj + badj;
+	if (width != Tk_ReqWidth(tkwin) || height != Tk_ReqHeight(tkwin)) {
+	    Tk_GeometryRequest(tkwin, width, height);
+	}
+    }
+
+    tablePtr->top = Constrain(tablePtr->top, tablePtr->height,
+	    tablePtr->numRows, tablePtr->fixedRows,
+	    Tk_Height(tkwin) - (tadj + badj));
+    tablePtr->left = Constrain(tablePtr->left, tablePtr->width,
+	    tablePtr->numCols, tablePtr->fixedCols,
+	    Tk_Width(tkwin) - (ladj + radj));
+
+    /*
+     * Work out which columns fit, then which rows.
+     */
+
+    x = ladj;
+    for (c = 0; c < tablePtr->fixedCols && c < tablePtr->numCols; c++) {
+	if (x + tablePtr->width[c] > Tk_Width(tkwin) - radj) {
+	    break;
+	}
+	x += tablePtr->width[c];
+    }
+    cols[0] = c;
+    cols[1] = cols[2] = tablePtr->fixedCols + tablePtr->left;
+    x0 = x;
+    if (c == tablePtr->fixedCols) {
+	for (c = cols[1]; c < tablePtr->numCols; c++) {
+	    if (x + tablePtr->width[c] > Tk_Width(tkwin) - radj) {
+		break;
+	    }
+	    x += tablePtr->width[c];
+	}
+	cols[2] = c;
+    }
+    x1 = x;
+    tablePtr->right = cols[2] - tablePtr->fixedCols;
+
+    y = tadj;
+    for (r = 0; r < tablePtr->fixedRows && r < tablePtr->numRows; r++) {
+	if (y + CellSize(tablePtr->height[r]) > Tk_Height(tkwin) - badj) {
+	    break;
+	}
+	y += CellSize(tablePtr->height[r]);
+    }
+    rows[0] = r;
+    rows[1] = rows[2] = tablePtr->fixedRows + tablePtr->top;
+    y0 = y;
+    if (r == tablePtr->fixedRows) {
+	for (r = rows[1]; r < tablePtr->numRows; r++) {
+	    if (y + CellSize(tablePtr->height[r]) > Tk_Height(tkwin) - badj) {
+		break;
+	    }
+	    y += CellSize(tablePtr->height[r]);
+	}
+	rows[2] = r;
+    }
+    y1 = y;
+    tablePtr->bottom = rows[2] - tablePtr->fixedRows;
+
+    HideCells(tablePtr, rows, cols);
+    memcpy(tablePtr->shownRows, rows, sizeof(rows));
+    memcpy(tablePtr->shownCols, cols, sizeof(cols));
+
+    /*
+     * Place and map the slaves in the cells shown.
+     */
+
+    y = tadj;
+    for (r = 0; r < rows[2]; r++) {
+	int height;
+
+	if (r == rows[0] && r < rows[1]) {
+	    r = rows[1];
+	    if (r >= rows[2]) {
+		break;
+	    }
+	}
+	height = CellSize(tablePtr->height[r]);
+	if (tablePtr->cells[r] != NULL) {
+	    x = ladj;
+	    for (c = 0; c < cols[2]; c++) {
+		TableSlave *slavePtr;
+		int width;
+
+		if (c == cols[0] && c < cols[1]) {
+		    c = cols[1];
+		    if (c >= cols[2]) {
+			break;
+		    }
+		}
+		width = tablePtr->width[c];
+		slavePtr = tablePtr->cells[r][c];
+		if (slavePtr != NULL) {
+		    Tk_Window slave = slavePtr->tkwin;
+
+		    if (x != Tk_X(slave) || y != Tk_Y(slave)
+			    || width != Tk_Width(slave)
+			    || height != Tk_Height(slave)) {
+			Tk_MoveResizeWindow(slave, x, y, width, height);
+		    }
+		    if (!Tk_IsMapped(slave)) {
+			Tk_MapWindow(slave);
+		    }
+		}
+		x += width;
+	    }
+	}
+	y += height;
+    }
+
+    /*
+     * Place the scrollbars alongside the scrolling rows and columns
+     * shown.  Setting them runs scripts, so it is done last and the
+     * table may be gone afterwards.
+     */
+
+    Tcl_Preserve((ClientData) tablePtr);
+    if (tablePtr->xsbPtr != NULL && xsbPtr == NULL) {
+	Tk_UnmapWindow(tablePtr->xsbPtr->tkwin);
+    }
+    if (tablePtr->ysbPtr != NULL && ysbPtr == NULL) {
+	Tk_UnmapWindow(tablePtr->ysbPtr->tkwin);
+    }
+    n = tablePtr->numCols - tablePtr->fixedCols;
+    if (xsbPtr != NULL) {
+	if (tablePtr->numRows > 0 && n > 0 && x0 < x1) {
+	    Tk_MoveResizeWindow(xsbPtr->tkwin, x0, xsbY, x1 - x0, xsbHeight);
+	    Tk_MapWindow(xsbPtr->tkwin);
+	    SetScrollbar(tablePtr, xsbPtr, tablePtr->xView,
+		    ((double) tablePtr->left)/n, ((double) tablePtr->right)/n);
+	} else {
+	    Tk_UnmapWindow(xsbPtr->tkwin);
+	}
+    }
+    n = tablePtr->numRows - tablePtr->fixedRows;
+    if (ysbPtr != NULL && tablePtr->tkwin != NULL
+	    && ysbPtr == tablePtr->ysbPtr) {
+	if (n > 0 && y0 < y1) {
+	    Tk_MoveResizeWindow(ysbPtr->tkwin, ysbX, y0, ysbWidth, y1 - y0);
+	    Tk_MapWindow(ysbPtr->tkwin);
+	    SetScrollbar(tablePtr, ysbPtr, tablePtr->yView,
+		    ((double) tablePtr->top)/n, ((double) tablePtr->bottom)/n);
+	} else {
+	    Tk_UnmapWindow(ysbPtr->tkwin);
+	}
+    }
+    Tcl_Release((ClientData) tablePtr);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * SetScrollbar --
+ *
+ *	Invokes a scrollbar's "set" method, unless it was last given
+ *	the same fractions.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Whatever the method does; errors are reported in the background.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+SetScrollbar(tablePtr, sbPtr, view, first, last)
+    Table *tablePtr;		/* Table the scrollbar belongs to. */
+    TableSlave *sbPtr;		/* The scrollbar. */
+    double *view;		/* Fractions it was last given. */
+    double first, last;		/* Fractions to give it. */
+{
+    Tcl_Interp *interp = tablePtr->interp;
+    Tcl_Obj *obj;
+
+    if (view[0] == first && view[1] == last) {
+	return;
+    }
+    view[0] = first;
+    view[1] = last;
+    obj = LangWidgetObj(interp, sbPtr->tkwin);
+    Tcl_Preserve((ClientData) interp);
+    if (LangMethodCall(interp, obj, "set", 0, 2, " %g %g", first, last)
+	    != TCL_OK) {
+	Tcl_AddErrorInfo(interp,
+		"\n    (scrollbar set executed by table)");
+	Tcl_BackgroundError(interp);
+    }
+    Tcl_Release((ClientData) interp);
+    Tcl_DecrRefCount(obj);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * ScheduleArrange --
+ *
+ *	Arranges for a table to be laid out when next idle.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Flags are set in the table, and an idle handler may be created.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+ScheduleArrange(tablePtr, flags)
+    Table *tablePtr;		/* Table to arrange. */
+    int flags;			/* RESIZE_PENDING if the requested size
+				 * must be recomputed too. */
+{
+    tablePtr->flags |= flags;
+    if (!(tablePtr->flags & ARRANGE_PENDING) && tablePtr->tkwin != NULL) {
+	tablePtr->flags |= ARRANGE_PENDING;
+	Tcl_DoWhenIdle(ArrangeTable, (ClientData) tablePtr);
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * GetTable, FindTable, FindSlave --
+ *
+ *	These procedures look up the Table structure for a window,
+ *	GetTable creating one if needed, and the TableSlave structure
+ *	for a managed window.
+ *
+ * Results:
+ *	The structure, or NULL if none exists.
+ *
+ * Side effects:
+ *	GetTable may create a Table, and arranges to clean it up when
+ *	the window is deleted.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static Table *
+FindTable(tkwin)
+    Tk_Window tkwin;		/* Token for window. */
+{
+    TkDisplay *dispPtr = ((TkWindow *) tkwin)->dispPtr;
+    Tcl_HashEntry *hPtr;
+
+    if (!dispPtr->tableInit) {
+	return NULL;
+    }
+    hPtr = Tcl_FindHashEntry(&dispPtr->tableMasterTable, (char *) tkwin);
+    return (hPtr != NULL) ? (Table *) Tcl_GetHashValue(hPtr) : NULL;
+}
+
+static TableSlave *
+FindSlave(tkwin)
+    Tk_Window tkwin;		/* Token for window. */
+{
+    TkDisplay *dispPtr = ((TkWindow *) tkwin)->dispPtr;
+    Tcl_HashEntry *hPtr;
+
+    if (!dispPtr->tableInit) {
+	return NULL;
+    }
+    hPtr = Tcl_FindHashEntry(&dispPtr->tableSlaveTable, (char *) tkwin);
+    return (hPtr != NULL) ? (TableSlave *) Tcl_GetHashValue(hPtr) : NULL;
+}
+
+static Table *
+GetTable(tkwin)
+    Tk_Window tkwin;		/* Token for window. */
+{
+    TkDisplay *dispPtr = ((TkWindow *) tkwin)->dispPtr;
+    Tcl_HashEntry *hPtr;
+    Table *tablePtr;
+    int new;
+
+    if (!dispPtr->tableInit) {
+	dispPtr->tableInit = 1;
+	Tcl_InitHashTable(&dispPtr->tableMasterTable, TCL_ONE_WORD_KEYS);
+	Tcl_InitHashTable(&dispPtr->tableSlaveTable, TCL_ONE_WORD_KEYS);
+    }
+    hPtr = Tcl_CreateHashEntry(&dispPtr->tableMasterTable, (char *) tkwin,
+	    &new);
+    if (!new) {
+	return (Table *) Tcl_GetHashValue(hPtr);
+    }
+    tablePtr = (Table *) ckalloc(sizeof(Table));
+    memset(tablePtr, 0, sizeof(Table));
+    tablePtr->tkwin = tkwin;
+    tablePtr->interp = ((TkWindow *) tkwin)->mainPtr->interp;
+    tablePtr->pageRows = tablePtr->pageCols = 10;
+    tablePtr->xView[0] = tablePtr->yView[0] = -1.0;
+    Tcl_SetHashValue(hPtr, tablePtr);
+    Tk_CreateEventHandler(tkwin, StructureNotifyMask,
+	    TableStructureProc, (ClientData) tablePtr);
+    return tablePtr;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * GrowTable --
+ *
+ *	Makes sure a table has at least the given number of rows and
+ *	columns, and that each of its arrays has room for them.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Memory may be reallocated.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+GrowTable(tablePtr, rows, cols)
+    Table *tablePtr;		/* Table to grow. */
+    int rows, cols;		/* Number of rows and columns needed. */
+{
+    int i;
+
+    if (rows > tablePtr->rowSpace) {
+	int space = tablePtr->rowSpace ? tablePtr->rowSpace : 16;
+
+	while (space < rows) {
+	    space *= 2;
+	}
+	tablePtr->height = (int *) ckrealloc((char *) tablePtr->height,
+		space * sizeof(int));
+	tablePtr->cells = (TableSlave ***) ckrealloc(
+		(char *) tablePtr->cells, space * sizeof(TableSlave **));
+	tablePtr->rowSpace = space;
+    }
+    for (i = tablePtr->numRows; i < rows; i++) {
+	tablePtr->height[i] = -1;
+	tablePtr->cells[i] = NULL;
+    }
+    if (rows > tablePtr->numRows) {
+	tablePtr->numRows = rows;
+    }
+
+    if (cols > tablePtr->colSpace) {
+	int space = tablePtr->colSpace ? tablePtr->colSpace : 16;
+
+	while (space < cols) {
+	    space *= 2;
+	}
+	tablePtr->width = (int *) ckrealloc((char *) tablePtr->width,
+		space * sizeof(int));
+	for (i = 0; i < tablePtr->numRows; i++) {
+	    if (tablePtr->cells[i] != NULL) {
+		tablePtr->cells[i] = (TableSlave **) ckrealloc(
+			(char *) tablePtr->cells[i],
+			space * sizeof(TableSlave *));
+		memset(tablePtr->cells[i] + tablePtr->colSpace, 0,
+			(space - tablePtr->colSpace) * sizeof(TableSlave *));
+	    }
+	}
+	tablePtr->colSpace = space;
+    }
+    for (i = tablePtr->numCols; i < cols; i++) {
+	tablePtr->width[i] = 0;
+    }
+    if (cols > tablePtr->numCols) {
+	tablePtr->numCols = cols;
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * LinkSlave --
+ *
+ *	Puts a window in a cell of a table, or makes it one of the
+ *	table's scrollbars if row and col are -1, and takes over its
+ *	geometry management.  The cell must be empty.
+ *
+ * Results:
+ *	The new TableSlave structure.
+ *
+ * Side effects:
+ *	The row and column may grow to fit the slave, and the table is
+ *	rearranged when next idle.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static TableSlave *
+LinkSlave(tablePtr, tkwin, row, col)
+    Table *tablePtr;		/* Table to put window in. */
+    Tk_Window tkwin;		/* Window to put in it. */
+    int row, col;		/* Cell for the window. */
+{
+    TkDisplay *dispPtr = ((TkWindow *) tkwin)->dispPtr;
+    TableSlave *slavePtr = (TableSlave *) ckalloc(sizeof(TableSlave));
+    int new;
+
+    slavePtr->tkwin = tkwin;
+    slavePtr->tablePtr = tablePtr;
+    slavePtr->row = row;
+    slavePtr->col = col;
+    Tcl_SetHashValue(Tcl_CreateHashEntry(&dispPtr->tableSlaveTable,
+	    (char *) tkwin, &new), slavePtr);
+    Tk_CreateEventHandler(tkwin, StructureNotifyMask,
+	    SlaveStructureProc, (ClientData) slavePtr);
+    Tk_ManageGeometry(tkwin, &tableMgrType, (ClientData) slavePtr);
+    if (row >= 0) {
+	GrowTable(tablePtr, row+1, col+1);
+	if (tablePtr->cells[row] == NULL) {
+	    tablePtr->cells[row] = (TableSlave **) ckalloc(
+		    tablePtr->colSpace * sizeof(TableSlave *));
+	    memset(tablePtr->cells[row], 0,
+		    tablePtr->colSpace * sizeof(TableSlave *));
+	    tablePtr->height[row] = 0;
+	}
+	tablePtr->cells[row][col] = slavePtr;
+	if (Tk_ReqWidth(tkwin) > tablePtr->width[col]) {
+	    tablePtr->width[col] = Tk_ReqWidth(tkwin);
+	}
+	if (Tk_ReqHeight(tkwin) > tablePtr->height[row]) {
+	    tablePtr->height[row] = Tk_ReqHeight(tkwin);
+	}
+    }
+    ScheduleArrange(tablePtr, RESIZE_PENDING);
+    return slavePtr;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * UnlinkSlave --
+ *
+ *	Removes a slave from its table and frees its structure.  The
+ *	caller deals with the slave's geometry management and mapping.
+ *	Row and column sizes are left as they were.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The table is rearranged when next idle.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+UnlinkSlave(slavePtr)
+    TableSlave *slavePtr;	/* Slave to remove. */
+{
+    Table *tablePtr = slavePtr->tablePtr;
+    TkDisplay *dispPtr = ((TkWindow *) slavePtr->tkwin)->dispPtr;
+    Tcl_HashEntry *hPtr;
+
+    if (slavePtr->row >= 0) {
+	tablePtr->cells[slavePtr->row][slavePtr->col] = NULL;
+    } else if (tablePtr->xsbPtr == slavePtr) {
+	tablePtr->xsbPtr = NULL;
+    } else if (tablePtr->ysbPtr == slavePtr) {
+	tablePtr->ysbPtr = NULL;
+    }
+    hPtr = Tcl_FindHashEntry(&dispPtr->tableSlaveTable,
+	    (char *) slavePtr->tkwin);
+    if (hPtr != NULL) {
+	Tcl_DeleteHashEntry(hPtr);
+    }
+    Tk_DeleteEventHandler(slavePtr->tkwin, StructureNotifyMask,
+	    SlaveStructureProc, (ClientData) slavePtr);
+    ScheduleArrange(tablePtr, slavePtr->row < 0 ? RESIZE_PENDING : 0);
+    ckfree((char *) slavePtr);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TableReqProc --
+ *
+ *	This procedure is invoked by Tk_GeometryRequest for windows
+ *	managed by a table.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	If the slave wants more room than its row or column has, the
+ *	row or column grows and the table is rearranged when next idle.
+ *	Otherwise nothing happens: the slave keeps the size of its cell.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+TableReqProc(clientData, tkwin)
+    ClientData clientData;	/* TableSlave structure for window. */
+    Tk_Window tkwin;		/* Other Tk-related information
+				 * about the window. */
+{
+    TableSlave *slavePtr = (TableSlave *) clientData;
+    Table *tablePtr = slavePtr->tablePtr;
+    int grown = 0;
+
+    if (slavePtr->row < 0) {
+	ScheduleArrange(tablePtr, RESIZE_PENDING);
+	return;
+    }
+    if (Tk_ReqWidth(tkwin) > tablePtr->width[slavePtr->col]) {
+	tablePtr->width[slavePtr->col] = Tk_ReqWidth(tkwin);
+	grown = 1;
+    }
+    if (Tk_ReqHeight(tkwin) > tablePtr->height[slavePtr->row]) {
+	tablePtr->height[slavePtr->row] = Tk_ReqHeight(tkwin);
+	grown = 1;
+    }
+    if (grown) {
+	ScheduleArrange(tablePtr, RESIZE_PENDING);
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TableLostSlaveProc --
+ *
+ *	This procedure is invoked by Tk whenever some other geometry
+ *	claims control over a slave that used to be managed by a table.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The slave is removed from its table and unmapped.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+TableLostSlaveProc(clientData, tkwin)
+    ClientData clientData;	/* TableSlave structure for slave window that
+				 * was stolen away. */
+    Tk_Window tkwin;		/* Tk's handle for the slave window. */
+{
+    UnlinkSlave((TableSlave *) clientData);
+    Tk_UnmapWindow(tkwin);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * SlaveStructureProc --
+ *
+ *	This procedure is invoked by the Tk event dispatcher in response
+ *	to StructureNotify events on a slave.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	If the slave was deleted it is removed from its table.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+SlaveStructureProc(clientData, eventPtr)
+    ClientData clientData;	/* TableSlave structure for window. */
+    XEvent *eventPtr;		/* Describes what just happened. */
+{
+    if (eventPtr->type == DestroyNotify) {
+	UnlinkSlave((TableSlave *) clientData);
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TableStructureProc --
+ *
+ *	This procedure is invoked by the Tk event dispatcher in response
+ *	to StructureNotify events on a table window.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	If the window was resized or mapped the table is rearranged.  If
+ *	it was deleted its slaves are released and the table freed.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+TableStructureProc(clientData, eventPtr)
+    ClientData clientData;	/* Table structure for window. */
+    XEvent *eventPtr;		/* Describes what just happened. */
+{
+    Table *tablePtr = (Table *) clientData;
+
+    if (eventPtr->type == ConfigureNotify || eventPtr->type == MapNotify) {
+	ScheduleArrange(tablePtr, 0);
+    } else if (eventPtr->type == DestroyNotify) {
+	TkDisplay *dispPtr = ((TkWindow *) tablePtr->tkwin)->dispPtr;
+	int r, c;
+
+	for (r = 0; r < tablePtr->numRows; r++) {
+	    if (tablePtr->cells[r] == NULL) {
+		continue;
+	    }
+	    for (c = 0; c < tablePtr->numCols; c++) {
+		TableSlave *slavePtr = tablePtr->cells[r][c];
+
+		if (slavePtr != NULL) {
+		    Tk_ManageGeometry(slavePtr->tkwin, (Tk_GeomMgr *) NULL,
+			    (ClientData) NULL);
+		    UnlinkSlave(slavePtr);
+		}
+	    }
+	    ckfree((char *) tablePtr->cells[r]);
+	}
+	if (tablePtr->xsbPtr != NULL) {
+	    Tk_ManageGeometry(tablePtr->xsbPtr->tkwin, (Tk_GeomMgr *) NULL,
+		    (ClientData) NULL);
+	    UnlinkSlave(tablePtr->xsbPtr);
+	}
+	if (tablePtr->ysbPtr != NULL) {
+	    Tk_ManageGeometry(tablePtr->ysbPtr->tkwin, (Tk_GeomMgr *) NULL,
+		    (ClientData) NULL);
+	    UnlinkSlave(tablePtr->ysbPtr);
+	}
+	Tcl_DeleteHashEntry(Tcl_FindHashEntry(&dispPtr->tableMasterTable,
+		(char *) tablePtr->tkwin));
+	if (tablePtr->flags & ARRANGE_PENDING) {
+	    Tcl_CancelIdleCall(ArrangeTable, (ClientData) tablePtr);
+	}
+	tablePtr->tkwin = NULL;
+	Tcl_EventuallyFree((ClientData) tablePtr, DestroyTable);
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * DestroyTable --
+ *
+ *	This procedure is invoked by Tcl_EventuallyFree or Tcl_Release
+ *	to clean up the internal structure of a table at a safe time
+ *	(when no-one is using it anymore).
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Everything associated with the table is freed up.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+DestroyTable(memPtr)
+    char *memPtr;		/* Info about table window that is now
+				 * dead. */
+{
+    Table *tablePtr = (Table *) memPtr;
+
+    if (tablePtr->height != NULL) {
+	ckfree((char *) tablePtr->height);
+	ckfree((char *) tablePtr->cells);
+    }
+    if (tablePtr->width != NULL) {
+	ckfree((char *) tablePtr->width);
+    }
+    ckfree((char *) tablePtr);
+}
@@ -840,6 +840,7 @@ TextWidgetCmd(clientData, interp, argc, argv)
 	int i, j, numTags;
 	Tcl_Obj * *tagNames;
 	TkTextTag **oldTagArrayPtr;
+	ClientData mark;
 
 	if (argc < 4) {
 	    Tcl_AppendResult(interp, "wrong # args: should be \"",
@@ -859,13 +860,12 @@ TextWidgetCmd(clientData, interp, argc, argv)
 		if (argc > (j+1)) {
 		    TkTextIndexForwBytes(&index1, (int) strlen(argv[j]),
 			    &index2);
-		    oldTagArrayPtr = TkBTreeGetTags(&index1, &numTags);
-		    if (oldTagArrayPtr != NULL) {
-			for (i = 0; i < numTags; i++) {
-			    TkBTreeTag(&index1, &index2, oldTagArrayPtr[i], 0);
-			}
-			ckfree((char *) oldTagArrayPtr);
+		    mark = Tcl_ArenaMark();
+		    oldTagArrayPtr = TkBTreeGetTagsInArena(&index1, &numTags);
+		    for (i = 0; i < numTags; i++) {
+			TkBTreeTag(&index1, &index2, oldTagArrayPtr[i], 0);
 		    }
+		    Tcl_ArenaRelease(mark);
 		    if (Tcl_ListObjGetElements(interp, objv[j+1], &numTags, &tagNames)
 			    != TCL_OK) {
 			result = TCL_ERROR;
@@ -1596,6 +1596,7 @@ DeleteChars(textPtr, index1String, index2String, indexPtr1, indexPtr2)
 	TkTextTag **arrayPtr;
 	int arraySize, i;
 	TkTextIndex oldIndex2;
+	ClientData mark;
 
 	oldIndex2 = index2;
 	TkTextIndexBackChars(&oldIndex2, 1, &index2);
@@ -1604,13 +1605,12 @@ DeleteChars(textPtr, index1String, index2String, indexPtr1, indexPtr2)
 	    TkTextIndexBackChars(&index1, 1, &index1);
 	    line1--;
 	}
-	arrayPtr = TkBTreeGetTags(&index2, &arraySize);
-	if (arrayPtr != NULL) {
-	    for (i = 0; i < arraySize; i++) {
-		TkBTreeTag(&index2, &oldIndex2, arrayPtr[i], 0);
-	    }
-	    ckfree((char *) arrayPtr);
+	mark = Tcl_ArenaMark();
+	arrayPtr = TkBTreeGetTagsInArena(&index2, &arraySize);
+	for (i = 0; i < arraySize; i++) {
+	    TkBTreeTag(&index2, &oldIndex2, arrayPtr[i], 0);
 	}
+	Tcl_ArenaRelease(mark);
     }
 
     /*
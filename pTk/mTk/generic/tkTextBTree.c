@@ -78,7 +78,7 @@ typedef struct BTree {
 
 /*
  * The structure below is used to pass information between
- * TkBTreeGetTags and IncCount:
+ * GetTags and IncCount:
  */
 
 typedef struct TagInfo {
@@ -88,9 +88,9 @@ typedef struct TagInfo {
     int arraySize;			/* Number of entries allocated for
 					 * tags and counts. */
     TkTextTag **tagPtrs;		/* Array of tags seen so far.
-					 * Malloc-ed. */
+					 * From the arena. */
     int *counts;			/* Toggle count (so far) for each
-					 * entry in tags.  Malloc-ed. */
+					 * entry in tags.  From the arena. */
 } TagInfo;
 
 /*
@@ -131,6 +131,8 @@ static TkTextSegment *	FindTagEnd _ANSI_ARGS_((TkTextBTree tree,
 			    TkTextTag *tagPtr, TkTextIndex *indexPtr));
 static void		IncCount _ANSI_ARGS_((TkTextTag *tagPtr, int inc,
 			    TagInfo *tagInfoPtr));
+static TkTextTag **	GetTags _ANSI_ARGS_((TkTextIndex *indexPtr,
+			    int *numTagsPtr));
 static void		Rebalance _ANSI_ARGS_((BTree *treePtr, Node *nodePtr));
 static void		RecomputeNodeCounts _ANSI_ARGS_((Node *nodePtr));
 static TkTextSegment *	SplitSeg _ANSI_ARGS_((TkTextIndex *indexPtr));
@@ -1161,11 +1163,13 @@ TkBTreeTag(index1Ptr, index2Ptr, tagPtr, add)
 					 * range of characters;  zero means
 					 * remove the tag from the range. */
 {
-    TkTextSegment *segPtr, *prevPtr;
+    TkTextSegment *segPtr, *prevPtr, *nextPtr;
     TkTextSearch search;
-    TkTextLine *cleanupLinePtr;
+    TkTextLine *linePtr;
+    TkTextSegment **togglePtrs;		/* Transitions inside the range. */
+    TkTextLine **lineStarts;		/* Line holding each of them. */
+    int numToggles, toggleSpace, i;
     int oldState;
-    int changed;
 
     /*
      * See whether the tag is present at the start of the range.  If
@@ -1194,55 +1198,72 @@ TkBTreeTag(index1Ptr, index2Ptr, tagPtr, add)
      * Scan the range of characters and delete any internal tag
      * transitions.  Keep track of what the old state was at the end
      * of the range, and add a toggle there if it's needed.
+     *
+     * The transitions are all found first and only then deleted: this
+     * way one search covers the whole range.  (Deleting as we go would
+     * mean starting the search again after each deletion, because
+     * ChangeNodeToggleCount may move the tag's root node around and
+     * leave the search in the void.)
      */
 
+    numToggles = 0;
+    toggleSpace = 0;
+    togglePtrs = NULL;
+    lineStarts = NULL;
     TkBTreeStartSearch(index1Ptr, index2Ptr, tagPtr, &search);
-    cleanupLinePtr = index1Ptr->linePtr;
     while (TkBTreeNextTag(&search)) {
 	oldState ^= 1;
-	segPtr = search.segPtr;
-	prevPtr = search.curIndex.linePtr->segPtr;
-	if (prevPtr == segPtr) {
-	    search.curIndex.linePtr->segPtr = segPtr->nextPtr;
-	} else {
-	    while (prevPtr->nextPtr != segPtr) {
-		prevPtr = prevPtr->nextPtr;
-	    }
-	    prevPtr->nextPtr = segPtr->nextPtr;
-	}
-	if (segPtr->body.toggle.inNodeCounts) {
-	    ChangeNodeToggleCount(search.curIndex.linePtr->parentPtr,
-		    segPtr->body.toggle.tagPtr, -1);
-	    segPtr->body.toggle.inNodeCounts = 0;
-	    changed = 1;
-	} else {
-	    changed = 0;
-	}
-	ckfree((char *) segPtr);
+	if (togglePtrs == NULL) {
+	    toggleSpace = 16;
+	    togglePtrs = (TkTextSegment **) ckalloc((unsigned)
+		    toggleSpace * sizeof(TkTextSegment *));
+	    lineStarts = (TkTextLine **) ckalloc((unsigned)
+		    toggleSpace * sizeof(TkTextLine *));
+	} else if (numToggles == toggleSpace) {
+	    toggleSpace *= 2;
+	    togglePtrs = (TkTextSegment **) ckrealloc((char *) togglePtrs,
+		    (unsigned) toggleSpace * sizeof(TkTextSegment *));
+	    lineStarts = (TkTextLine **) ckrealloc((char *) lineStarts,
+		    (unsigned) toggleSpace * sizeof(TkTextLine *));
+	}
+	togglePtrs[numToggles] = search.segPtr;
+	lineStarts[numToggles] = search.curIndex.linePtr;
+	numToggles++;
+    }
 
-	/*
-	 * The code below is a bit tricky.  After deleting a toggle
-	 * we eventually have to call CleanupLine, in order to allow
-	 * character segments to be merged together.  To do this, we
-	 * remember in cleanupLinePtr a line that needs to be
-	 * cleaned up, but we don't clean it up until we've moved
-	 * on to a different line.  That way the cleanup process
-	 * won't goof up segPtr.
-	 */
+    /*
+     * Now unlink the transitions, one pass over the segments of each
+     * line that has any.  A line's transitions were found in the order
+     * they appear in it.
+     */
 
-	if (cleanupLinePtr != search.curIndex.linePtr) {
-	    CleanupLine(cleanupLinePtr);
-	    cleanupLinePtr = search.curIndex.linePtr;
+    for (i = 0; i < numToggles; ) {
+	linePtr = lineStarts[i];
+	prevPtr = NULL;
+	for (segPtr = linePtr->segPtr; (segPtr != NULL) && (i < numToggles)
+		&& (lineStarts[i] == linePtr); segPtr = nextPtr) {
+	    nextPtr = segPtr->nextPtr;
+	    if (segPtr != togglePtrs[i]) {
+		prevPtr = segPtr;
+		continue;
+	    }
+	    if (prevPtr == NULL) {
+		linePtr->segPtr = nextPtr;
+	    } else {
+		prevPtr->nextPtr = nextPtr;
+	    }
+	    if (segPtr->body.toggle.inNodeCounts) {
+		ChangeNodeToggleCount(linePtr->parentPtr,
+			segPtr->body.toggle.tagPtr, -1);
+	    }
+	    ckfree((char *) segPtr);
+	    i++;
 	}
-	/*
-	 * Quick hack.  ChangeNodeToggleCount may move the tag's root
-	 * location around and leave the search in the void.  This resets
-	 * the search.
-	 */
-	if (changed) {
-	    TkBTreeStartSearch(index1Ptr, index2Ptr, tagPtr, &search);
+	if ((i < numToggles) && (lineStarts[i] == linePtr)) {
+	    panic("TkBTreeTag couldn't find a toggle to delete");
 	}
     }
+
     if ((add != 0) ^ oldState) {
 	segPtr = (TkTextSegment *) ckalloc(TSEG_SIZE);
 	segPtr->typePtr = (add) ? &tkTextToggleOffType : &tkTextToggleOnType;
@@ -1260,14 +1281,25 @@ TkBTreeTag(index1Ptr, index2Ptr, tagPtr, add)
     }
 
     /*
-     * Cleanup cleanupLinePtr and the last line of the range, if
-     * these are different.
+     * Cleanup the lines that transitions were deleted from, and the
+     * first and last lines of the range.
      */
 
-    CleanupLine(cleanupLinePtr);
-    if (cleanupLinePtr != index2Ptr->linePtr) {
+    CleanupLine(index1Ptr->linePtr);
+    for (i = 0; i < numToggles; i++) {
+	if ((lineStarts[i] != index1Ptr->linePtr)
+		&& (lineStarts[i] != index2Ptr->linePtr)
+		&& ((i == 0) || (lineStarts[i] != lineStarts[i-1]))) {
+	    CleanupLine(lineStarts[i]);
+	}
+    }
+    if (index2Ptr->linePtr != index1Ptr->linePtr) {
 	CleanupLine(index2Ptr->linePtr);
     }
+    if (togglePtrs != NULL) {
+	ckfree((char *) togglePtrs);
+	ckfree((char *) lineStarts);
+    }
 
     if (tkBTreeDebug) {
 	TkBTreeCheck(index1Ptr->tree);
@@ -2332,13 +2364,78 @@ TkBTreeCharTagged(indexPtr, tagPtr)
  *----------------------------------------------------------------------
  */
 
-	/* ARGSUSED */
 TkTextTag **
 TkBTreeGetTags(indexPtr, numTagsPtr)
     TkTextIndex *indexPtr;	/* Indicates a particular position in
 				 * the B-tree. */
     int *numTagsPtr;		/* Store number of tags found at this
 				 * location. */
+{
+    ClientData mark = Tcl_ArenaMark();
+    TkTextTag **tagPtrs = GetTags(indexPtr, numTagsPtr);
+    TkTextTag **result = NULL;
+
+    if (tagPtrs != NULL) {
+	result = (TkTextTag **) ckalloc((unsigned)
+		(*numTagsPtr * sizeof(TkTextTag *)));
+	memcpy((VOID *) result, (VOID *) tagPtrs,
+		*numTagsPtr * sizeof(TkTextTag *));
+    }
+    Tcl_ArenaRelease(mark);
+    return result;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkBTreeGetTagsInArena --
+ *
+ *	As TkBTreeGetTags, for callers that need the tags only briefly.
+ *
+ * Results:
+ *	As for TkBTreeGetTags, except that the array is taken from the
+ *	arena: the caller takes a mark with Tcl_ArenaMark beforehand and
+ *	gives the array back by releasing it, rather than freeing it.
+ *
+ * Side effects:
+ *	Memory is taken from the arena.
+ *
+ *----------------------------------------------------------------------
+ */
+
+TkTextTag **
+TkBTreeGetTagsInArena(indexPtr, numTagsPtr)
+    TkTextIndex *indexPtr;	/* Indicates a particular position in
+				 * the B-tree. */
+    int *numTagsPtr;		/* Store number of tags found at this
+				 * location. */
+{
+    return GetTags(indexPtr, numTagsPtr);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * GetTags --
+ *
+ *	The work of TkBTreeGetTags and TkBTreeGetTagsInArena.
+ *
+ * Results:
+ *	As for TkBTreeGetTagsInArena.
+ *
+ * Side effects:
+ *	Memory is taken from the arena.
+ *
+ *----------------------------------------------------------------------
+ */
+
+	/* ARGSUSED */
+static TkTextTag **
+GetTags(indexPtr, numTagsPtr)
+    TkTextIndex *indexPtr;	/* Indicates a particular position in
+				 * the B-tree. */
+    int *numTagsPtr;		/* Store number of tags found at this
+				 * location. */
 {
     register Node *nodePtr;
     register TkTextLine *siblingLinePtr;
@@ -2349,9 +2446,9 @@ TkBTreeGetTags(indexPtr, numTagsPtr)
 
     tagInfo.numTags = 0;
     tagInfo.arraySize = NUM_TAG_INFOS;
-    tagInfo.tagPtrs = (TkTextTag **) ckalloc((unsigned)
+    tagInfo.tagPtrs = (TkTextTag **) Tcl_ArenaAlloc((unsigned)
 	    NUM_TAG_INFOS*sizeof(TkTextTag *));
-    tagInfo.counts = (int *) ckalloc((unsigned)
+    tagInfo.counts = (int *) Tcl_ArenaAlloc((unsigned)
 	    NUM_TAG_INFOS*sizeof(int));
 
     /*
@@ -2420,9 +2517,7 @@ TkBTreeGetTags(indexPtr, numTagsPtr)
 	}
     }
     *numTagsPtr = dst;
-    ckfree((char *) tagInfo.counts);
     if (dst == 0) {
-	ckfree((char *) tagInfo.tagPtrs);
 	return NULL;
     }
     return tagInfo.tagPtrs;
@@ -2575,7 +2670,7 @@ TkTextIsElided(textPtr, indexPtr)
  *
  * IncCount --
  *
- *	This is a utility procedure used by TkBTreeGetTags.  It
+ *	This is a utility procedure used by GetTags.  It
  *	increments the count for a particular tag, adding a new
  *	entry for that tag if there wasn't one previously.
  *
@@ -2618,16 +2713,14 @@ IncCount(tagPtr, inc, tagInfoPtr)
 	int *newCounts, newSize;
 
 	newSize = 2*tagInfoPtr->arraySize;
-	newTags = (TkTextTag **) ckalloc((unsigned)
+	newTags = (TkTextTag **) Tcl_ArenaAlloc((unsigned)
 		(newSize*sizeof(TkTextTag *)));
 	memcpy((VOID *) newTags, (VOID *) tagInfoPtr->tagPtrs,
 		tagInfoPtr->arraySize * sizeof(TkTextTag *));
-	ckfree((char *) tagInfoPtr->tagPtrs);
 	tagInfoPtr->tagPtrs = newTags;
-	newCounts = (int *) ckalloc((unsigned) (newSize*sizeof(int)));
+	newCounts = (int *) Tcl_ArenaAlloc((unsigned) (newSize*sizeof(int)));
 	memcpy((VOID *) newCounts, (VOID *) tagInfoPtr->counts,
 		tagInfoPtr->arraySize * sizeof(int));
-	ckfree((char *) tagInfoPtr->counts);
 	tagInfoPtr->counts = newCounts;
 	tagInfoPtr->arraySize = newSize;
     }
@@ -147,6 +147,20 @@ typedef struct DLine {
 				 * (b) can have gaps where DLine's have been
 				 * deleted because they're out of date. */
     int flags;			/* Various flag bits:  see below for values. */
+
+    /*
+     * The fields below are only used while the line is held in the
+     * widget's cache of off-screen display lines (see CacheDLines).
+     * While cached, nextPtr links the lines cached for the same text
+     * line.
+     */
+
+    int epoch;			/* Value of the widget's layoutEpoch when
+				 * the line was cached. */
+    int width;			/* Width of the layout area when the line
+				 * was cached. */
+    struct DLine *newerPtr;	/* Next more recently cached line, or NULL. */
+    struct DLine *olderPtr;	/* Next less recently cached line, or NULL. */
 } DLine;
 
 /*
@@ -187,6 +201,10 @@ typedef struct DLine {
 typedef struct TextDInfo {
     Tcl_HashTable styleTable;	/* Hash table that maps from StyleValues
 				 * to TextStyles for this widget. */
+    Tcl_HashTable tagSetTable;	/* Maps from a set of tags (see GetStyle)
+				 * to the TextStyle for characters with
+				 * exactly those tags.  Each entry holds a
+				 * reference to its style. */
     DLine *dLinePtr;		/* First in list of all display lines for
 				 * this widget, in order from top to bottom. */
     GC copyGC;			/* Graphics context for copying from off-
@@ -264,8 +282,31 @@ typedef struct TextDInfo {
 				 * could dump core. */
     int flags;			/* Various flag values:  see below for
 				 * definitions. */
+
+    /*
+     * Display lines that have scrolled off the screen are kept for a
+     * while so that scrolling back to them doesn't need to lay them
+     * out again:
+     */
+
+    Tcl_HashTable dLineCache;	/* Maps from TkTextLine to the list of
+				 * cached DLines for that line. */
+    DLine *newestPtr;		/* Most recently cached DLine, or NULL. */
+    DLine *oldestPtr;		/* Least recently cached DLine, or NULL;
+				 * the first to be discarded. */
+    int numCached;		/* Number of DLines in the cache. */
+    int layoutEpoch;		/* Incremented whenever a tag's
+				 * configuration changes in a way that may
+				 * affect any line: cached DLines from an
+				 * older epoch are never reused. */
 } TextDInfo;
 
+/*
+ * Maximum number of off-screen display lines kept per text widget.
+ */
+
+#define DLINE_CACHE_SIZE	512
+
 /*
  * In TkTextDispChunk structures for character segments, the clientData
  * field points to one of the following structures:
@@ -344,6 +385,10 @@ static void		ElideBboxProc _ANSI_ARGS_((TkTextDispChunk *chunkPtr,
 static int		ElideMeasureProc _ANSI_ARGS_((TkTextDispChunk *chunkPtr,
 			    int x));
 
+static void		CacheDLines _ANSI_ARGS_((TkText *textPtr,
+			    DLine *firstPtr, DLine *lastPtr, int unlink));
+static void		DiscardCachedDLine _ANSI_ARGS_((TkText *textPtr,
+			    DLine *dlPtr));
 static void		DisplayDLine _ANSI_ARGS_((TkText *textPtr,
 			    DLine *dlPtr, DLine *prevPtr, Pixmap pixmap));
 static void		DisplayLineBackground _ANSI_ARGS_((TkText *textPtr,
@@ -355,14 +400,19 @@ static void		FreeDLines _ANSI_ARGS_((TkText *textPtr,
 			    DLine *firstPtr, DLine *lastPtr, int unlink));
 static void		FreeStyle _ANSI_ARGS_((TkText *textPtr,
 			    TextStyle *stylePtr));
+static void		FreeTagSets _ANSI_ARGS_((TkText *textPtr));
 static TextStyle *	GetStyle _ANSI_ARGS_((TkText *textPtr,
-			    TkTextIndex *indexPtr));
+			    TkTextTag **tagPtrs, int numTags));
 static void		GetXView _ANSI_ARGS_((Tcl_Interp *interp,
 			    TkText *textPtr, int report));
 static void		GetYView _ANSI_ARGS_((Tcl_Interp *interp,
 			    TkText *textPtr, int report));
+static DLine *		GetDLine _ANSI_ARGS_((TkText *textPtr,
+			    TkTextIndex *indexPtr));
 static DLine *		LayoutDLine _ANSI_ARGS_((TkText *textPtr,
 			    TkTextIndex *indexPtr));
+static TextStyle *	MakeStyle _ANSI_ARGS_((TkText *textPtr,
+			    TkTextTag **tagPtrs, int numTags));
 static int		MeasureChars _ANSI_ARGS_((Tk_Font tkfont,
 			    CONST char *source, int maxBytes, int startX,
 			    int maxX, int tabOrigin, int *nextXPtr));
@@ -371,6 +421,15 @@ static void		MeasureUp _ANSI_ARGS_((TkText *textPtr,
 			    TkTextIndex *dstPtr));
 static int		NextTabStop _ANSI_ARGS_((Tk_Font tkfont, int x,
 			    int tabOrigin));
+static void		PurgeDLineCache _ANSI_ARGS_((TkText *textPtr,
+			    TkTextIndex *index1Ptr, TkTextIndex *index2Ptr));
+static TkTextTag **	ToggleTag _ANSI_ARGS_((TkTextSegment *segPtr,
+			    TkTextTag **tagPtrs, int *numTagsPtr,
+			    int *tagSpacePtr));
+static void		UncacheDLine _ANSI_ARGS_((TextDInfo *dInfoPtr,
+			    DLine *dlPtr));
+static void		UnlinkDLines _ANSI_ARGS_((TkText *textPtr,
+			    DLine *firstPtr, DLine *lastPtr));
 static void		UpdateDisplayInfo _ANSI_ARGS_((TkText *textPtr));
 static void		ScrollByLines _ANSI_ARGS_((TkText *textPtr,
 			    int offset));
@@ -408,6 +467,7 @@ TkTextCreateDInfo(textPtr)
 
     dInfoPtr = (TextDInfo *) ckalloc(sizeof(TextDInfo));
     Tcl_InitHashTable(&dInfoPtr->styleTable, sizeof(StyleValues)/sizeof(int));
+    Tcl_InitHashTable(&dInfoPtr->tagSetTable, TCL_STRING_KEYS);
     dInfoPtr->dLinePtr = NULL;
     dInfoPtr->copyGC = None;
     gcValues.graphics_exposures = True;
@@ -427,6 +487,11 @@ TkTextCreateDInfo(textPtr)
     dInfoPtr->scanMarkY = 0;
     dInfoPtr->dLinesInvalidated = 0;
     dInfoPtr->flags = DINFO_OUT_OF_DATE;
+    Tcl_InitHashTable(&dInfoPtr->dLineCache, TCL_ONE_WORD_KEYS);
+    dInfoPtr->newestPtr = NULL;
+    dInfoPtr->oldestPtr = NULL;
+    dInfoPtr->numCached = 0;
+    dInfoPtr->layoutEpoch = 0;
     textPtr->dInfoPtr = dInfoPtr;
 }
 
@@ -461,6 +526,10 @@ TkTextFreeDInfo(textPtr)
      */
 
     FreeDLines(textPtr, dInfoPtr->dLinePtr, (DLine *) NULL, 1);
+    PurgeDLineCache(textPtr, (TkTextIndex *) NULL, (TkTextIndex *) NULL);
+    Tcl_DeleteHashTable(&dInfoPtr->dLineCache);
+    FreeTagSets(textPtr);
+    Tcl_DeleteHashTable(&dInfoPtr->tagSetTable);
     Tcl_DeleteHashTable(&dInfoPtr->styleTable);
     if (dInfoPtr->copyGC != None) {
 	Tk_FreeGC(textPtr->display, dInfoPtr->copyGC);
@@ -477,12 +546,115 @@ TkTextFreeDInfo(textPtr)
  *
  * GetStyle --
  *
+ *	This procedure returns all the information needed to display
+ *	characters that have a given set of tags.  Each distinct set of
+ *	tags is looked up in dInfoPtr->tagSetTable, so the style only
+ *	has to be worked out the first time a set is seen.
+ *
+ * Results:
+ *	The return value is a pointer to a TextStyle structure for the
+ *	tags.  The caller must eventually release it with FreeStyle.
+ *
+ * Side effects:
+ *	The array of tags is sorted.  New entries may be created in the
+ *	tag set and style tables for the widget.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static TextStyle *
+GetStyle(textPtr, tagPtrs, numTags)
+    TkText *textPtr;		/* Overall information about text widget. */
+    TkTextTag **tagPtrs;	/* Tags on the characters to display. */
+    int numTags;		/* Number of entries in tagPtrs. */
+{
+    TextStyle *stylePtr;
+    Tcl_HashEntry *hPtr;
+    TkTextTag *tagPtr;
+    char buf[200], *key, *p;
+    unsigned long bits;
+    int new, i, j;
+
+    /*
+     * The key is the hexadecimal addresses of the tags in ascending
+     * order, so that the same set always gives the same key.  There
+     * are rarely more than a few tags, so an insertion sort will do.
+     */
+
+    for (i = 1; i < numTags; i++) {
+	tagPtr = tagPtrs[i];
+	for (j = i; (j > 0) && (tagPtrs[j-1] > tagPtr); j--) {
+	    tagPtrs[j] = tagPtrs[j-1];
+	}
+	tagPtrs[j] = tagPtr;
+    }
+    i = numTags * (2*sizeof(TkTextTag *) + 1) + 1;
+    key = (i <= sizeof(buf)) ? buf : ckalloc((unsigned) i);
+    for (p = key, i = 0; i < numTags; i++) {
+	for (bits = (unsigned long) tagPtrs[i]; bits != 0; bits >>= 4) {
+	    *p++ = "0123456789abcdef"[bits & 0xf];
+	}
+	*p++ = ' ';
+    }
+    *p = 0;
+
+    hPtr = Tcl_CreateHashEntry(&textPtr->dInfoPtr->tagSetTable, key, &new);
+    if (key != buf) {
+	ckfree(key);
+    }
+    if (!new) {
+	stylePtr = (TextStyle *) Tcl_GetHashValue(hPtr);
+	stylePtr->refCount++;
+	return stylePtr;
+    }
+    stylePtr = MakeStyle(textPtr, tagPtrs, numTags);
+    stylePtr->refCount++;
+    Tcl_SetHashValue(hPtr, (ClientData) stylePtr);
+    return stylePtr;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * FreeTagSets --
+ *
+ *	Empty dInfoPtr->tagSetTable, because the styles it maps to are
+ *	out of date (for example a tag has been reconfigured).
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The table's references to styles are released.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+FreeTagSets(textPtr)
+    TkText *textPtr;		/* Overall information about text widget. */
+{
+    Tcl_HashEntry *hPtr;
+    Tcl_HashSearch search;
+
+    for (hPtr = Tcl_FirstHashEntry(&textPtr->dInfoPtr->tagSetTable, &search);
+	    hPtr != NULL; hPtr = Tcl_NextHashEntry(&search)) {
+	FreeStyle(textPtr, (TextStyle *) Tcl_GetHashValue(hPtr));
+	Tcl_DeleteHashEntry(hPtr);
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * MakeStyle --
+ *
  *	This procedure creates all the information needed to display
- *	text at a particular location.
+ *	characters with a given set of tags.
  *
  * Results:
  *	The return value is a pointer to a TextStyle structure that
- *	corresponds to *sValuePtr.
+ *	corresponds to the tags.
  *
  * Side effects:
  *	A new entry may be created in the style table for the widget.
@@ -491,17 +663,16 @@ TkTextFreeDInfo(textPtr)
  */
 
 static TextStyle *
-GetStyle(textPtr, indexPtr)
+MakeStyle(textPtr, tagPtrs, numTags)
     TkText *textPtr;		/* Overall information about text widget. */
-    TkTextIndex *indexPtr;	/* The character in the text for which
-				 * display information is wanted. */
+    TkTextTag **tagPtrs;	/* Tags on the characters to display. */
+    int numTags;		/* Number of entries in tagPtrs. */
 {
-    TkTextTag **tagPtrs;
     register TkTextTag *tagPtr;
     StyleValues styleValues;
     TextStyle *stylePtr;
     Tcl_HashEntry *hPtr;
-    int numTags, new, i;
+    int new, i;
     XGCValues gcValues;
     unsigned long mask;
 
@@ -518,13 +689,11 @@ GetStyle(textPtr, indexPtr)
     int overstrikePrio, tabPrio, wrapPrio;
 
     /*
-     * Find out what tags are present for the character, then compute
-     * a StyleValues structure corresponding to those tags (scan
+     * Compute a StyleValues structure corresponding to the tags (scan
      * through all of the tags, saving information for the highest-
      * priority tag).
      */
 
-    tagPtrs = TkBTreeGetTags(indexPtr, &numTags);
     borderPrio = borderWidthPrio = reliefPrio = bgStipplePrio = -1;
     fgPrio = fontPrio = fgStipplePrio = -1;
     underlinePrio = elidePrio = justifyPrio = offsetPrio = -1;
@@ -657,9 +826,6 @@ GetStyle(textPtr, indexPtr)
 	    wrapPrio = tagPtr->priority;
 	}
     }
-    if (tagPtrs != NULL) {
-	ckfree((char *) tagPtrs);
-    }
 
     /*
      * Use an existing style if there's one around that matches.
@@ -815,6 +981,12 @@ LayoutDLine(textPtr, indexPtr)
 					 * of the line. */
     int byteOffset, ascent, descent, code, elide, elidesize;
     StyleValues *sValuePtr;
+    TkTextTag **tagPtrs;		/* Tags at curIndex, kept up to date
+					 * as toggles are passed, so that the
+					 * B-tree is searched only once. */
+    int numTags, tagSpace;		/* Number of tags in tagPtrs and its
+					 * size; -1 tags means not known yet. */
+    ClientData mark;
 
     /*
      * Create and initialize a new DLine structure.
@@ -884,6 +1056,10 @@ LayoutDLine(textPtr, indexPtr)
     wrapMode = TEXT_WRAPMODE_CHAR;
     tabSize = 0;
     lastCharChunkPtr = NULL;
+    mark = Tcl_ArenaMark();
+    tagPtrs = NULL;
+    numTags = -1;
+    tagSpace = 0;
 
     /*
      * Find the first segment to consider for the line.  Can't call
@@ -920,6 +1096,9 @@ LayoutDLine(textPtr, indexPtr)
 		    elide = (segPtr->typePtr == &tkTextToggleOffType)
 			^ segPtr->body.toggle.tagPtr->elide;
 		}
+		if (numTags >= 0) {
+		    tagPtrs = ToggleTag(segPtr, tagPtrs, &numTags, &tagSpace);
+		}
 	    }
 
 	    byteOffset = 0;
@@ -931,6 +1110,11 @@ LayoutDLine(textPtr, indexPtr)
 	}
 
 	if (segPtr->typePtr->layoutProc == NULL) {
+	    if ((numTags >= 0)
+		    && ((segPtr->typePtr == &tkTextToggleOffType)
+		    || (segPtr->typePtr == &tkTextToggleOnType))) {
+		tagPtrs = ToggleTag(segPtr, tagPtrs, &numTags, &tagSpace);
+	    }
 	    segPtr = segPtr->nextPtr;
 	    byteOffset = 0;
 	    continue;
@@ -939,7 +1123,19 @@ LayoutDLine(textPtr, indexPtr)
 	    chunkPtr = (TkTextDispChunk *) ckalloc(sizeof(TkTextDispChunk));
 	    chunkPtr->nextPtr = NULL;
 	}
-	chunkPtr->stylePtr = GetStyle(textPtr, &curIndex);
+	if (numTags < 0) {
+	    TkTextTag **foundPtrs;
+
+	    foundPtrs = TkBTreeGetTagsInArena(&curIndex, &numTags);
+	    tagSpace = numTags + 8;
+	    tagPtrs = (TkTextTag **) Tcl_ArenaAlloc((unsigned)
+		    tagSpace * sizeof(TkTextTag *));
+	    if (numTags > 0) {
+		memcpy((VOID *) tagPtrs, (VOID *) foundPtrs,
+			numTags * sizeof(TkTextTag *));
+	    }
+	}
+	chunkPtr->stylePtr = GetStyle(textPtr, tagPtrs, numTags);
 	elide = chunkPtr->stylePtr->sValuePtr->elide;
 
 	/*
@@ -1076,6 +1272,7 @@ LayoutDLine(textPtr, indexPtr)
 
 	chunkPtr = NULL;
     }
+    Tcl_ArenaRelease(mark);
     if (noCharsYet) {
 	panic("LayoutDLine couldn't place any characters on a line");
     }
@@ -1203,6 +1400,58 @@ LayoutDLine(textPtr, indexPtr)
     return dlPtr;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * ToggleTag --
+ *
+ *	Called by LayoutDLine as it passes a tag toggle segment, to keep
+ *	its array of the tags at the current position up to date.
+ *
+ * Results:
+ *	The return value is the array of tags, which may have moved.
+ *
+ * Side effects:
+ *	The toggled tag is added to or removed from the array, which
+ *	grows in the arena if it is full.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static TkTextTag **
+ToggleTag(segPtr, tagPtrs, numTagsPtr, tagSpacePtr)
+    TkTextSegment *segPtr;	/* Toggle segment being passed. */
+    TkTextTag **tagPtrs;	/* Tags in effect before segPtr. */
+    int *numTagsPtr;		/* Number of tags in tagPtrs; updated. */
+    int *tagSpacePtr;		/* Size of tagPtrs; updated. */
+{
+    TkTextTag *tagPtr = segPtr->body.toggle.tagPtr;
+    TkTextTag **newPtrs;
+    int i;
+
+    for (i = 0; i < *numTagsPtr; i++) {
+	if (tagPtrs[i] == tagPtr) {
+	    if (segPtr->typePtr == &tkTextToggleOffType) {
+		tagPtrs[i] = tagPtrs[--(*numTagsPtr)];
+	    }
+	    return tagPtrs;
+	}
+    }
+    if (segPtr->typePtr != &tkTextToggleOnType) {
+	return tagPtrs;
+    }
+    if (*numTagsPtr == *tagSpacePtr) {
+	*tagSpacePtr *= 2;
+	newPtrs = (TkTextTag **) Tcl_ArenaAlloc((unsigned)
+		*tagSpacePtr * sizeof(TkTextTag *));
+	memcpy((VOID *) newPtrs, (VOID *) tagPtrs,
+		*numTagsPtr * sizeof(TkTextTag *));
+	tagPtrs = newPtrs;
+    }
+    tagPtrs[(*numTagsPtr)++] = tagPtr;
+    return tagPtrs;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -1247,13 +1496,14 @@ UpdateDisplayInfo(textPtr)
     dInfoPtr->flags &= ~DINFO_OUT_OF_DATE;
 
     /*
-     * Delete any DLines that are now above the top of the window.
+     * Delete any DLines that are now above the top of the window.  They
+     * are still correct, so keep them in case the window scrolls back.
      */
 
     index = textPtr->topIndex;
     dlPtr = FindDLine(dInfoPtr->dLinePtr, &index);
     if ((dlPtr != NULL) && (dlPtr != dInfoPtr->dLinePtr)) {
-	FreeDLines(textPtr, dInfoPtr->dLinePtr, dlPtr, 1);
+	CacheDLines(textPtr, dInfoPtr->dLinePtr, dlPtr, 1);
     }
 
     /*
@@ -1320,7 +1570,7 @@ UpdateDisplayInfo(textPtr)
 			TCL_GLOBAL_ONLY|TCL_APPEND_VALUE|TCL_LIST_ELEMENT);
 #endif
 	    }
-	    newPtr = LayoutDLine(textPtr, &index);
+	    newPtr = GetDLine(textPtr, &index);
 	    if (prevPtr == NULL) {
 		dInfoPtr->dLinePtr = newPtr;
 	    } else {
@@ -1412,10 +1662,11 @@ UpdateDisplayInfo(textPtr)
     }
 
     /*
-     * Delete any DLine structures that don't fit on the screen.
+     * Delete any DLine structures that don't fit on the screen (again,
+     * keeping them in the cache).
      */
 
-    FreeDLines(textPtr, dlPtr, (DLine *) NULL, 1);
+    CacheDLines(textPtr, dlPtr, (DLine *) NULL, 1);
 
     /*
      *--------------------------------------------------------------
@@ -1450,7 +1701,7 @@ UpdateDisplayInfo(textPtr)
 	    lowestPtr = NULL;
 
 	    do {
-		dlPtr = LayoutDLine(textPtr, &index);
+		dlPtr = GetDLine(textPtr, &index);
 		dlPtr->nextPtr = lowestPtr;
 		lowestPtr = dlPtr;
 		if (dlPtr->length == 0 && dlPtr->height == 0) { bytesToCount--; break; }	/* elide */
@@ -1484,7 +1735,7 @@ UpdateDisplayInfo(textPtr)
 #endif
 		}
 	    }
-	    FreeDLines(textPtr, lowestPtr, (DLine *) NULL, 0);
+	    CacheDLines(textPtr, lowestPtr, (DLine *) NULL, 0);
 	    bytesToCount = INT_MAX;
 	}
 
@@ -1623,16 +1874,7 @@ FreeDLines(textPtr, firstPtr, lastPtr, unlink)
     register DLine *nextDLinePtr;
 
     if (unlink) {
-	if (textPtr->dInfoPtr->dLinePtr == firstPtr) {
-	    textPtr->dInfoPtr->dLinePtr = lastPtr;
-	} else {
-	    register DLine *prevPtr;
-	    for (prevPtr = textPtr->dInfoPtr->dLinePtr;
-		    prevPtr->nextPtr != firstPtr; prevPtr = prevPtr->nextPtr) {
-		/* Empty loop body. */
-	    }
-	    prevPtr->nextPtr = lastPtr;
-	}
+	UnlinkDLines(textPtr, firstPtr, lastPtr);
     }
     while (firstPtr != lastPtr) {
 	nextDLinePtr = firstPtr->nextPtr;
@@ -1651,6 +1893,350 @@ FreeDLines(textPtr, firstPtr, lastPtr, unlink)
     textPtr->dInfoPtr->dLinesInvalidated = 1;
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * UnlinkDLines --
+ *
+ *	Remove a range of DLine structures from the list rooted at
+ *	textPtr->dInfoPtr->dLinePtr, without freeing them.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The display line list no longer includes firstPtr up to (but
+ *	not including) lastPtr.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+UnlinkDLines(textPtr, firstPtr, lastPtr)
+    TkText *textPtr;			/* Information about overall text
+					 * widget. */
+    DLine *firstPtr;			/* First DLine to unlink. */
+    DLine *lastPtr;			/* DLine just after last one to
+					 * unlink (NULL means everything
+					 * starting with firstPtr). */
+{
+    if (textPtr->dInfoPtr->dLinePtr == firstPtr) {
+	textPtr->dInfoPtr->dLinePtr = lastPtr;
+    } else {
+	register DLine *prevPtr;
+	for (prevPtr = textPtr->dInfoPtr->dLinePtr;
+		prevPtr->nextPtr != firstPtr; prevPtr = prevPtr->nextPtr) {
+	    /* Empty loop body. */
+	}
+	prevPtr->nextPtr = lastPtr;
+    }
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * CacheDLines --
+ *
+ *	This procedure is called in place of FreeDLines for display
+ *	lines that are still correct but are no longer needed on the
+ *	screen, typically because they have scrolled out of the window.
+ *	Lines made up only of characters (and elided text) are kept in
+ *	a per-widget cache, keyed by their text line and byte index, so
+ *	that GetDLine can hand them back instead of laying them out
+ *	again.  Lines with embedded windows, images or the insertion
+ *	cursor are freed as usual.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The lines are moved into the cache or freed.  If the cache holds
+ *	more than DLINE_CACHE_SIZE lines, the least recently cached ones
+ *	are freed.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+CacheDLines(textPtr, firstPtr, lastPtr, unlink)
+    TkText *textPtr;			/* Information about overall text
+					 * widget. */
+    register DLine *firstPtr;		/* Pointer to first DLine to cache. */
+    DLine *lastPtr;			/* Pointer to DLine just after last
+					 * one to cache (NULL means everything
+					 * starting with firstPtr). */
+    int unlink;				/* 1 means DLines are currently linked
+					 * into the list rooted at
+					 * textPtr->dInfoPtr->dLinePtr and
+					 * they have to be unlinked. */
+{
+    TextDInfo *dInfoPtr = textPtr->dInfoPtr;
+    register TkTextDispChunk *chunkPtr;
+    DLine *nextDLinePtr, *cachedPtr;
+    Tcl_HashEntry *hPtr;
+    int new;
+
+    if (unlink) {
+	UnlinkDLines(textPtr, firstPtr, lastPtr);
+    }
+    while (firstPtr != lastPtr) {
+	nextDLinePtr = firstPtr->nextPtr;
+	for (chunkPtr = firstPtr->chunkPtr; chunkPtr != NULL;
+		chunkPtr = chunkPtr->nextPtr) {
+	    if ((chunkPtr->undisplayProc != NULL)
+		    && (chunkPtr->undisplayProc != CharUndisplayProc)) {
+		break;
+	    }
+	}
+	if (chunkPtr != NULL) {
+	    FreeDLines(textPtr, firstPtr, nextDLinePtr, 0);
+	    firstPtr = nextDLinePtr;
+	    continue;
+	}
+
+	/*
+	 * Replace any older copy of the same line, then link the line
+	 * in at the head of both its text line's list and the LRU list.
+	 */
+
+	hPtr = Tcl_CreateHashEntry(&dInfoPtr->dLineCache,
+		(char *) firstPtr->index.linePtr, &new);
+	if (!new) {
+	    for (cachedPtr = (DLine *) Tcl_GetHashValue(hPtr);
+		    cachedPtr != NULL; cachedPtr = cachedPtr->nextPtr) {
+		if (cachedPtr->index.byteIndex == firstPtr->index.byteIndex) {
+		    DiscardCachedDLine(textPtr, cachedPtr);
+		    break;
+		}
+	    }
+	    hPtr = Tcl_CreateHashEntry(&dInfoPtr->dLineCache,
+		    (char *) firstPtr->index.linePtr, &new);
+	}
+	firstPtr->nextPtr = new ? NULL : (DLine *) Tcl_GetHashValue(hPtr);
+	Tcl_SetHashValue(hPtr, (ClientData) firstPtr);
+	firstPtr->epoch = dInfoPtr->layoutEpoch;
+	firstPtr->width = dInfoPtr->maxX - dInfoPtr->x;
+	firstPtr->newerPtr = NULL;
+	firstPtr->olderPtr = dInfoPtr->newestPtr;
+	if (dInfoPtr->newestPtr != NULL) {
+	    dInfoPtr->newestPtr->newerPtr = firstPtr;
+	} else {
+	    dInfoPtr->oldestPtr = firstPtr;
+	}
+	dInfoPtr->newestPtr = firstPtr;
+	dInfoPtr->numCached++;
+	firstPtr = nextDLinePtr;
+    }
+    while (dInfoPtr->numCached > DLINE_CACHE_SIZE) {
+	DiscardCachedDLine(textPtr, dInfoPtr->oldestPtr);
+    }
+    dInfoPtr->dLinesInvalidated = 1;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * UncacheDLine --
+ *
+ *	Remove one DLine from the cache of off-screen display lines,
+ *	without freeing it.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The line's nextPtr is reset to NULL.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+UncacheDLine(dInfoPtr, dlPtr)
+    TextDInfo *dInfoPtr;		/* Display information for widget. */
+    DLine *dlPtr;			/* Cached line to remove. */
+{
+    Tcl_HashEntry *hPtr;
+    DLine *prevPtr;
+
+    hPtr = Tcl_FindHashEntry(&dInfoPtr->dLineCache,
+	    (char *) dlPtr->index.linePtr);
+    prevPtr = (DLine *) Tcl_GetHashValue(hPtr);
+    if (prevPtr == dlPtr) {
+	if (dlPtr->nextPtr == NULL) {
+	    Tcl_DeleteHashEntry(hPtr);
+	} else {
+	    Tcl_SetHashValue(hPtr, (ClientData) dlPtr->nextPtr);
+	}
+    } else {
+	while (prevPtr->nextPtr != dlPtr) {
+	    prevPtr = prevPtr->nextPtr;
+	}
+	prevPtr->nextPtr = dlPtr->nextPtr;
+    }
+    if (dlPtr->newerPtr != NULL) {
+	dlPtr->newerPtr->olderPtr = dlPtr->olderPtr;
+    } else {
+	dInfoPtr->newestPtr = dlPtr->olderPtr;
+    }
+    if (dlPtr->olderPtr != NULL) {
+	dlPtr->olderPtr->newerPtr = dlPtr->newerPtr;
+    } else {
+	dInfoPtr->oldestPtr = dlPtr->newerPtr;
+    }
+    dInfoPtr->numCached--;
+    dlPtr->nextPtr = NULL;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * DiscardCachedDLine --
+ *
+ *	Remove one DLine from the cache of off-screen display lines and
+ *	free it.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Memory and styles used by the line are released.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+DiscardCachedDLine(textPtr, dlPtr)
+    TkText *textPtr;			/* Information about overall text
+					 * widget. */
+    DLine *dlPtr;			/* Cached line to discard. */
+{
+    UncacheDLine(textPtr->dInfoPtr, dlPtr);
+    FreeDLines(textPtr, dlPtr, (DLine *) NULL, 0);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * GetDLine --
+ *
+ *	Return a display line starting at a given index, either from
+ *	the cache of off-screen lines or by calling LayoutDLine.
+ *
+ * Results:
+ *	The return value is a DLine as returned by LayoutDLine.
+ *
+ * Side effects:
+ *	The line is removed from the cache, and any cached lines for
+ *	the same text line that are out of date are freed.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static DLine *
+GetDLine(textPtr, indexPtr)
+    TkText *textPtr;		/* Overall information about text widget. */
+    TkTextIndex *indexPtr;	/* Beginning of display line. */
+{
+    TextDInfo *dInfoPtr = textPtr->dInfoPtr;
+    Tcl_HashEntry *hPtr;
+    DLine *dlPtr, *nextPtr;
+
+    hPtr = Tcl_FindHashEntry(&dInfoPtr->dLineCache,
+	    (char *) indexPtr->linePtr);
+    if (hPtr == NULL) {
+	return LayoutDLine(textPtr, indexPtr);
+    }
+    for (dlPtr = (DLine *) Tcl_GetHashValue(hPtr); dlPtr != NULL;
+	    dlPtr = nextPtr) {
+	nextPtr = dlPtr->nextPtr;
+	if ((dlPtr->epoch != dInfoPtr->layoutEpoch)
+		|| (dlPtr->width != dInfoPtr->maxX - dInfoPtr->x)) {
+	    DiscardCachedDLine(textPtr, dlPtr);
+	    continue;
+	}
+	if (dlPtr->index.byteIndex == indexPtr->byteIndex) {
+	    UncacheDLine(dInfoPtr, dlPtr);
+	    dlPtr->y = 0;
+	    dlPtr->oldY = -1;
+	    dlPtr->flags = (dlPtr->flags & HAS_3D_BORDER) | NEW_LAYOUT;
+	    return dlPtr;
+	}
+    }
+    return LayoutDLine(textPtr, indexPtr);
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * PurgeDLineCache --
+ *
+ *	Free the cached display lines for a range of text lines, because
+ *	the text or tags in that range are about to change.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	Cached lines for every text line from the one containing
+ *	index1Ptr through the one containing index2Ptr are freed.  A
+ *	NULL index1Ptr means the start of the text and a NULL index2Ptr
+ *	its end, so two NULLs empty the cache.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static void
+PurgeDLineCache(textPtr, index1Ptr, index2Ptr)
+    TkText *textPtr;		/* Overall information about text widget. */
+    TkTextIndex *index1Ptr;	/* First character in range, or NULL. */
+    TkTextIndex *index2Ptr;	/* Last character in range, or NULL. */
+{
+    TextDInfo *dInfoPtr = textPtr->dInfoPtr;
+    Tcl_HashEntry *hPtr;
+    TkTextLine *linePtr;
+    DLine *dlPtr, *newerPtr;
+    int first, last, lineNum;
+
+    if (dInfoPtr->numCached == 0) {
+	return;
+    }
+    first = (index1Ptr == NULL) ? 0 : TkBTreeLineIndex(index1Ptr->linePtr);
+    last = (index2Ptr == NULL) ? INT_MAX
+	    : TkBTreeLineIndex(index2Ptr->linePtr);
+
+    if ((index1Ptr != NULL) && (last - first < dInfoPtr->numCached)) {
+	/*
+	 * A short range (the usual case, an edit within a line): look up
+	 * each text line in it.
+	 */
+
+	linePtr = index1Ptr->linePtr;
+	for (lineNum = first; (lineNum <= last) && (linePtr != NULL);
+		lineNum++) {
+	    hPtr = Tcl_FindHashEntry(&dInfoPtr->dLineCache, (char *) linePtr);
+	    while (hPtr != NULL) {
+		DiscardCachedDLine(textPtr, (DLine *) Tcl_GetHashValue(hPtr));
+		hPtr = Tcl_FindHashEntry(&dInfoPtr->dLineCache,
+			(char *) linePtr);
+	    }
+	    linePtr = TkBTreeNextLine(linePtr);
+	}
+	return;
+    }
+
+    for (dlPtr = dInfoPtr->oldestPtr; dlPtr != NULL; dlPtr = newerPtr) {
+	newerPtr = dlPtr->newerPtr;
+	if ((index1Ptr == NULL) && (index2Ptr == NULL)) {
+	    DiscardCachedDLine(textPtr, dlPtr);
+	    continue;
+	}
+	lineNum = TkBTreeLineIndex(dlPtr->index.linePtr);
+	if ((lineNum >= first) && (lineNum <= last)) {
+	    DiscardCachedDLine(textPtr, dlPtr);
+	}
+    }
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -2458,9 +3044,8 @@ DisplayText(clientData)
 	maxHeight = dInfoPtr->maxY;
     }
     if (maxHeight > 0) {
-	pixmap = Tk_GetPixmap(Tk_Display(textPtr->tkwin),
-		Tk_WindowId(textPtr->tkwin), Tk_Width(textPtr->tkwin),
-		maxHeight, Tk_Depth(textPtr->tkwin));
+	pixmap = TkGetBufferPixmap(textPtr->tkwin, Tk_Width(textPtr->tkwin),
+		maxHeight);
 	for (prevPtr = NULL, dlPtr = textPtr->dInfoPtr->dLinePtr;
 		(dlPtr != NULL) && (dlPtr->y < dInfoPtr->maxY);
 		prevPtr = dlPtr, dlPtr = dlPtr->nextPtr) {
@@ -2477,7 +3062,7 @@ DisplayText(clientData)
 		}
 		DisplayDLine(textPtr, dlPtr, prevPtr, pixmap);
 		if (dInfoPtr->dLinesInvalidated) {
-		    Tk_FreePixmap(Tk_Display(textPtr->tkwin), pixmap);
+		    TkFreeBufferPixmap(textPtr->tkwin, pixmap);
 		    return;
 		}
 		dlPtr->oldY = dlPtr->y;
@@ -2485,7 +3070,7 @@ DisplayText(clientData)
 	    }
 	    /*prevPtr = dlPtr;*/
 	}
-	Tk_FreePixmap(Tk_Display(textPtr->tkwin), pixmap);
+	TkFreeBufferPixmap(textPtr->tkwin, pixmap);
     }
 
     /*
@@ -2730,6 +3315,13 @@ TkTextChanged(textPtr, index1Ptr, index2Ptr)
     DLine *firstPtr, *lastPtr;
     TkTextIndex rounded;
 
+    /*
+     * Cached lines for the range are about to be wrong too, and those
+     * for deleted lines must go before the lines themselves do.
+     */
+
+    PurgeDLineCache(textPtr, index1Ptr, index2Ptr);
+
     /*
      * Schedule both a redisplay and a recomputation of display information.
      * It's done here rather than the end of the procedure for two reasons:
@@ -2820,6 +3412,20 @@ TkTextRedrawTag(textPtr, index1Ptr, index2Ptr, tagPtr, withTag)
     TkTextIndex *curIndexPtr;
     TkTextIndex endOfText, *endIndexPtr;
 
+    /*
+     * Off-screen lines in the cache can't be checked cheaply for the
+     * tag, so drop all of them in the range.  A change to the whole
+     * tag (e.g. its configuration) just starts a new layout epoch, but
+     * the styles worked out for sets of tags must all be recomputed.
+     */
+
+    if ((index1Ptr == NULL) && (index2Ptr == NULL)) {
+	dInfoPtr->layoutEpoch++;
+	FreeTagSets(textPtr);
+    } else {
+	PurgeDLineCache(textPtr, index1Ptr, index2Ptr);
+    }
+
     /*
      * Round up the starting position if it's before the first line
      * visible on the screen (we only care about what's on the screen).
@@ -2996,6 +3602,8 @@ TkTextRelayoutWindow(textPtr)
      */
 
     FreeDLines(textPtr, dInfoPtr->dLinePtr, (DLine *) NULL, 1);
+    PurgeDLineCache(textPtr, (TkTextIndex *) NULL, (TkTextIndex *) NULL);
+    FreeTagSets(textPtr);
     dInfoPtr->dLinePtr = NULL;
 
     /*
@@ -3247,7 +3855,7 @@ MeasureUp(textPtr, srcPtr, distance, dstPtr)
 	index.byteIndex = 0;
 	lowestPtr = NULL;
 	do {
-	    dlPtr = LayoutDLine(textPtr, &index);
+	    dlPtr = GetDLine(textPtr, &index);
 	    dlPtr->nextPtr = lowestPtr;
 	    lowestPtr = dlPtr;
 	    TkTextIndexForwBytes(&index, dlPtr->byteCount, &index);
@@ -3275,7 +3883,7 @@ MeasureUp(textPtr, srcPtr, distance, dstPtr)
 	 * for the next display line to lay out.
 	 */
 
-	FreeDLines(textPtr, lowestPtr, (DLine *) NULL, 0);
+	CacheDLines(textPtr, lowestPtr, (DLine *) NULL, 0);
 	if (distance < 0) {
 	    return;
 	}
@@ -3549,7 +4157,7 @@ ScrollByLines(textPtr, offset)
 	    index.byteIndex = 0;
 	    lowestPtr = NULL;
 	    do {
-		dlPtr = LayoutDLine(textPtr, &index);
+		dlPtr = GetDLine(textPtr, &index);
 		dlPtr->nextPtr = lowestPtr;
 		lowestPtr = dlPtr;
 		TkTextIndexForwBytes(&index, dlPtr->byteCount, &index);
@@ -3570,7 +4178,7 @@ ScrollByLines(textPtr, offset)
 	     * for the next display line to lay out.
 	     */
 
-	    FreeDLines(textPtr, lowestPtr, (DLine *) NULL, 0);
+	    CacheDLines(textPtr, lowestPtr, (DLine *) NULL, 0);
 	    if (offset >= 0) {
 		goto scheduleUpdate;
 	    }
@@ -3592,11 +4200,11 @@ ScrollByLines(textPtr, offset)
 	lastLinePtr = TkBTreeFindLine(textPtr->tree,
 		TkBTreeNumLines(textPtr->tree));
 	for (i = 0; i < offset; i++) {
-	    dlPtr = LayoutDLine(textPtr, &textPtr->topIndex);
+	    dlPtr = GetDLine(textPtr, &textPtr->topIndex);
 	    if (dlPtr->length == 0 && dlPtr->height == 0) offset++;
 	    dlPtr->nextPtr = NULL;
 	    TkTextIndexForwBytes(&textPtr->topIndex, dlPtr->byteCount, &new);
-	    FreeDLines(textPtr, dlPtr, (DLine *) NULL, 0);
+	    CacheDLines(textPtr, dlPtr, (DLine *) NULL, 0);
 	    if (new.linePtr == lastLinePtr) {
 		break;
 	    }
@@ -3754,12 +4362,12 @@ TkTextYviewCmd(textPtr, interp, argc, argv)
 		lastLinePtr = TkBTreeFindLine(textPtr->tree,
 			TkBTreeNumLines(textPtr->tree));
 		do {
-		    dlPtr = LayoutDLine(textPtr, &textPtr->topIndex);
+		    dlPtr = GetDLine(textPtr, &textPtr->topIndex);
 		    dlPtr->nextPtr = NULL;
 		    TkTextIndexForwBytes(&textPtr->topIndex, dlPtr->byteCount,
 			    &new);
 		    pixels -= dlPtr->height;
-		    FreeDLines(textPtr, dlPtr, (DLine *) NULL, 0);
+		    CacheDLines(textPtr, dlPtr, (DLine *) NULL, 0);
 		    if (new.linePtr == lastLinePtr) {
 			break;
 		    }
@@ -550,6 +550,7 @@ TkTextTagCmd(textPtr, interp, argc, argv)
 	    && (length >= 2)) {
 	TkTextTag **arrayPtr;
 	int arraySize;
+	ClientData mark;
 
 	if ((argc != 3) && (argc != 4)) {
 	    Tcl_AppendResult(interp, "wrong # args: should be \"",
@@ -557,11 +558,12 @@ TkTextTagCmd(textPtr, interp, argc, argv)
 		    (char *) NULL);
 	    return TCL_ERROR;
 	}
+	mark = Tcl_ArenaMark();
 	if (argc == 3) {
 	    Tcl_HashSearch search;
 	    Tcl_HashEntry *hPtr;
 
-	    arrayPtr = (TkTextTag **) ckalloc((unsigned)
+	    arrayPtr = (TkTextTag **) Tcl_ArenaAlloc((unsigned)
 		    (textPtr->numTags * sizeof(TkTextTag *)));
 	    for (i = 0, hPtr = Tcl_FirstHashEntry(&textPtr->tagTable, &search);
 		    hPtr != NULL; i++, hPtr = Tcl_NextHashEntry(&search)) {
@@ -571,19 +573,17 @@ TkTextTagCmd(textPtr, interp, argc, argv)
 	} else {
 	    if (TkTextGetIndex(interp, textPtr, argv[3], &index1)
 		    != TCL_OK) {
+		Tcl_ArenaRelease(mark);
 		return TCL_ERROR;
 	    }
-	    arrayPtr = TkBTreeGetTags(&index1, &arraySize);
-	    if (arrayPtr == NULL) {
-		return TCL_OK;
-	    }
+	    arrayPtr = TkBTreeGetTagsInArena(&index1, &arraySize);
 	}
 	SortTags(arraySize, arrayPtr);
 	for (i = 0; i < arraySize; i++) {
 	    tagPtr = arrayPtr[i];
 	    Tcl_AppendElement(interp, tagPtr->name);
 	}
-	ckfree((char *) arrayPtr);
+	Tcl_ArenaRelease(mark);
     } else if ((c == 'n') && (strncmp(argv[2], "nextrange", length) == 0)
 	    && (length >= 2)) {
 	TkTextSearch tSearch;
@@ -751,6 +751,9 @@ TkTextTagCmd(textPtr, interp, argc, argv)
 	    && (length >= 3)) {
 	TkTextSearch tSearch;
 	char position[TK_POS_CHARS];
+	TkTextLine *linePtr;
+	TkTextSegment *segPtr;
+	int lineNum, charIndex;
 
 	if (argc != 4) {
 	    Tcl_AppendResult(interp, "wrong # args: should be \"",
@@ -769,8 +772,33 @@ TkTextTagCmd(textPtr, interp, argc, argv)
 	    TkTextPrintIndex(&first, position);
 	    Tcl_AppendElement(interp, position);
 	}
+
+	/*
+	 * Toggles come back in order, so rather than have
+	 * TkTextPrintIndex find each one's line number and count the
+	 * characters before it from the start of the line, carry both
+	 * on from the previous toggle.
+	 */
+
+	linePtr = NULL;
+	lineNum = charIndex = 0;
+	segPtr = NULL;
 	while (TkBTreeNextTag(&tSearch)) {
-	    TkTextPrintIndex(&tSearch.curIndex, position);
+	    if (tSearch.curIndex.linePtr != linePtr) {
+		linePtr = tSearch.curIndex.linePtr;
+		lineNum = TkBTreeLineIndex(linePtr);
+		charIndex = 0;
+		segPtr = linePtr->segPtr;
+	    }
+	    for ( ; segPtr != tSearch.segPtr; segPtr = segPtr->nextPtr) {
+		if (segPtr->typePtr == &tkTextCharType) {
+		    charIndex += Tcl_NumUtfChars(segPtr->body.chars,
+			    segPtr->size);
+		} else {
+		    charIndex += segPtr->size;
+		}
+	    }
+	    sprintf(position, "%d.%d", lineNum + 1, charIndex);
 	    Tcl_AppendElement(interp, position);
 	}
     } else if ((c == 'r') && (strncmp(argv[2], "remove", length) == 0)
@@ -1283,6 +1311,7 @@ TkTextPickCurrent(textPtr, eventPtr)
 					 * compiler warning. */
 
     int numOldTags, numNewTags, i, j, size;
+    ClientData mark;
     XEvent event;
 
     /*
@@ -1368,9 +1397,10 @@ TkTextPickCurrent(textPtr, eventPtr)
      */
 
     SortTags(textPtr->numCurTags, textPtr->curTagArrayPtr);
+    mark = Tcl_ArenaMark();
     if (numNewTags > 0) {
 	size = numNewTags * sizeof(TkTextTag *);
-	copyArrayPtr = (TkTextTag **) ckalloc((unsigned) size);
+	copyArrayPtr = (TkTextTag **) Tcl_ArenaAlloc((unsigned) size);
 	memcpy((VOID *) copyArrayPtr, (VOID *) newArrayPtr, (size_t) size);
 	for (i = 0; i < textPtr->numCurTags; i++) {
 	    for (j = 0; j < numNewTags; j++) {
@@ -1433,6 +1463,6 @@ TkTextPickCurrent(textPtr, eventPtr)
 	    Tk_BindEvent(textPtr->bindingTable, &event, textPtr->tkwin,
 		    numNewTags, (ClientData *) copyArrayPtr);
 	}
-	ckfree((char *) copyArrayPtr);
     }
+    Tcl_ArenaRelease(mark);
 }
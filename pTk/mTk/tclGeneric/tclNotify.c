@@ -77,6 +77,12 @@ typedef struct ThreadSpecificData {
 				/* Next notifier in global list of notifiers.
 				 * Access is controlled by the listLock global
 				 * mutex. */
+    double waitTime;		/* Seconds spent in Tcl_WaitForEvent while
+				 * the event loop's profile is kept, so
+				 * that blocking is not counted as work. */
+    int depth;			/* Number of Tcl_DoOneEvent calls active,
+				 * counting nested ones from "update" or
+				 * a wait inside a handler. */
 } ThreadSpecificData;
 
 static Tcl_ThreadDataKey dataKey;
@@ -94,6 +100,7 @@ TCL_DECLARE_MUTEX(listLock)
  * Declarations for routines used only in this file.
  */
 
+static int		DoOneEvent _ANSI_ARGS_((int flags));
 static void		QueueEvent _ANSI_ARGS_((ThreadSpecificData *tsdPtr,
 			    Tcl_Event* evPtr, Tcl_QueuePosition position));
 
@@ -568,6 +575,7 @@ Tcl_ServiceEvent(flags)
     Tcl_Event *evPtr, *prevPtr;
     Tcl_EventProc *proc;
     int result;
+    ClientData mark;
     ThreadSpecificData *tsdPtr = TCL_TSD_INIT(&dataKey);
 
     /*
@@ -627,7 +635,9 @@ Tcl_ServiceEvent(flags)
 	 */
 
 	Tcl_MutexUnlock(&(tsdPtr->queueMutex));
+	mark = Tcl_ArenaMark();
 	result = (*proc)(evPtr, flags);
+	Tcl_ArenaRelease(mark);
 	Tcl_MutexLock(&(tsdPtr->queueMutex));
 
 	if (result) {
@@ -801,7 +811,11 @@ Tcl_SetMaxBlockTime(timePtr)
  *	May delay execution of process while waiting for an event,
  *	unless TCL_DONT_WAIT is set in the flags argument.  Event
  *	sources are invoked to check for and queue events.  Event
- *	handlers may produce arbitrary side effects.
+ *	handlers may produce arbitrary side effects.  When the event
+ *	loop's profile is being kept the time taken is recorded.  Unless
+ *	TCL_DONT_WAIT is given, idle handlers held by Tcl_HoldIdle are
+ *	let run for the duration of the call:  whatever is being waited
+ *	for (a dialog's answer, say) may need the display to be updated.
  *
  *----------------------------------------------------------------------
  */
@@ -813,10 +827,36 @@ Tcl_DoOneEvent(flags)
 				 * TCL_WINDOW_EVENTS, TCL_FILE_EVENTS,
 				 * TCL_TIMER_EVENTS, TCL_IDLE_EVENTS, or
 				 * others defined by event sources. */
+{
+    ThreadSpecificData *tsdPtr = TCL_TSD_INIT(&dataKey);
+    double waited = tsdPtr->waitTime;
+    double start = LangProfileStart();
+    int result, held = 0;
+
+    if (!(flags & TCL_DONT_WAIT) && (held = Tcl_HoldIdle(0)) != 0) {
+	Tcl_HoldIdle(-held);
+    }
+    tsdPtr->depth++;
+    result = DoOneEvent(flags);
+    tsdPtr->depth--;
+    if (held) {
+	Tcl_HoldIdle(held);
+    }
+    if (start) {
+	LangProfileIteration(start + (tsdPtr->waitTime - waited),
+		tsdPtr->depth);
+    }
+    return result;
+}
+
+static int
+DoOneEvent(flags)
+    int flags;			/* As for Tcl_DoOneEvent. */
 {
     int result = 0, oldMode;
     EventSource *sourcePtr;
     Tcl_Time *timePtr;
+    double waitStart;
     ThreadSpecificData *tsdPtr = TCL_TSD_INIT(&dataKey);
 
     /*
@@ -911,7 +951,14 @@ Tcl_DoOneEvent(flags)
 	 * returns -1, we should abort Tcl_DoOneEvent.
 	 */
 
+	waitStart = LangProfileStart();
 	result = Tcl_WaitForEvent(timePtr);
+	if (waitStart) {
+	    double waitEnd = LangProfileStart();
+	    if (waitEnd) {
+		tsdPtr->waitTime += waitEnd - waitStart;
+	    }
+	}
 	if (result < 0) {
 	    result = 0;
 	    break;
@@ -118,6 +118,8 @@ typedef struct ThreadSpecificData {
 				 * can be called without calling any of the
 				 * new ones created by old ones. */
     int afterId;		/* For unique identifiers of after events. */
+    int idleHold;		/* While > 0 idle handlers are left queued;
+				 * see Tcl_HoldIdle. */
 } ThreadSpecificData;
 
 static Tcl_ThreadDataKey dataKey;
@@ -367,7 +369,7 @@ TimerSetupProc(data, flags)
     Tcl_Time blockTime;
     ThreadSpecificData *tsdPtr = InitTimer();
 
-    if (((flags & TCL_IDLE_EVENTS) && tsdPtr->idleList)
+    if (((flags & TCL_IDLE_EVENTS) && tsdPtr->idleList && !tsdPtr->idleHold)
 	    || ((flags & TCL_TIMER_EVENTS) && tsdPtr->timerPending)) {
 	/*
 	 * There is an idle handler or a pending timer event, so just poll.
@@ -488,8 +490,10 @@ TimerHandlerEventProc(evPtr, flags)
 				 * handle, such as TCL_FILE_EVENTS. */
 {
     TimerHandler *timerHandlerPtr, **nextPtrPtr;
-    Tcl_Time time;
+    Tcl_Time time, now;
     int currentTimerId;
+    double start;
+    ClientData mark;
     ThreadSpecificData *tsdPtr = InitTimer();
 
     /*
@@ -559,7 +563,23 @@ TimerHandlerEventProc(evPtr, flags)
 	 */
 
 	(*nextPtrPtr) = timerHandlerPtr->nextPtr;
+	start = LangProfileStart();
+	if (start) {
+	    /*
+	     * Handlers earlier in this pass have used up time since "time"
+	     * was taken, so read the clock again for an honest lateness.
+	     */
+
+	    Tcl_GetTime(&now);
+	    LangProfileSample(LANG_HIST_LATENESS,
+		    (now.sec - timerHandlerPtr->time.sec) * 1e6
+		    + (now.usec - timerHandlerPtr->time.usec));
+	}
+	mark = Tcl_ArenaMark();
 	(*timerHandlerPtr->proc)(timerHandlerPtr->clientData);
+	Tcl_ArenaRelease(mark);
+	LangProfileRecord("timer", NULL, (VOID *) timerHandlerPtr->proc,
+		start);
 	ckfree((char *) timerHandlerPtr);
     }
     TimerSetupProc(NULL, TCL_TIMER_EVENTS);
@@ -658,6 +678,54 @@ Tcl_CancelIdleCall(proc, clientData)
     }
 }
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * Tcl_HoldIdle --
+ *
+ *	Hold back, or release, the handlers on the when-idle list.  Holds
+ *	nest: idle handlers are not called while any hold is in force,
+ *	so a batch of changes can be made without any of the redisplay
+ *	or geometry work they schedule being done until the end, even if
+ *	"update" is called in the meantime.  A Tcl_DoOneEvent that may
+ *	block lifts the holds while it runs (see there), so waiting for
+ *	something inside a batch does not freeze the application.
+ *
+ * Results:
+ *	The number of holds in force after the change.
+ *
+ * Side effects:
+ *	A positive delta adds that many holds, a negative one releases
+ *	that many.  When the last hold is released, handlers queued
+ *	meanwhile will be called the next time the notifier is idle.
+ *
+ *----------------------------------------------------------------------
+ */
+
+int
+Tcl_HoldIdle(delta)
+    int delta;			/* Holds to add (> 0) or release (< 0), or
+				 * 0 to query. */
+{
+    Tcl_Time blockTime;
+    ThreadSpecificData *tsdPtr = InitTimer();
+
+    if (delta > 0) {
+	tsdPtr->idleHold += delta;
+    } else if (delta < 0 && tsdPtr->idleHold > 0) {
+	tsdPtr->idleHold += delta;
+	if (tsdPtr->idleHold < 0) {
+	    tsdPtr->idleHold = 0;
+	}
+	if (tsdPtr->idleHold == 0 && tsdPtr->idleList != NULL) {
+	    blockTime.sec = 0;
+	    blockTime.usec = 0;
+	    Tcl_SetMaxBlockTime(&blockTime);
+	}
+    }
+    return tsdPtr->idleHold;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -684,15 +752,26 @@ TclServiceIdle()
     IdleHandler *idlePtr;
     int oldGeneration;
     Tcl_Time blockTime;
+    double start;
+    ClientData mark;
     ThreadSpecificData *tsdPtr = InitTimer();
 
-    if (tsdPtr->idleList == NULL) {
+    if (tsdPtr->idleList == NULL || tsdPtr->idleHold) {
 	return 0;
     }
 
     oldGeneration = tsdPtr->idleGeneration;
     tsdPtr->idleGeneration++;
 
+    if (LangProfileStart()) {
+	int queued = 0;
+	for (idlePtr = tsdPtr->idleList; idlePtr != NULL;
+		idlePtr = idlePtr->nextPtr) {
+	    queued++;
+	}
+	LangProfileSample(LANG_HIST_IDLEQUEUE, (double) queued);
+    }
+
     /*
      * The code below is trickier than it may look, for the following
      * reasons:
@@ -720,7 +799,11 @@ TclServiceIdle()
 	if (tsdPtr->idleList == NULL) {
 	    tsdPtr->lastIdlePtr = NULL;
 	}
+	start = LangProfileStart();
+	mark = Tcl_ArenaMark();
 	(*idlePtr->proc)(idlePtr->clientData);
+	Tcl_ArenaRelease(mark);
+	LangProfileRecord("idle", NULL, (VOID *) idlePtr->proc, start);
 	ckfree((char *) idlePtr);
     }
     if (tsdPtr->idleList) {
@@ -57,6 +57,8 @@ static void 		ImgXpmGetPixmapFromData _ANSI_ARGS_((
 			    Tcl_Interp * interp,
 			    PixmapMaster *masterPtr,
 			    PixmapInstance *instancePtr));
+static int *		ImgXpmIndexPixels _ANSI_ARGS_((
+			    PixmapMaster *masterPtr));
 static char *		GetType _ANSI_ARGS_((char * colorDefn,
 			    int  * type_ret));
 static char *		GetColor _ANSI_ARGS_((char * colorDefn,
@@ -155,6 +157,7 @@ ImgXpmCreate(interp, name, argc, objv, typePtr, master, clientDataPtr)
     masterPtr->id = NULL;
     masterPtr->data = NULL;
     masterPtr->isDataAlloced = 0;
+    masterPtr->pixelIndex = NULL;
     masterPtr->instancePtr = NULL;
 
     if (ImgXpmConfigureMaster(masterPtr, argc, objv, 0) != TCL_OK) {
@@ -332,6 +335,10 @@ ImgXpmGetData(interp, masterPtr)
 	if (masterPtr->isDataAlloced && masterPtr->data) {
 	    ckfree((char*)masterPtr->data);
 	}
+	if (masterPtr->pixelIndex) {
+	    ckfree((char*)masterPtr->pixelIndex);
+	    masterPtr->pixelIndex = NULL;
+	}
 	masterPtr->isDataAlloced = isAllocated;
 	masterPtr->data = data;
 	masterPtr->size[0] = size[0];
@@ -684,6 +691,106 @@ GetColor(colorDefn, colorName, type_ret)
     return colorDefn;
 }
 
+/*----------------------------------------------------------------------
+ * ImgXpmIndexPixels --
+ *
+ *	Translates the pixels of the image from color keys to color
+ *	numbers.  Scanning every color for every pixel made big images
+ *	with many colors slow to load, so the keys are looked up in a
+ *	table instead:  indexed directly by the key when it is one or two
+ *	characters long, or a hash table for longer keys.  If a key is
+ *	defined more than once the first definition is used.
+ *
+ * Results:
+ *	A ckalloc'ed array of size[0]*size[1] color numbers, -1 for
+ *	pixels whose key is not defined.
+ *
+ * Side effects:
+ *	None.
+ *----------------------------------------------------------------------
+ */
+static int *
+ImgXpmIndexPixels(masterPtr)
+    PixmapMaster *masterPtr;
+{
+    int cpp = masterPtr->cpp;
+    int ncolors = masterPtr->ncolors;
+    char ** keys = masterPtr->data + 1;
+    char ** rows = masterPtr->data + 1 + ncolors;
+    int * index, * ip;
+    int i, j, k;
+
+    index = (int*)ckalloc(sizeof(int)*masterPtr->size[0]*masterPtr->size[1]);
+    ip = index;
+
+    if (cpp <= 2) {
+	int * table;
+	int tableSize = (cpp == 1) ? 256 : 65536;
+
+	table = (int*)ckalloc(sizeof(int)*tableSize);
+	for (k=0; k<tableSize; k++) {
+	    table[k] = -1;
+	}
+	for (k=ncolors-1; k>=0; k--) {
+	    if (cpp == 1) {
+		table[UCHAR(keys[k][0])] = k;
+	    } else if (keys[k][0] != '\0') {
+		table[(UCHAR(keys[k][0])<<8) | UCHAR(keys[k][1])] = k;
+	    }
+	}
+	table[0] = -1;			/* Running off the end of a row */
+
+	for (i=0; i<masterPtr->size[1]; i++) {
+	    unsigned char * p = (unsigned char *) rows[i];
+
+	    for (j=0; j<masterPtr->size[0]; j++) {
+		if (cpp == 1) {
+		    *ip++ = table[*p];
+		    if (*p) {
+			p++;
+		    }
+		} else if (p[0] == '\0') {
+		    *ip++ = -1;
+		} else {
+		    *ip++ = (p[1] == '\0') ? -1 : table[(p[0]<<8) | p[1]];
+		    p += (p[1] == '\0') ? 1 : 2;
+		}
+	    }
+	}
+	ckfree((char*)table);
+    } else {
+	Tcl_HashTable table;
+	Tcl_HashEntry * hPtr;
+	char * key = ckalloc((unsigned)cpp + 1);
+	int new;
+
+	Tcl_InitHashTable(&table, TCL_STRING_KEYS);
+	for (k=0; k<ncolors; k++) {
+	    strncpy(key, keys[k], (size_t)cpp);
+	    key[cpp] = '\0';
+	    hPtr = Tcl_CreateHashEntry(&table, key, &new);
+	    if (new) {
+		Tcl_SetHashValue(hPtr, (ClientData)(long)k);
+	    }
+	}
+	for (i=0; i<masterPtr->size[1]; i++) {
+	    char * p = rows[i];
+
+	    for (j=0; j<masterPtr->size[0]; j++) {
+		for (k=0; *p && k<cpp; k++) {
+		    key[k] = *p++;
+		}
+		key[k] = '\0';
+		hPtr = (k == cpp) ? Tcl_FindHashEntry(&table, key) : NULL;
+		*ip++ = hPtr ? (int)(long)Tcl_GetHashValue(hPtr) : -1;
+	    }
+	}
+	Tcl_DeleteHashTable(&table);
+	ckfree(key);
+    }
+    return index;
+}
+
 /*----------------------------------------------------------------------
  * ImgXpmGetPixmapFromData --
  *
@@ -697,7 +804,7 @@ ImgXpmGetPixmapFromData(interp, masterPtr, instancePtr)
     PixmapInstance *instancePtr;
 {
     XImage * image = NULL, * mask = NULL;
-    int depth, i, j, k, lOffset, isTransp = 0, isMono;
+    int depth, i, lOffset, isTransp = 0, isMono;
     ColorStruct * colors;
 
     depth = Tk_Depth(instancePtr->tkwin);
@@ -821,40 +928,18 @@ ImgXpmGetPixmapFromData(interp, masterPtr, instancePtr)
     lOffset += masterPtr->ncolors;
 
     /*
-     * Parse the main body of the image
+     * Parse the main body of the image.  This only depends on the data,
+     * so it is done once for all the instances of the image.
      */
+    if (masterPtr->pixelIndex == NULL) {
+	masterPtr->pixelIndex = ImgXpmIndexPixels(masterPtr);
+    }
+    instancePtr->colors = colors;
     for (i=0; i<masterPtr->size[1]; i++) {
-	char * p = masterPtr->data[i+lOffset];
-
-	for (j=0; j<masterPtr->size[0]; j++) {
-	    if (masterPtr->cpp == 1) {
-		for (k=0; k<masterPtr->ncolors; k++) {
-		    if (*p == colors[k].c) {
-			TixpXpmSetPixel(instancePtr, image, mask, j, i,
-			        colors[k].colorPtr, &isTransp);
-			break;
-		    }
-		}
-		if (*p) {
-		    p++;
-		}
-	    } else {
-		for (k=0; k<masterPtr->ncolors; k++) {
-		    if (strncmp(p, colors[k].cstring,
-			    (size_t)masterPtr->cpp) == 0) {
-			TixpXpmSetPixel(instancePtr, image, mask, j, i,
-			        colors[k].colorPtr, &isTransp);
-			break;
-		    }
-		}
-		for (k=0; *p && k<masterPtr->cpp; k++) {
-		    p++;
-		}
-	    }
-	}
+	TixpXpmSetRow(instancePtr, image, mask, i,
+		masterPtr->pixelIndex + i*masterPtr->size[0], &isTransp);
     }
 
-    instancePtr->colors = colors;
 
     TixpXpmRealizePixmap(masterPtr, instancePtr, image, mask, isTransp);
     TixpXpmFreeTmpBuffer(masterPtr, instancePtr, image, mask);
@@ -1205,6 +1290,10 @@ ImgXpmDelete(masterData)
 	ckfree((char*)masterPtr->data);
 	masterPtr->data = NULL;
     }
+    if (masterPtr->pixelIndex != NULL) {
+	ckfree((char*)masterPtr->pixelIndex);
+	masterPtr->pixelIndex = NULL;
+    }
 
     Tk_FreeOptions(configSpecs, (char *) masterPtr, (Display *) NULL, 0);
     ckfree((char *) masterPtr);
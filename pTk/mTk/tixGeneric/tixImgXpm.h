@@ -60,6 +60,11 @@ typedef struct PixmapMaster {
 				 */
     int isDataAlloced;		/* False iff the data is got from
 				 * the -id switch */
+    int *pixelIndex;		/* Color number of each pixel, row by row,
+				 * or -1 where the data uses an undefined
+				 * key.  Worked out from data by the first
+				 * instance and shared by the others; NULL
+				 * until then. */
 				/* First in list of all instances associated
 				 * with this master. */
     struct PixmapInstance *instancePtr;
@@ -119,6 +124,10 @@ EXTERN void		TixpXpmSetPixel _ANSI_ARGS_((
 			    PixmapInstance * instancePtr, XImage * image,
 			    XImage * mask, int x, int y, XColor * colorPtr,
 			    int * isTranspPtr));
+EXTERN void		TixpXpmSetRow _ANSI_ARGS_((
+			    PixmapInstance * instancePtr, XImage * image,
+			    XImage * mask, int y, int * indexPtr,
+			    int * isTranspPtr));
 EXTERN void		TixpXpmRealizePixmap _ANSI_ARGS_((
 			    PixmapMaster * masterPtr,
 			    PixmapInstance * instancePtr,
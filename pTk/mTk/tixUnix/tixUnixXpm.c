@@ -148,6 +148,77 @@ TixpXpmSetPixel(instancePtr, image, mask, x, y, colorPtr, isTranspPtr)
     }
 }
 
+/*----------------------------------------------------------------------
+ * TixpXpmSetRow --
+ *
+ *	Sets row y of the image from the color numbers in indexPtr, as
+ *	TixpXpmSetPixel would for each pixel but storing straight into
+ *	the image data when its layout is a simple one.  Pixels whose
+ *	color number is negative are left alone.
+ *----------------------------------------------------------------------
+ */
+void
+TixpXpmSetRow(instancePtr, image, mask, y, indexPtr, isTranspPtr)
+    PixmapInstance * instancePtr;
+    XImage * image;
+    XImage * mask;
+    int y;
+    int * indexPtr;
+    int * isTranspPtr;
+{
+    static int one = 1;
+    ColorStruct * colors = instancePtr->colors;
+    int width = instancePtr->masterPtr->size[0];
+    int hostOrder = (*(char *) &one) ? LSBFirst : MSBFirst;
+    int bpp = image->bits_per_pixel;
+    char * row = image->data + y * image->bytes_per_line;
+    unsigned char * maskRow;
+    XColor * colorPtr;
+    int x;
+
+    if ((bpp != 8 && bpp != 16 && bpp != 32)
+	    || (bpp != 8 && image->byte_order != hostOrder)
+	    || (mask->bitmap_unit != 8
+		    && mask->byte_order != mask->bitmap_bit_order)) {
+	for (x=0; x<width; x++) {
+	    if (indexPtr[x] >= 0) {
+		TixpXpmSetPixel(instancePtr, image, mask, x, y,
+			colors[indexPtr[x]].colorPtr, isTranspPtr);
+	    }
+	}
+	return;
+    }
+
+    maskRow = (unsigned char *) mask->data + y * mask->bytes_per_line;
+    memset(maskRow, 0, (size_t) mask->bytes_per_line);
+    for (x=0; x<width; x++) {
+	if (indexPtr[x] < 0) {
+	    continue;
+	}
+	colorPtr = colors[indexPtr[x]].colorPtr;
+	if (colorPtr == NULL) {
+	    *isTranspPtr = 1;
+	    continue;
+	}
+	switch (bpp) {
+	  case 32:
+	    ((unsigned int *) row)[x] = (unsigned int) colorPtr->pixel;
+	    break;
+	  case 16:
+	    ((unsigned short *) row)[x] = (unsigned short) colorPtr->pixel;
+	    break;
+	  default:
+	    ((unsigned char *) row)[x] = (unsigned char) colorPtr->pixel;
+	    break;
+	}
+	if (mask->bitmap_bit_order == LSBFirst) {
+	    maskRow[x>>3] |= 1 << (x&7);
+	} else {
+	    maskRow[x>>3] |= 0x80 >> (x&7);
+	}
+    }
+}
+
 /*----------------------------------------------------------------------
  * TixpXpmRealizePixmap --
  *
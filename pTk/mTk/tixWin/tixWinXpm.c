@@ -180,6 +180,32 @@ TixpXpmSetPixel(instancePtr, image, mask, x, y, colorPtr, isTranspPtr)
 #ifndef __PM__				/* These functions for PM are
 					   implemented elsewhere. */
 
+/*----------------------------------------------------------------------
+ * TixpXpmSetRow --
+ *
+ *	Sets row y of the image from the color numbers in indexPtr.
+ *	Pixels whose color number is negative are left alone.
+ *----------------------------------------------------------------------
+ */
+void
+TixpXpmSetRow(instancePtr, image, mask, y, indexPtr, isTranspPtr)
+    PixmapInstance * instancePtr;
+    XImage * image;
+    XImage * mask;
+    int y;
+    int * indexPtr;
+    int * isTranspPtr;
+{
+    int x;
+
+    for (x=0; x<instancePtr->masterPtr->size[0]; x++) {
+	if (indexPtr[x] >= 0) {
+	    TixpXpmSetPixel(instancePtr, image, mask, x, y,
+		    instancePtr->colors[indexPtr[x]].colorPtr, isTranspPtr);
+	}
+    }
+}
+
 /*----------------------------------------------------------------------
  * TixpXpmRealizePixmap --
  *
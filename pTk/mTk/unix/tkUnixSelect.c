@@ -61,6 +61,9 @@ typedef struct IncrInfo {
     int numIncrs;               /* Number of entries in converts that
 				 * aren't -1 (i.e. # of INCR-mode transfers
 				 * not yet completed). */
+    int chunkSize;              /* Number of bytes requested from the
+				 * selection handler for each chunk;
+				 * fixed for the whole transfer. */
     Tcl_TimerToken timeout;     /* Token for timer procedure. */
     int idleTime;               /* Number of seconds since we heard
 				 * anything from the selection
@@ -88,6 +91,13 @@ static Tcl_ThreadDataKey dataKey;
 
 #define MAX_PROP_WORDS 100000
 
+/*
+ * Largest single property we'll accept from an owner that ignores the
+ * usual size limit (e.g. one using BIG-REQUESTS), in words:
+ */
+
+#define MAX_INCR_PROP_WORDS (16*1024*1024)
+
 static TkSelRetrievalInfo *pendingRetrievals = NULL;
 				/* List of all retrievals currently
 				 * being waited for. */
@@ -99,7 +109,6 @@ static TkSelRetrievalInfo *pendingRetrievals = NULL;
 static void             ConvertSelection _ANSI_ARGS_((TkWindow *winPtr,
 			    XSelectionRequestEvent *eventPtr));
 static void             IncrTimeoutProc _ANSI_ARGS_((ClientData clientData));
-static int              SelectionSize _ANSI_ARGS_((TkSelHandler *selPtr, Atom type, Tk_Window tkwin));
 static int              SelGetProc _ANSI_ARGS_((ClientData clientData,
 			    Tcl_Interp *interp, char *portion));
 static void             SelRcvIncrProc _ANSI_ARGS_((ClientData clientData,
@@ -107,10 +116,108 @@ static void             SelRcvIncrProc _ANSI_ARGS_((ClientData clientData,
 static void             SelTimeoutProc _ANSI_ARGS_((ClientData clientData));
 
 static void             FreeHandler _ANSI_ARGS_((ClientData clientData));
+static int              GetSelProperty _ANSI_ARGS_((Display *display,
+			    Window window, Atom property, Bool delete,
+			    Atom *typePtr, int *formatPtr,
+			    unsigned long *numItemsPtr,
+			    unsigned long *bytesAfterPtr,
+			    unsigned char **dataPtr));
 static int              HandleCompat _ANSI_ARGS_((ClientData clientData,
 			    int offset, long *buffer, int maxBytes,
 			    Atom type, Tk_Window tkwin));
 
+/*
+ *----------------------------------------------------------------------
+ *
+ * TkSelChunkSize --
+ *
+ *      Compute how many bytes of selection data to move at once
+ *      for the display of tkwin.  The ICCCM requires each property
+ *      written by the selection owner to fit in a single request,
+ *      so the size is derived from the server's maximum request
+ *      size, leaving room for the request header and for encoding
+ *      conversions that grow the data.
+ *
+ * Results:
+ *      Chunk size in bytes, between TK_SEL_BYTES_AT_ONCE and
+ *      TK_SEL_MAX_BYTES_AT_ONCE.
+ *
+ * Side effects:
+ *      None.
+ *
+ *----------------------------------------------------------------------
+ */
+
+int
+TkSelChunkSize(tkwin)
+    Tk_Window tkwin;            /* Window whose display is used. */
+{
+    long size = (XMaxRequestSize(Tk_Display(tkwin)) - 64) * 2;
+
+    if (size < TK_SEL_BYTES_AT_ONCE) {
+	return TK_SEL_BYTES_AT_ONCE;
+    }
+    if (size > TK_SEL_MAX_BYTES_AT_ONCE) {
+	return TK_SEL_MAX_BYTES_AT_ONCE;
+    }
+    return (int) size;
+}
+
+/*
+ *----------------------------------------------------------------------
+ *
+ * GetSelProperty --
+ *
+ *      Read a selection property, wherever possible in a single
+ *      request.  Owners on servers with the BIG-REQUESTS extension
+ *      may store more than MAX_PROP_WORDS in one property, so if
+ *      the first read comes up short the property is read again
+ *      in full.
+ *
+ * Results:
+ *      Same as XGetWindowProperty.
+ *
+ * Side effects:
+ *      The property is deleted if delete is True and it was read
+ *      completely.
+ *
+ *----------------------------------------------------------------------
+ */
+
+static int
+GetSelProperty(display, window, property, delete, typePtr, formatPtr,
+	numItemsPtr, bytesAfterPtr, dataPtr)
+    Display *display;
+    Window window;
+    Atom property;
+    Bool delete;
+    Atom *typePtr;
+    int *formatPtr;
+    unsigned long *numItemsPtr;
+    unsigned long *bytesAfterPtr;
+    unsigned char **dataPtr;
+{
+    int result;
+
+    *dataPtr = NULL;
+    result = XGetWindowProperty(display, window, property, 0,
+	    MAX_PROP_WORDS, delete, (Atom) AnyPropertyType, typePtr,
+	    formatPtr, numItemsPtr, bytesAfterPtr, dataPtr);
+    if ((result == Success) && (*bytesAfterPtr != 0)
+	    && (*bytesAfterPtr <= 4 * (unsigned long) MAX_INCR_PROP_WORDS)) {
+	long length = MAX_PROP_WORDS + (long) (*bytesAfterPtr + 3) / 4;
+
+	if (*dataPtr != NULL) {
+	    XFree((char *) *dataPtr);
+	    *dataPtr = NULL;
+	}
+	result = XGetWindowProperty(display, window, property, 0,
+		length, delete, (Atom) AnyPropertyType, typePtr,
+		formatPtr, numItemsPtr, bytesAfterPtr, dataPtr);
+    }
+    return result;
+}
+
 /*
  *----------------------------------------------------------------------
  *
@@ -256,7 +363,7 @@ TkSelPropProc(eventPtr)
     unsigned i;
     int length, numItems;
     Atom target, formatType = None;
-    long buffer[TK_SEL_WORDS_AT_ONCE];
+    long *buffer;
     TkDisplay *dispPtr = TkGetDisplay(eventPtr->xany.display);
     Tk_ErrorHandler errorHandler;
     ThreadSpecificData *tsdPtr = (ThreadSpecificData *)
@@ -320,6 +427,8 @@ TkSelPropProc(eventPtr)
                            selPtr->selection, selPtr->target, selPtr->format);
 
 	    formatType = selPtr->format;
+	    buffer = (long *) ckalloc((unsigned) (incrPtr->chunkSize
+		    + sizeof(long)));
 	    if (incrPtr->converts[i].offset == -2) {
 		/*
 		 * We already got the last chunk, so send a null chunk
@@ -347,20 +456,21 @@ TkSelPropProc(eventPtr)
 		numItems = (*selPtr->proc)(selPtr->clientData,
 			incrPtr->converts[i].offset,
 			(long *)(((char *) buffer) + length),
-			TK_SEL_BYTES_AT_ONCE - length, formatType, (Tk_Window) incrPtr->winPtr);
+			incrPtr->chunkSize - length, formatType, (Tk_Window) incrPtr->winPtr);
 		TkSelSetInProgress(ip.nextPtr);
 		if (ip.selPtr == NULL) {
 		    /*
 		     * The selection handler deleted itself.
 		     */
 
+		    ckfree((char *) buffer);
 		    return;
 		}
 		if (numItems < 0) {
 		    numItems = 0;
 		}
 		numItems += length;
-		if (numItems > TK_SEL_BYTES_AT_ONCE) {
+		if (numItems > incrPtr->chunkSize) {
 		    panic("selection handler returned too many bytes");
 		}
 	    }
@@ -392,7 +502,7 @@ TkSelPropProc(eventPtr)
 		if (incrPtr->converts[i].offset == 0) {
 		    encodingCvtFlags |= TCL_ENCODING_START;
 		}
-		if (numItems < TK_SEL_BYTES_AT_ONCE) {
+		if (numItems < incrPtr->chunkSize) {
 		    encodingCvtFlags |= TCL_ENCODING_END;
 		}
 		if (formatType == XA_STRING) {
@@ -488,10 +598,10 @@ TkSelPropProc(eventPtr)
 		 * Set the property to something other than a string
 		 */
 
-		long *propPtr = (long *) ckalloc(TK_SEL_BYTES_AT_ONCE);
+		long *propPtr = (long *) ckalloc((unsigned) incrPtr->chunkSize);
 		numItems = TkSelCvtToX(propPtr, (char *) buffer,
 			formatType, (Tk_Window) incrPtr->winPtr,
-			TK_SEL_BYTES_AT_ONCE);
+			incrPtr->chunkSize);
 
 		XChangeProperty(eventPtr->xproperty.display,
 			eventPtr->xproperty.window,
@@ -519,6 +629,7 @@ TkSelPropProc(eventPtr)
 #endif
 	    }
 	    Tk_DeleteErrorHandler(errorHandler);
+	    ckfree((char *) buffer);
 
 	    /*
 	     * Compute the next offset value.  If this was the last chunk,
@@ -526,7 +637,7 @@ TkSelPropProc(eventPtr)
 	     * then set the offset to -1 to indicate we are done.
 	     */
 
-	    if (numItems < TK_SEL_BYTES_AT_ONCE) {
+	    if (numItems < incrPtr->chunkSize) {
 		if (numItems <= 0) {
 		    incrPtr->converts[i].offset = -1;
 		    incrPtr->numIncrs--;
@@ -622,10 +733,8 @@ TkSelEventProc(tkwin, eventPtr)
 	    }
 	}
 
-	propInfo = NULL;
-	result = XGetWindowProperty(eventPtr->xselection.display,
-		eventPtr->xselection.requestor, retrPtr->property,
-		0, MAX_PROP_WORDS, False, (Atom) AnyPropertyType,
+	result = GetSelProperty(eventPtr->xselection.display,
+		eventPtr->xselection.requestor, retrPtr->property, False,
 		&type, &format, &numItems, &bytesAfter,
 		(unsigned char **) &propInfo);
 	if ((result != Success) || (type == None)) {
@@ -660,7 +769,7 @@ TkSelEventProc(tkwin, eventPtr)
 		return;
 	    }
 
-	    if (numItems >= sizeof(long)*MAX_PROP_WORDS || propData[numItems] != '\0') {
+	    if (propData[numItems] != '\0') {
 		propData = ckalloc((size_t) numItems + 1);
 		strncpy(propData, (char *) propInfo, numItems);
 		propData[numItems] = '\0';
@@ -865,6 +974,7 @@ ConvertSelection(winPtr, eventPtr)
     Atom singleInfo[2];                 /* incr.multAtoms points here except
 					 * for multiple conversions. */
     unsigned i;
+    long *buffer;                       /* Chunk of converted selection. */
     Tk_ErrorHandler errorHandler;
     TkSelectionInfo *infoPtr;
     TkSelInProgress ip;
@@ -909,6 +1019,7 @@ ConvertSelection(winPtr, eventPtr)
 
     incr.winPtr = winPtr;
     incr.selection = eventPtr->selection;
+    incr.chunkSize = TkSelChunkSize((Tk_Window) winPtr);
     if (eventPtr->target != winPtr->dispPtr->multipleAtom) {
 	multiple = 0;
 	singleInfo[0] = reply.target;
@@ -958,9 +1069,9 @@ ConvertSelection(winPtr, eventPtr)
     incr.converts = (ConvertInfo *) ckalloc((unsigned)
 	    (incr.numConversions*sizeof(ConvertInfo)));
     incr.numIncrs = 0;
+    buffer = (long *) ckalloc((unsigned) (incr.chunkSize + sizeof(long)));
     for (i = 0; i < incr.numConversions; i++) {
 	Atom target, property, type = XA_STRING;
-	long buffer[TK_SEL_WORDS_AT_ONCE];
 	register TkSelHandler *selPtr;
 	int numItems, format = 8;
 	char *propPtr = (char *) buffer;
@@ -993,7 +1104,7 @@ ConvertSelection(winPtr, eventPtr)
 	     */
 
 	    numItems = TkSelDefaultSelection(infoPtr, target, buffer,
-		    TK_SEL_BYTES_AT_ONCE, &type, &format);
+		    incr.chunkSize, &type, &format);
 	    if (numItems < 0) {
 		incr.multAtoms[2*i + 1] = None;
 		LangSelectHook("Request",(Tk_Window) winPtr, infoPtr->selection, target, None);
@@ -1013,13 +1124,13 @@ ConvertSelection(winPtr, eventPtr)
 		format = 32;
 	    }
 	    numItems = (*selPtr->proc)(selPtr->clientData, 0,
-		    buffer, TK_SEL_BYTES_AT_ONCE, type, (Tk_Window) winPtr);
+		    buffer, incr.chunkSize, type, (Tk_Window) winPtr);
 	    TkSelSetInProgress(ip.nextPtr);
 	    if ((ip.selPtr == NULL) || (numItems < 0)) {
 		incr.multAtoms[2*i + 1] = None;
 		continue;
 	    }
-	    if (numItems > TK_SEL_BYTES_AT_ONCE) {
+	    if (numItems > incr.chunkSize) {
 		panic("selection handler returned too many bytes");
 	    }
 	    ((char *) buffer)[numItems] = '\0';
@@ -1029,7 +1140,7 @@ ConvertSelection(winPtr, eventPtr)
 	 * Got the selection;  store it back on the requestor's property.
 	 */
 
-	if (numItems == TK_SEL_BYTES_AT_ONCE) {
+	if (numItems == incr.chunkSize) {
 	    /*
 	     * Selection is too big to send at once;  start an
 	     * INCR-mode transfer.
@@ -1037,16 +1148,14 @@ ConvertSelection(winPtr, eventPtr)
 
 	    incr.numIncrs++;
 	    type = winPtr->dispPtr->incrAtom;
-	    buffer[0] = SelectionSize(selPtr, type, (Tk_Window) winPtr);
-	    /* What units is the value we are returning here ?
-               SelctionSize counts numItems things which are
-               expected to be bytes for Tcl world.
-               Size is also size before encoding ...
-             */
-	    if (buffer[0] == 0) {
-		incr.multAtoms[2*i + 1] = None;
-		continue;
-	    }
+
+	    /*
+	     * The ICCCM only asks for a lower bound on the size, so
+	     * rather than running the handler over the whole selection
+	     * just to measure it, report the chunk we already have.
+	     */
+
+	    buffer[0] = incr.chunkSize;
 	    numItems = 1;
 	    propPtr = (char *) buffer;
 	    format = 32;
@@ -1100,6 +1209,8 @@ ConvertSelection(winPtr, eventPtr)
 	}
     }
 
+    ckfree((char *) buffer);
+
     /*
      * Send an event back to the requestor to indicate that the
      * first stage of conversion is complete (everything is done
@@ -1225,11 +1336,10 @@ SelRcvIncrProc(clientData, eventPtr)
 	    || (retrPtr->result != -1)) {
 	return;
     }
-    propInfo = NULL;
-    result = XGetWindowProperty(eventPtr->xproperty.display,
-	    eventPtr->xproperty.window, retrPtr->property, 0, MAX_PROP_WORDS,
-	    True, (Atom) AnyPropertyType, &type, &format, &numItems,
-	    &bytesAfter, (unsigned char **) &propInfo);
+    result = GetSelProperty(eventPtr->xproperty.display,
+	    eventPtr->xproperty.window, retrPtr->property, True,
+	    &type, &format, &numItems, &bytesAfter,
+	    (unsigned char **) &propInfo);
     if ((result != Success) || (type == None)) {
 	return;
     }
@@ -1265,6 +1375,43 @@ SelRcvIncrProc(clientData, eventPtr)
 	interp = retrPtr->interp;
 	Tcl_Preserve((ClientData) interp);
 
+	if ((type == retrPtr->winPtr->dispPtr->utf8Atom)
+		&& (Tcl_DStringLength(&retrPtr->buf) == 0) && (numItems > 0)) {
+	    char *end = propInfo + numItems;
+	    char *lead = end;
+
+	    /*
+	     * UTF-8 needs no conversion, so hand the chunk straight to
+	     * the handler rather than copying it through the encoder.
+	     * Only a character split across the chunk boundary is held
+	     * back for next time.
+	     */
+
+	    while ((lead > propInfo) && (end - lead < TCL_UTF_MAX)
+		    && ((UCHAR(lead[-1]) & 0xC0) == 0x80)) {
+		lead--;
+	    }
+	    if ((lead > propInfo) && (UCHAR(lead[-1]) >= 0xC0)) {
+		lead--;
+		if (Tcl_UtfCharComplete(lead, end - lead)) {
+		    lead = end;
+		}
+	    } else {
+		lead = end;
+	    }
+	    if (lead < end) {
+		Tcl_DStringAppend(&retrPtr->buf, lead, end - lead);
+	    }
+	    result = (*retrPtr->proc)(retrPtr->clientData, interp,
+		    (long *) propInfo, lead - propInfo, format, type,
+		    (Tk_Window) retrPtr->winPtr);
+	    Tcl_Release((ClientData) interp);
+	    if (result != TCL_OK) {
+		retrPtr->result = result;
+	    }
+	    goto done;
+	}
+
 	if (type == retrPtr->winPtr->dispPtr->compoundTextAtom) {
 	    encoding = Tcl_GetEncoding(NULL, "iso2022");
 	} else if (type == retrPtr->winPtr->dispPtr->utf8Atom) {
@@ -1398,54 +1545,6 @@ SelRcvIncrProc(clientData, eventPtr)
     retrPtr->idleTime = 0;
 }
 
-/*
- *----------------------------------------------------------------------
- *
- * SelectionSize --
- *
- *      This procedure is called when the selection is too large to
- *      send in a single buffer;  it computes the total length of
- *      the selection in bytes.
- *
- * Results:
- *      The return value is the number of bytes in the selection
- *      given by selPtr.
- *
- * Side effects:
- *      The selection is retrieved from its current owner (this is
- *      the only way to compute its size).
- *
- *----------------------------------------------------------------------
- */
-
-static int
-SelectionSize(selPtr, type, tkwin)
-    TkSelHandler *selPtr;       /* Information about how to retrieve
-				 * the selection whose size is wanted. */
-    Atom type;
-    Tk_Window tkwin;
-{
-    long buffer[TK_SEL_WORDS_AT_ONCE];
-    int size, chunkSize;
-    TkSelInProgress ip;
-
-    size = TK_SEL_BYTES_AT_ONCE;
-    ip.selPtr = selPtr;
-    ip.nextPtr = TkSelGetInProgress();
-    TkSelSetInProgress(&ip);
-    do {
-	chunkSize = (*selPtr->proc)(selPtr->clientData, size,
-			buffer, TK_SEL_BYTES_AT_ONCE, type, tkwin);
-	if (ip.selPtr == NULL) {
-	    size = 0;
-	    break;
-	}
-	size += chunkSize;
-    } while (chunkSize == TK_SEL_BYTES_AT_ONCE);
-    TkSelSetInProgress(ip.nextPtr);
-    return size;
-}
-
 /*
  *----------------------------------------------------------------------
  *
@@ -31,8 +31,40 @@ typedef struct GroupItem  {
     int numMembers;		/* Number of items in the group */
     int numSlots;		/* Space in the array */
     Tk_Item **members;		/* array of items */
+    int flags;			/* Bbox bookkeeping, see below */
 } GroupItem;
 
+/*
+ * Flag bits for GroupItem:
+ *
+ * GROUP_BBOX_STALE:	Some member lies on the edge of the group's
+ *			bbox and may have shrunk away from it since,
+ *			so the bbox must be recomputed from scratch
+ *			before it is next adjusted.
+ * GROUP_EMPTY:		No visible members; the bbox is just posn.
+ * GROUP_ALWAYS_REDRAW:	Some member (or member of a member group) has
+ *			a type that wants to be displayed even when
+ *			off-screen, so the group can't be culled as a
+ *			whole.
+ */
+
+#define GROUP_BBOX_STALE	1
+#define GROUP_EMPTY		2
+#define GROUP_ALWAYS_REDRAW	4
+
+/*
+ * Decide whether item bbox lies wholly outside a rectangle.
+ */
+
+#define MemberAlwaysRedraw(itemPtr) \
+    (((itemPtr)->typePtr == &ptkCanvGroupType) \
+	? (((GroupItem *) (itemPtr))->flags & GROUP_ALWAYS_REDRAW) \
+	: ((itemPtr)->typePtr->alwaysRedraw & 1))
+
+#define BboxOutside(itemPtr, rx1, ry1, rx2, ry2) \
+    (((itemPtr)->x1 > (rx2)) || ((itemPtr)->x2 < (rx1)) \
+	|| ((itemPtr)->y1 > (ry2)) || ((itemPtr)->y2 < (ry1)))
+
 /*
  * Information used for parsing configuration specs:
  */
@@ -234,6 +266,7 @@ CreateGroup(interp, canvas, itemPtr, argc, args)
     groupPtr->members    = NULL;
     groupPtr->numSlots   = 0;
     groupPtr->numMembers = 0;
+    groupPtr->flags      = GROUP_EMPTY;
 
     /*
      * Process the arguments to fill in the item record.
@@ -436,6 +469,7 @@ Tk_Item *itemPtr;
 		}
 		itemPtr->redraw_flags |= FORCE_REDRAW;
 		groupPtr->numMembers--;
+		groupPtr->flags |= GROUP_BBOX_STALE;
 		itemPtr->group = NULL;
 		return;
 	    }
@@ -478,10 +512,14 @@ ComputeGroupBbox(canvas, groupPtr)
     int seen = 0;
     int i;
 
+    groupPtr->flags = 0;
     canvasPtr->activeGroup = &groupPtr->header;
     for (i=0; i < groupPtr->numMembers; i++) {
 	Tk_Item *subitemPtr = groupPtr->members[i];
 	if (subitemPtr != NULL) {
+	    if (MemberAlwaysRedraw(subitemPtr)) {
+		groupPtr->flags |= GROUP_ALWAYS_REDRAW;
+	    }
 	    if (Tk_GetItemState(canvas, subitemPtr) == TK_STATE_HIDDEN) {
 		continue;
 	    }
@@ -515,6 +553,65 @@ ComputeGroupBbox(canvas, groupPtr)
 	groupPtr->header.y1 = groupPtr->posn[1];
 	groupPtr->header.x2 = groupPtr->header.x1;
 	groupPtr->header.y2 = groupPtr->header.y1;
+	groupPtr->flags |= GROUP_EMPTY;
+    }
+}
+
+/*
+ *--------------------------------------------------------------
+ *
+ * TkGroupUpdateBbox --
+ *
+ *	Called by the canvas (before and after) whenever a member
+ *	of a group may have changed its bounding box.  Rather than
+ *	recomputing the union over all members, the group's bbox is
+ *	grown to take in the member's; a member on the edge of the
+ *	bbox marks it stale, so that it is recomputed only if that
+ *	member may have moved inward.
+ *
+ * Results:
+ *	None.
+ *
+ * Side effects:
+ *	The bbox in the header of itemPtr's group is updated.
+ *
+ *--------------------------------------------------------------
+ */
+
+void
+TkGroupUpdateBbox(canvas, itemPtr)
+    Tk_Canvas canvas;			/* Canvas that contains item. */
+    Tk_Item *itemPtr;			/* Member whose bbox may have
+					 * changed. */
+{
+    GroupItem *groupPtr = (GroupItem *) itemPtr->group;
+    Tk_Item *headerPtr = &groupPtr->header;
+
+    if ((groupPtr->flags & (GROUP_BBOX_STALE|GROUP_EMPTY))
+	    || (Tk_GetItemState(canvas, itemPtr) == TK_STATE_HIDDEN)) {
+	ComputeGroupBbox(canvas, groupPtr);
+    } else {
+	if (itemPtr->x1 < headerPtr->x1) {
+	    headerPtr->x1 = itemPtr->x1;
+	}
+	if (itemPtr->y1 < headerPtr->y1) {
+	    headerPtr->y1 = itemPtr->y1;
+	}
+	if (itemPtr->x2 > headerPtr->x2) {
+	    headerPtr->x2 = itemPtr->x2;
+	}
+	if (itemPtr->y2 > headerPtr->y2) {
+	    headerPtr->y2 = itemPtr->y2;
+	}
+	if (MemberAlwaysRedraw(itemPtr)) {
+	    groupPtr->flags |= GROUP_ALWAYS_REDRAW;
+	}
+    }
+    if ((Tk_GetItemState(canvas, itemPtr) != TK_STATE_HIDDEN)
+	    && ((itemPtr->x1 <= headerPtr->x1) || (itemPtr->y1 <= headerPtr->y1)
+	    || (itemPtr->x2 >= headerPtr->x2)
+	    || (itemPtr->y2 >= headerPtr->y2))) {
+	groupPtr->flags |= GROUP_BBOX_STALE;
     }
 }
 
@@ -561,6 +658,16 @@ DisplayGroup(canvas, itemPtr, display, drawable, x, y, width, height)
 	    if (Tk_GetItemState(canvas, subitemPtr) == TK_STATE_HIDDEN) {
 		continue;
 	    }
+
+	    /*
+	     * Skip members (and whole member groups) that miss the
+	     * area being redrawn.
+	     */
+
+	    if ((drawable != None) && !MemberAlwaysRedraw(subitemPtr)
+		    && BboxOutside(subitemPtr, x, y, x + width, y + height)) {
+		continue;
+	    }
 	    if (drawable != None ||
 		(subitemPtr->typePtr->alwaysRedraw & 1)) {
 		if (subitemPtr->updateCmd) {
@@ -627,7 +734,25 @@ GroupToPoint(canvas, itemPtr, pointPtr)
     for (i=0; i < groupPtr->numMembers; i++) {
 	Tk_Item *subitemPtr = groupPtr->members[i];
 	if (subitemPtr != NULL) {
-	    double try = (*subitemPtr->typePtr->pointProc)(canvas, subitemPtr, pointPtr);
+	    double try, dx, dy;
+
+	    /*
+	     * The distance to a member's bbox is never more than the
+	     * distance to the member, so members (and whole member
+	     * groups) whose bbox is further away than the best so far
+	     * need not be asked.
+	     */
+
+	    dx = (pointPtr[0] < subitemPtr->x1) ? subitemPtr->x1 - pointPtr[0]
+		    : (pointPtr[0] > subitemPtr->x2) ? pointPtr[0] - subitemPtr->x2
+		    : 0.0;
+	    dy = (pointPtr[1] < subitemPtr->y1) ? subitemPtr->y1 - pointPtr[1]
+		    : (pointPtr[1] > subitemPtr->y2) ? pointPtr[1] - subitemPtr->y2
+		    : 0.0;
+	    if (hypot(dx, dy) >= best) {
+		continue;
+	    }
+	    try = (*subitemPtr->typePtr->pointProc)(canvas, subitemPtr, pointPtr);
 	    if (try < best) {
 		best = try;
 		if (best == 0.0) {
@@ -692,7 +817,13 @@ GroupToArea(canvas, itemPtr, areaPtr)
     for (i=0; i < groupPtr->numMembers; i++) {
 	Tk_Item *subitemPtr = groupPtr->members[i];
 	if (subitemPtr != NULL) {
-	    int inner =  (*subitemPtr->typePtr->areaProc)(canvas, subitemPtr, areaPtr);
+	    int inner;
+	    if (BboxOutside(subitemPtr, areaPtr[0], areaPtr[1],
+		    areaPtr[2], areaPtr[3])) {
+		inner = -1;
+	    } else {
+		inner = (*subitemPtr->typePtr->areaProc)(canvas, subitemPtr, areaPtr);
+	    }
 	    if (inner < 0)   /* outside */
 		seen &= ~ALL_INSIDE;  /* clear the inside option */
 	    if (inner == 0)  /* overlap */
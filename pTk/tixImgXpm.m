@@ -30,5 +30,9 @@
 #  define TixpXpmSetPixel (*TiximgxpmVptr->V_TixpXpmSetPixel)
 #endif
 
+#ifndef TixpXpmSetRow
+#  define TixpXpmSetRow (*TiximgxpmVptr->V_TixpXpmSetRow)
+#endif
+
 #endif /* NO_VTABLES */
 #endif /* _TIXIMGXPM_VM */
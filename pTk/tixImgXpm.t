@@ -46,4 +46,11 @@ VFUNC(void,TixpXpmSetPixel,V_TixpXpmSetPixel,_ANSI_ARGS_((
 			    int * isTranspPtr)))
 #endif /* #ifndef TixpXpmSetPixel */
 
+#ifndef TixpXpmSetRow
+VFUNC(void,TixpXpmSetRow,V_TixpXpmSetRow,_ANSI_ARGS_((
+			    PixmapInstance * instancePtr, XImage * image,
+			    XImage * mask, int y, int * indexPtr,
+			    int * isTranspPtr)))
+#endif /* #ifndef TixpXpmSetRow */
+
 #endif /* _TIXIMGXPM */
@@ -12,10 +12,21 @@ EXTERN void		LangAsyncCheck _ANSI_ARGS_((void));
 EXTERN void		LangFreeCallback _ANSI_ARGS_((LangCallback *));
 EXTERN LangCallback *	LangMakeCallback _ANSI_ARGS_((Tcl_Obj *));
 EXTERN Tcl_Obj *		LangOldCallbackArg _ANSI_ARGS_((LangCallback *,char *,int));
+EXTERN void		LangProfileIteration _ANSI_ARGS_((double start,
+			    int depth));
+EXTERN void		LangProfileRecord _ANSI_ARGS_((CONST char *kind,
+			    CONST char *name, VOID *proc, double start));
+EXTERN void		LangProfileSample _ANSI_ARGS_((int histogram,
+			    double value));
+EXTERN double		LangProfileStart _ANSI_ARGS_((void));
+EXTERN int		LangProfiling _ANSI_ARGS_((void));
 EXTERN void		LangPushCallbackArgs _ANSI_ARGS_((LangCallback **svp));
 EXTERN long Lang_OSHandle _ANSI_ARGS_((int fd));
 EXTERN void		Tcl_AlertNotifier _ANSI_ARGS_((ClientData clientData));
 EXTERN char *		Tcl_Alloc _ANSI_ARGS_((unsigned int size));
+EXTERN char *		Tcl_ArenaAlloc _ANSI_ARGS_((unsigned int size));
+EXTERN ClientData	Tcl_ArenaMark _ANSI_ARGS_((void));
+EXTERN void		Tcl_ArenaRelease _ANSI_ARGS_((ClientData mark));
 EXTERN Tcl_AsyncHandler	 Tcl_AsyncCreate _ANSI_ARGS_((Tcl_AsyncProc * proc,
 				ClientData clientData));
 EXTERN void		Tcl_AsyncDelete _ANSI_ARGS_((Tcl_AsyncHandler async));
@@ -71,6 +82,7 @@ EXTERN Tcl_ThreadId	Tcl_GetCurrentThread _ANSI_ARGS_((void));
 EXTERN int		Tcl_GetServiceMode _ANSI_ARGS_((void));
 EXTERN VOID *		Tcl_GetThreadData _ANSI_ARGS_((
 				Tcl_ThreadDataKey * keyPtr, int size));
+EXTERN int		Tcl_HoldIdle _ANSI_ARGS_((int delta));
 EXTERN ClientData	Tcl_InitNotifier _ANSI_ARGS_((void));
 EXTERN void		Tcl_Panic _ANSI_ARGS_((CONST char *,...));
 EXTERN void		Tcl_QueueEvent _ANSI_ARGS_((Tcl_Event *evPtr,
@@ -111,6 +123,17 @@ EXTERN void             TclpExit _ANSI_ARGS_((int status));
 #define LangNoteOwner(owner,packet)
 #endif
 
+/*
+ * Histograms kept by LangProfileSample; see Tk::Event::HistogramData.
+ */
+
+#define LANG_HIST_ITERATION	0	/* Microseconds per Tcl_DoOneEvent */
+#define LANG_HIST_HANDLER	1	/* Microseconds per event, idle or
+					 * timer handler */
+#define LANG_HIST_LATENESS	2	/* Microseconds timers fire late */
+#define LANG_HIST_IDLEQUEUE	3	/* Idle handlers per idle pass */
+#define LANG_HIST_COUNT		4
+
 #ifndef TCL_TSD_INIT
 #define TCL_TSD_INIT(keyPtr)	(ThreadSpecificData *)Tcl_GetThreadData((keyPtr), sizeof(ThreadSpecificData))
 #endif
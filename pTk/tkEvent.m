@@ -38,6 +38,26 @@
 #  define LangOldCallbackArg (*TkeventVptr->V_LangOldCallbackArg)
 #endif
 
+#ifndef LangProfileIteration
+#  define LangProfileIteration (*TkeventVptr->V_LangProfileIteration)
+#endif
+
+#ifndef LangProfileRecord
+#  define LangProfileRecord (*TkeventVptr->V_LangProfileRecord)
+#endif
+
+#ifndef LangProfileSample
+#  define LangProfileSample (*TkeventVptr->V_LangProfileSample)
+#endif
+
+#ifndef LangProfileStart
+#  define LangProfileStart (*TkeventVptr->V_LangProfileStart)
+#endif
+
+#ifndef LangProfiling
+#  define LangProfiling (*TkeventVptr->V_LangProfiling)
+#endif
+
 #ifndef LangPushCallbackArgs
 #  define LangPushCallbackArgs (*TkeventVptr->V_LangPushCallbackArgs)
 #endif
@@ -58,6 +78,18 @@
 #  define Tcl_Alloc (*TkeventVptr->V_Tcl_Alloc)
 #endif
 
+#ifndef Tcl_ArenaAlloc
+#  define Tcl_ArenaAlloc (*TkeventVptr->V_Tcl_ArenaAlloc)
+#endif
+
+#ifndef Tcl_ArenaMark
+#  define Tcl_ArenaMark (*TkeventVptr->V_Tcl_ArenaMark)
+#endif
+
+#ifndef Tcl_ArenaRelease
+#  define Tcl_ArenaRelease (*TkeventVptr->V_Tcl_ArenaRelease)
+#endif
+
 #ifndef Tcl_AsyncCreate
 #  define Tcl_AsyncCreate (*TkeventVptr->V_Tcl_AsyncCreate)
 #endif
@@ -190,6 +222,10 @@
 #  define Tcl_GetTime (*TkeventVptr->V_Tcl_GetTime)
 #endif
 
+#ifndef Tcl_HoldIdle
+#  define Tcl_HoldIdle (*TkeventVptr->V_Tcl_HoldIdle)
+#endif
+
 #ifndef Tcl_InitNotifier
 #  define Tcl_InitNotifier (*TkeventVptr->V_Tcl_InitNotifier)
 #endif
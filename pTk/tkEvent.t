@@ -35,6 +35,29 @@ VFUNC(LangCallback *,LangMakeCallback,V_LangMakeCallback,_ANSI_ARGS_((Tcl_Obj *)
 VFUNC(Tcl_Obj *,LangOldCallbackArg,V_LangOldCallbackArg,_ANSI_ARGS_((LangCallback *,char *,int)))
 #endif /* #ifndef LangOldCallbackArg */
 
+#ifndef LangProfileIteration
+VFUNC(void,LangProfileIteration,V_LangProfileIteration,_ANSI_ARGS_((double start,
+			    int depth)))
+#endif /* #ifndef LangProfileIteration */
+
+#ifndef LangProfileRecord
+VFUNC(void,LangProfileRecord,V_LangProfileRecord,_ANSI_ARGS_((CONST char *kind,
+			    CONST char *name, VOID *proc, double start)))
+#endif /* #ifndef LangProfileRecord */
+
+#ifndef LangProfileSample
+VFUNC(void,LangProfileSample,V_LangProfileSample,_ANSI_ARGS_((int histogram,
+			    double value)))
+#endif /* #ifndef LangProfileSample */
+
+#ifndef LangProfileStart
+VFUNC(double,LangProfileStart,V_LangProfileStart,_ANSI_ARGS_((void)))
+#endif /* #ifndef LangProfileStart */
+
+#ifndef LangProfiling
+VFUNC(int,LangProfiling,V_LangProfiling,_ANSI_ARGS_((void)))
+#endif /* #ifndef LangProfiling */
+
 #ifndef LangPushCallbackArgs
 VFUNC(void,LangPushCallbackArgs,V_LangPushCallbackArgs,_ANSI_ARGS_((LangCallback **svp)))
 #endif /* #ifndef LangPushCallbackArgs */
@@ -56,6 +79,18 @@ VFUNC(void,Tcl_AlertNotifier,V_Tcl_AlertNotifier,_ANSI_ARGS_((ClientData clientD
 VFUNC(char *,Tcl_Alloc,V_Tcl_Alloc,_ANSI_ARGS_((unsigned int size)))
 #endif /* #ifndef Tcl_Alloc */
 
+#ifndef Tcl_ArenaAlloc
+VFUNC(char *,Tcl_ArenaAlloc,V_Tcl_ArenaAlloc,_ANSI_ARGS_((unsigned int size)))
+#endif /* #ifndef Tcl_ArenaAlloc */
+
+#ifndef Tcl_ArenaMark
+VFUNC(ClientData,Tcl_ArenaMark,V_Tcl_ArenaMark,_ANSI_ARGS_((void)))
+#endif /* #ifndef Tcl_ArenaMark */
+
+#ifndef Tcl_ArenaRelease
+VFUNC(void,Tcl_ArenaRelease,V_Tcl_ArenaRelease,_ANSI_ARGS_((ClientData mark)))
+#endif /* #ifndef Tcl_ArenaRelease */
+
 #ifndef Tcl_AsyncCreate
 VFUNC(Tcl_AsyncHandler,Tcl_AsyncCreate,V_Tcl_AsyncCreate,_ANSI_ARGS_((Tcl_AsyncProc * proc,
 				ClientData clientData)))
@@ -213,6 +248,10 @@ VFUNC(VOID *,Tcl_GetThreadData,V_Tcl_GetThreadData,_ANSI_ARGS_((
 VFUNC(void,Tcl_GetTime,V_Tcl_GetTime,_ANSI_ARGS_((Tcl_Time *time)))
 #endif /* #ifndef Tcl_GetTime */
 
+#ifndef Tcl_HoldIdle
+VFUNC(int,Tcl_HoldIdle,V_Tcl_HoldIdle,_ANSI_ARGS_((int delta)))
+#endif /* #ifndef Tcl_HoldIdle */
+
 #ifndef Tcl_InitNotifier
 VFUNC(ClientData,Tcl_InitNotifier,V_Tcl_InitNotifier,_ANSI_ARGS_((void)))
 #endif /* #ifndef Tcl_InitNotifier */
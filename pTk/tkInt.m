@@ -9,6 +9,10 @@
 #define tkFontObjType (*TkintVptr->V_tkFontObjType)
 #define tkOptionObjType (*TkintVptr->V_tkOptionObjType)
 #define tkStateKeyObjType (*TkintVptr->V_tkStateKeyObjType)
+#ifndef TkBufferPixmapCleanup
+#  define TkBufferPixmapCleanup (*TkintVptr->V_TkBufferPixmapCleanup)
+#endif
+
 #ifndef TkCanvPostscriptCmd
 #  define TkCanvPostscriptCmd (*TkintVptr->V_TkCanvPostscriptCmd)
 #endif
@@ -21,10 +25,26 @@
 #  define TkEventInit (*TkintVptr->V_TkEventInit)
 #endif
 
+#ifndef TkFreeBufferPixmap
+#  define TkFreeBufferPixmap (*TkintVptr->V_TkFreeBufferPixmap)
+#endif
+
+#ifndef TkGetBufferPixmap
+#  define TkGetBufferPixmap (*TkintVptr->V_TkGetBufferPixmap)
+#endif
+
+#ifndef TkGetBufferPixmapStats
+#  define TkGetBufferPixmapStats (*TkintVptr->V_TkGetBufferPixmapStats)
+#endif
+
 #ifndef TkGetDoublePixels
 #  define TkGetDoublePixels (*TkintVptr->V_TkGetDoublePixels)
 #endif
 
+#ifndef TkGetGIFFrameInfo
+#  define TkGetGIFFrameInfo (*TkintVptr->V_TkGetGIFFrameInfo)
+#endif
+
 #ifndef TkOffsetParseProc
 #  define TkOffsetParseProc (*TkintVptr->V_TkOffsetParseProc)
 #endif
@@ -41,6 +61,14 @@
 #  define TkOrientPrintProc (*TkintVptr->V_TkOrientPrintProc)
 #endif
 
+#ifndef TkPhotoCacheLimit
+#  define TkPhotoCacheLimit (*TkintVptr->V_TkPhotoCacheLimit)
+#endif
+
+#ifndef TkPhotoCacheStats
+#  define TkPhotoCacheStats (*TkintVptr->V_TkPhotoCacheStats)
+#endif
+
 #ifndef TkPixelParseProc
 #  define TkPixelParseProc (*TkintVptr->V_TkPixelParseProc)
 #endif
@@ -113,6 +141,10 @@
 #  define Tk_StatePrintProc (*TkintVptr->V_Tk_StatePrintProc)
 #endif
 
+#ifndef Tk_TableObjCmd
+#  define Tk_TableObjCmd (*TkintVptr->V_Tk_TableObjCmd)
+#endif
+
 #ifndef Tk_TkwaitObjCmd
 #  define Tk_TkwaitObjCmd (*TkintVptr->V_Tk_TkwaitObjCmd)
 #endif
@@ -6,6 +6,11 @@ VVAR(Tcl_ObjType,tkCursorObjType,V_tkCursorObjType)
 VVAR(Tcl_ObjType,tkFontObjType,V_tkFontObjType)
 VVAR(Tcl_ObjType,tkOptionObjType,V_tkOptionObjType)
 VVAR(Tcl_ObjType,tkStateKeyObjType,V_tkStateKeyObjType)
+#ifndef TkBufferPixmapCleanup
+VFUNC(void,TkBufferPixmapCleanup,V_TkBufferPixmapCleanup,_ANSI_ARGS_((
+			    TkDisplay *dispPtr)))
+#endif /* #ifndef TkBufferPixmapCleanup */
+
 #ifndef TkCanvPostscriptCmd
 VFUNC(int,TkCanvPostscriptCmd,V_TkCanvPostscriptCmd,_ANSI_ARGS_((struct TkCanvas *canvasPtr,
 			    Tcl_Interp *interp, int argc, CONST84 Tcl_Obj *CONST *objv)))
@@ -19,12 +24,34 @@ VFUNC(int,TkCreateMenuCmd,V_TkCreateMenuCmd,_ANSI_ARGS_((Tcl_Interp *interp)))
 VFUNC(void,TkEventInit,V_TkEventInit,_ANSI_ARGS_((void)))
 #endif /* #ifndef TkEventInit */
 
+#ifndef TkFreeBufferPixmap
+VFUNC(void,TkFreeBufferPixmap,V_TkFreeBufferPixmap,_ANSI_ARGS_((Tk_Window tkwin,
+			    Pixmap pixmap)))
+#endif /* #ifndef TkFreeBufferPixmap */
+
+#ifndef TkGetBufferPixmap
+VFUNC(Pixmap,TkGetBufferPixmap,V_TkGetBufferPixmap,_ANSI_ARGS_((Tk_Window tkwin,
+			    int width, int height)))
+#endif /* #ifndef TkGetBufferPixmap */
+
+#ifndef TkGetBufferPixmapStats
+VFUNC(void,TkGetBufferPixmapStats,V_TkGetBufferPixmapStats,_ANSI_ARGS_((Tk_Window tkwin,
+			    double *statsPtr)))
+#endif /* #ifndef TkGetBufferPixmapStats */
+
 #ifndef TkGetDoublePixels
 VFUNC(int,TkGetDoublePixels,V_TkGetDoublePixels,_ANSI_ARGS_((Tcl_Interp *interp,
 			    Tk_Window tkwin, CONST char *string,
 			    double *doublePtr)))
 #endif /* #ifndef TkGetDoublePixels */
 
+#ifndef TkGetGIFFrameInfo
+VFUNC(int,TkGetGIFFrameInfo,V_TkGetGIFFrameInfo,_ANSI_ARGS_((Tcl_Interp *interp,
+			    Tcl_Obj *source, int isData,
+			    TkGIFFrameInfo **framesPtr, int *numFramesPtr,
+			    int *loopPtr)))
+#endif /* #ifndef TkGetGIFFrameInfo */
+
 #ifndef TkOffsetParseProc
 VFUNC(int,TkOffsetParseProc,V_TkOffsetParseProc,_ANSI_ARGS_((
 			    ClientData clientData, Tcl_Interp *interp,
@@ -53,6 +80,14 @@ VFUNC(Tcl_Obj *,TkOrientPrintProc,V_TkOrientPrintProc,_ANSI_ARGS_((
 			    Tcl_FreeProc **freeProcPtr)))
 #endif /* #ifndef TkOrientPrintProc */
 
+#ifndef TkPhotoCacheLimit
+VFUNC(long,TkPhotoCacheLimit,V_TkPhotoCacheLimit,_ANSI_ARGS_((long limit)))
+#endif /* #ifndef TkPhotoCacheLimit */
+
+#ifndef TkPhotoCacheStats
+VFUNC(void,TkPhotoCacheStats,V_TkPhotoCacheStats,_ANSI_ARGS_((double *statsPtr)))
+#endif /* #ifndef TkPhotoCacheStats */
+
 #ifndef TkPixelParseProc
 VFUNC(int,TkPixelParseProc,V_TkPixelParseProc,_ANSI_ARGS_((
 			    ClientData clientData, Tcl_Interp *interp,
@@ -167,6 +202,12 @@ VFUNC(Tcl_Obj *,Tk_StatePrintProc,V_Tk_StatePrintProc,_ANSI_ARGS_((
 			    Tcl_FreeProc **freeProcPtr)))
 #endif /* #ifndef Tk_StatePrintProc */
 
+#ifndef Tk_TableObjCmd
+VFUNC(int,Tk_TableObjCmd,V_Tk_TableObjCmd,_ANSI_ARGS_((ClientData clientData,
+			    Tcl_Interp *interp, int objc,
+			    Tcl_Obj *CONST objv[])))
+#endif /* #ifndef Tk_TableObjCmd */
+
 #ifndef Tk_TkwaitObjCmd
 VFUNC(int,Tk_TkwaitObjCmd,V_Tk_TkwaitObjCmd,_ANSI_ARGS_((ClientData clientData,
 			    Tcl_Interp *interp, int objc,
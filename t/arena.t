@@ -0,0 +1,67 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Short-lived allocations taken from the event loop's arena.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 8;
+
+sub delta {
+    my ($code) = @_;
+    my $before = Tk::Event::AllocStats();
+    $code->();
+    my $after = Tk::Event::AllocStats();
+    return { map { $_ => $after->{$_} - $before->{$_} } keys %$after };
+}
+
+my $s = Tk::Event::AllocStats();
+is_deeply [sort keys %$s], [qw(arena arenablocks ckalloc)], 'AllocStats keys';
+
+my $c = $mw->Canvas->pack;
+my @id = map { $c->createLine(0, $_, 10, $_, -tags => ['a', "t$_"]) } 1..10;
+$c->find(withtag => 'a');
+
+my $d = delta(sub { $c->find(withtag => 'a') for 1..50 });
+cmp_ok $d->{arena}, '>=', 50, 'canvas tag search uses the arena';
+cmp_ok $d->{arenablocks}, '<=', 1, 'arena blocks are re-used';
+is_deeply [$c->find(withtag => 'a && !t3')], [grep { $_ != $id[2] } @id],
+	  'tag expression search still works';
+
+my $t = $mw->Text->pack;
+$t->tagConfigure('x', -foreground => 'red');
+$t->tagConfigure('y', -underline => 1);
+$t->insert('end', "plain ");
+$t->insert('end', "red\n", 'x', "both\n", ['x', 'y']);
+$mw->update;
+
+is_deeply [$t->tagNames('1.7')], ['x'], 'tag names at index';
+is_deeply [$t->tagNames('2.1')], ['x', 'y'], 'several tags at index';
+is_deeply [$t->tagNames('1.0')], [], 'no tags at index';
+
+$d = delta(sub { $t->tagNames('2.1') for 1..50 });
+cmp_ok $d->{arena}, '>=', 50, 'text tag lookup uses the arena';
+
+$mw->destroy;
+
+__END__
@@ -0,0 +1,78 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Holding back idle redisplay and layout with batch.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 12;
+
+my $l = $mw->Label(-text => 'x')->pack;
+$mw->update;
+my $w0 = $l->width;
+
+my $ran = 0;
+my $r = $mw->batch(sub {
+    $l->configure(-text => 'x' x 40);
+    $mw->afterIdle(sub { $ran++ });
+    $mw->update;
+    is $l->width, $w0, 'no layout inside batch';
+    is $ran, 0, 'idle callbacks held inside batch';
+    is Tk::Event::HoldIdle(), 1, 'hold count inside batch';
+    42;
+});
+is $r, 42, 'result of code returned';
+cmp_ok $l->width, '>', $w0, 'layout done after batch';
+is $ran, 1, 'idle callback run after batch';
+
+$mw->batch(sub {
+    $mw->batch(sub { $l->configure(-text => 'x') });
+    $mw->update;
+    cmp_ok $l->width, '>', $w0, 'nested batch does not release the hold';
+});
+
+# Waiting inside a batch must not freeze the application: the hold is
+# lifted while the nested event loop blocks, and back afterwards.
+$l->configure(-text => 'x');
+$mw->update;
+$ran = 0;
+$mw->batch(sub {
+    $l->configure(-text => 'x' x 40);
+    $mw->afterIdle(sub { $ran++ });
+    my $done = 0;
+    $mw->after(50, sub { $done = 1 });
+    $mw->waitVariable(\$done);
+    is $ran, 1, 'idle callbacks run while waiting inside batch';
+    cmp_ok $l->width, '>', $w0, 'layout done while waiting inside batch';
+    is Tk::Event::HoldIdle(), 1, 'hold restored after the wait';
+    $mw->afterIdle(sub { $ran++ });
+    $mw->update;
+    is $ran, 1, 'held again after the wait';
+});
+
+eval { $mw->batch(sub { die "oops\n" }) };
+is Tk::Event::HoldIdle(), 0, 'hold released when code dies';
+
+$mw->destroy;
+
+__END__
@@ -0,0 +1,56 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Canvas redraws only the damaged rectangles, not their bounding box.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 6;
+
+my $c = $mw->Canvas(-width => 400, -height => 400, -highlightthickness => 0,
+		    -borderwidth => 0)->pack;
+my $r1 = $c->createRectangle(5, 5, 15, 15, -fill => 'red');
+my $r2 = $c->createRectangle(380, 380, 390, 390, -fill => 'red');
+$mw->update;
+
+my @stats = $c->redrawstats('reset');
+is scalar(@stats), 3, 'three counters';
+is_deeply [$c->redrawstats], [0, 0, 0], 'reset clears counters';
+
+$c->itemconfigure($r1, -fill => 'blue');
+$c->itemconfigure($r2, -fill => 'blue');
+$mw->idletasks;
+my ($count, $rects, $pixels) = $c->redrawstats('reset');
+is $count, 1, 'one redisplay';
+is $rects, 2, 'corners repainted separately';
+cmp_ok $pixels, '<', 400*400/10, 'only a small part repainted';
+
+$c->itemconfigure($r1, -fill => 'green');
+$c->itemconfigure($r1, -fill => 'yellow');
+$mw->idletasks;
+(undef, $rects) = $c->redrawstats;
+is $rects, 1, 'repeated damage merged';
+
+$mw->destroy;
+
+__END__
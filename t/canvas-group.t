@@ -0,0 +1,57 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Bounding boxes of canvas group items as their members change.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 7;
+
+my $c = $mw->Canvas(-width => 200, -height => 200)->pack;
+my @r = map { $c->createRectangle(10*$_, 10*$_, 10*$_+20, 10*$_+20) } 1..5;
+my $g = $c->createGroup([0,0], -members => [@r]);
+is_deeply [$c->bbox($g)], [$c->bbox(@r)], 'group bbox is union of members';
+
+$c->move($r[2], 5, 5);
+is_deeply [$c->bbox($g)], [$c->bbox(@r)], 'interior member moved';
+
+$c->move($r[4], 100, 0);
+is_deeply [$c->bbox($g)], [$c->bbox(@r)], 'group grows with member';
+
+$c->move($r[4], -100, 0);
+is_deeply [$c->bbox($g)], [$c->bbox(@r)], 'group shrinks back';
+
+$c->itemconfigure($r[0], -state => 'hidden');
+is_deeply [$c->bbox($g)], [$c->bbox(@r[1..4])], 'hidden member ignored';
+$c->itemconfigure($r[0], -state => 'normal');
+
+my $outer = $c->createGroup([0,0], -members => [$g]);
+$c->move($r[3], 0, 50);
+is_deeply [$c->bbox($outer)], [$c->bbox(@r)], 'nested group follows member';
+
+$c->move($g, 20, 20);
+is_deeply [$c->bbox($outer)], [$c->bbox(@r)], 'moving a group';
+
+$mw->destroy;
+
+__END__
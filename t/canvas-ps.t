@@ -0,0 +1,127 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Image data in canvas Postscript: photos are written as ASCII85,
+# other images as hex, and output sent to a -channel matches what
+# is otherwise returned.
+#
+
+use strict;
+
+use Tk;
+use Tk::Pixmap;
+use File::Temp qw(tempdir);
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 9;
+
+sub ascii85 {
+    my ($s) = @_;
+    $s =~ s/\s+//g;
+    $s =~ s/~>$// or return;
+    $s =~ s/z/!!!!!/g;
+    my $out = '';
+    while (length $s) {
+	my $group = substr($s, 0, 5, '');
+	my $n = length($group) - 1;
+	$group .= 'u' x (4 - $n);
+	my $v = 0;
+	$v = $v * 85 + ord($_) - 33 for split //, $group;
+	$out .= substr(pack('N', $v), 0, $n);
+    }
+    $out;
+}
+
+my $c = $mw->Canvas(-width => 40, -height => 40,
+		    -highlightthickness => 0, -borderwidth => 0)->pack;
+$mw->update;
+
+# Each row of a photo is its alpha bytes then its pixels.  Black
+# pixels at the start of a row give whole groups of zero bytes.
+my @rows = (['#000000', '#000000', '#000000', '#000000'],
+	    ['#ff0000', '#00ff00', '#0000ff', '#123456']);
+my $photo = $mw->Photo(-width => 4, -height => 2);
+$photo->put(\@rows);
+my $id = $c->createImage(0, 0, -image => $photo, -anchor => 'nw');
+
+my $ps = $c->postscript(-colormode => 'color');
+my ($data) = $ps =~ /1 TkPhoto\n(.*?~>)/s;
+like $data, qr/zzz/, 'zero bytes as z';
+my $want = join '', map {
+    my $y = $_;
+    ("\xff" x 4) . join '', map { pack 'C3', $photo->get($_, $y) } 0..3;
+} 0..$#rows;
+is ascii85($data), $want, 'ASCII85 decodes to the photo';
+
+# In gray mode a 3x1 photo is 6 bytes, leaving a short final group.
+my $gray = $mw->Photo(-width => 3, -height => 1);
+$gray->put([['#ffffff', '#000000', '#808080']]);
+$c->itemconfigure($id, -image => $gray);
+$ps = $c->postscript(-colormode => 'gray');
+($data) = $ps =~ /1 TkPhoto\n(.*?~>)/s;
+(my $bare = $data) =~ s/\s+//g;
+is length($bare), 5 + 3 + 2, 'short final group';
+is ascii85($data), "\xff\xff\xff\xff\x00\x80", 'short group decodes';
+
+# Images without Postscript of their own are drawn and written in hex,
+# bottom row first.
+my $xpm = $mw->Pixmap(-data => <<'EOX');
+/* XPM */
+static char *x[] = {
+"3 2 2 1",
+"a c #FF0000",
+"b c #0000FF",
+"aba",
+"bab"};
+EOX
+$c->itemconfigure($id, -image => $xpm);
+$mw->update;
+$ps = $c->postscript(-colormode => 'color');
+($data) = $ps =~ /matrix \{\n<([^>]*)>/;
+$data =~ s/\s+//g;
+is $data, join('', map { uc unpack 'H*', $_ }
+		   "\x00\x00\xff\xff\x00\x00\x00\x00\xff",
+		   "\xff\x00\x00\x00\x00\xff\xff\x00\x00"),
+    'hex data of a drawn image';
+
+# The same document through a channel, for a photo spanning several
+# encoder buffers.
+my $big = $mw->Photo(-width => 40, -height => 40);
+$big->put([map { [map { sprintf '#%02x%02x%02x', $_ * 6, $_ * 3, 255 - $_ } 0..39] } 0..39]);
+$c->itemconfigure($id, -image => $big);
+my $file = tempdir(CLEANUP => 1) . '/canvas.ps';
+$ps = $c->postscript(-colormode => 'color');
+open(PS, '>', $file) or die "$file: $!";
+ok !$c->postscript(-colormode => 'color', -channel => *PS),
+    'nothing returned with -channel';
+close PS;
+open(PS, '<', $file) or die "$file: $!";
+binmode PS;
+my $written = do { local $/; <PS> };
+close PS;
+s/^%%CreationDate:.*\n//m for $ps, $written;
+cmp_ok length($ps), '>', 2 * 4096, 'several buffers';
+ok $written eq $ps, 'channel output same as the result';
+
+eval { $c->postscript(-channel => 'no::such::handle') };
+like $@, qr/can not find channel named "no::such::handle"/, 'unknown channel';
+
+$mw->destroy;
+
+__END__
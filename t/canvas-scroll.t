@@ -0,0 +1,126 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Scrolling a canvas copies what stays in view and redraws only the
+# strips that come into view, unless something in the window would
+# not move with the copy.  Either way the window must end up as a full
+# redraw would leave it.
+#
+
+use strict;
+
+use Tk;
+use Tk::WinPhoto;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 10;
+
+my $size = 100;
+
+sub canvas {
+    my $c = $mw->Canvas(-width => $size, -height => $size,
+			-highlightthickness => 0, -borderwidth => 0,
+			-scrollregion => [0, 0, 1000, 1000],
+			-xscrollincrement => 1, -yscrollincrement => 1, @_)
+	->pack(-side => 'left');
+    for my $i (0..19) {
+	for my $j (0..19) {
+	    $c->createRectangle($i * 50, $j * 50, $i * 50 + 30, $j * 50 + 20,
+				-fill => sprintf('#%02x%02x80', $i * 12, $j * 12),
+				-outline => '');
+	}
+    }
+    $mw->update;
+    $c;
+}
+
+# Scroll by (7,3), returning the pixels painted and the number of
+# pixels which differ from a full redraw of the new view.
+sub scroll {
+    my ($c) = @_;
+    $c->redrawstats('reset');
+    $c->xview(scroll => 7, 'units');
+    $c->yview(scroll => 3, 'units');
+    $mw->idletasks;
+    my (undef, undef, $pixels) = $c->redrawstats('reset');
+    my $got = $mw->Photo(-format => 'Window', -data => oct($c->id));
+    $c->configure(-background => $c->cget(-background));
+    $mw->idletasks;
+    my $want = $mw->Photo(-format => 'Window', -data => oct($c->id));
+    my $bad = 0;
+    for my $y (0..$size - 1) {
+	for my $x (0..$size - 1) {
+	    $bad++ if join(',', $got->get($x, $y)) ne join(',', $want->get($x, $y));
+	}
+    }
+    $_->delete for $got, $want;
+    ($pixels, $bad);
+}
+
+my $full = $size * $size;
+my $strips = 7 * $size + 3 * $size;
+
+SKIP: {
+    skip "screen depth below 24", 10 if $mw->depth < 24;
+
+    my $c = canvas();
+    my ($pixels, $bad) = scroll($c);
+    cmp_ok $pixels, '<=', $strips, 'plain: only the new strips painted';
+    is $bad, 0, 'plain: same as a full redraw';
+    $c->destroy;
+
+    my $tile = $mw->Photo(-width => 11, -height => 13);
+    $tile->put([map { my $y = $_; [map { sprintf '#%02x%02x%02x', 20 * $_, 18 * $y, 200 } 0..10] } 0..12]);
+
+    # A tile anchored to the canvas moves with the contents...
+    $c = canvas(-tile => $tile);
+    ($pixels, $bad) = scroll($c);
+    cmp_ok $pixels, '<=', $strips, 'tile: only the new strips painted';
+    is $bad, 0, 'tile: same as a full redraw';
+    $c->destroy;
+
+    # ... but one placed relative to the toplevel stays where it is.
+    $c = canvas(-tile => $tile, -offset => ['#', 0, 0]);
+    ($pixels, $bad) = scroll($c);
+    cmp_ok $pixels, '>=', $full, 'relative tile: whole window painted';
+    is $bad, 0, 'relative tile: same as a full redraw';
+    $c->destroy;
+
+    # Only the tile in use counts.
+    $c = canvas(-disabledtile => $tile, -offset => ['#', 0, 0]);
+    ($pixels, $bad) = scroll($c);
+    cmp_ok $pixels, '<=', $strips, 'unused disabled tile: copied';
+    $c->destroy;
+
+    # Window items must be moved, so are not copied.
+    $c = canvas();
+    my $f = $c->Frame(-width => 20, -height => 20, -background => 'red');
+    $c->createWindow(40, 40, -window => $f, -anchor => 'nw');
+    $mw->update;
+    ($pixels, $bad) = scroll($c);
+    cmp_ok $pixels, '>=', $full, 'window item: whole window painted';
+    is $bad, 0, 'window item: same as a full redraw';
+    $mw->update;
+    is join(',', $f->x, $f->y), '33,37', 'window item moved';
+    $c->destroy;
+}
+
+$mw->destroy;
+
+__END__
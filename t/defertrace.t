@@ -0,0 +1,83 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Widget updates from variables marked with Tk::DeferTrace.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 10;
+
+my $count = 0;
+my $l = $mw->Label(-textvariable => \$count)->pack;
+ok !Tk::DeferTrace(\$count, 1), 'not deferred to start with';
+ok Tk::DeferTrace(\$count), 'now deferred';
+
+# The label's text is the variable itself, so look at its size to
+# see when it has been told of a change.
+my $width = $l->reqwidth;
+my $before = Tk::SuppressedTraces();
+$count++ for 1..100;
+is $l->reqwidth, $width, 'label not updated yet';
+$mw->idletasks;
+cmp_ok $l->reqwidth, '>', $width, 'label updated at idle time';
+is Tk::SuppressedTraces() - $before, 99, 'suppressed updates counted';
+
+Tk::DeferTrace(\$count, 0);
+$width = $l->reqwidth;
+$count = 100000;
+cmp_ok $l->reqwidth, '>', $width, 'immediate again';
+
+my $on = 0;
+my $cb = $mw->Checkbutton(-variable => \$on)->pack;
+Tk::DeferTrace(\$on, 1);
+$on = 1;
+$cb->destroy;
+$mw->idletasks;
+pass 'widget destroyed with an update pending';
+
+# The deferred update may drop the trace it is running for: this
+# entry's validation moves it to another variable.
+my ($old, $new) = ('a', 'b');
+my $e;
+$e = $mw->Entry(-textvariable => \$old, -validate => 'all',
+    -validatecommand => sub {
+	$e->configure(-textvariable => \$new) if $e;
+	1;
+    })->pack;
+Tk::DeferTrace(\$old, 1);
+$old = 'c';
+$mw->idletasks;
+is $e->get, 'c', 'trace dropped by its own update';
+$old = 'd';
+$mw->idletasks;
+is $e->get, 'c', 'old variable no longer traced';
+$e->destroy;
+
+$l->destroy;
+$count = 6;
+$mw->idletasks;
+is $count, 6, 'variable usable after its widget has gone';
+
+$mw->destroy;
+
+__END__
@@ -0,0 +1,70 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Option lookup in Tk::Derived composites as their specs change.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 6;
+
+{
+    package MyComposite;
+    use base qw(Tk::Frame);
+    Construct Tk::Widget 'MyComposite';
+
+    sub Populate {
+	my ($cw, $args) = @_;
+	$cw->SUPER::Populate($args);
+	$cw->Advertise(label => $cw->Label->pack);
+	$cw->ConfigSpecs(-text => ['label'], -note => ['PASSIVE'],
+			 -foreground => ['label']);
+	$cw->ConfigAlias(-fg => '-foreground');
+    }
+}
+
+my $cw = $mw->MyComposite(-text => 'one')->pack;
+is $cw->Subwidget('label')->cget('-text'), 'one', 'delegated at creation';
+$cw->configure(-fg => 'red');
+is $cw->Subwidget('label')->cget('-foreground'), 'red',
+    'alias reaches the same subwidget';
+
+my $l2 = $cw->Label;
+$cw->Advertise(label => $l2);
+$cw->configure(-text => 'three');
+is $l2->cget('-text'), 'three', 're-advertised subwidget used';
+
+my $l3 = $cw->Label;
+$cw->ConfigSpecs(-text => [$l3]);
+$cw->configure(-text => 'four');
+is $l3->cget('-text'), 'four', 'changed ConfigSpecs used';
+
+$cw->configure(-note => 'x');
+is $cw->cget('-note'), 'x', 'passive option';
+
+my $late = $cw->Label;
+$cw->configure(-background => '#102030');
+is $late->cget('-background'), '#102030', 'children looked up afresh';
+
+$mw->destroy;
+
+__END__
@@ -0,0 +1,87 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Event loop histograms and the stall detector.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 12;
+
+sub total { my $n = 0; $n += $_ for @{$_[0]}; $n }
+
+$mw->update;
+Tk::Event::HistogramData(1);
+is Tk::Event::Histograms(1), 0, 'histograms were off';
+
+$mw->afterIdle(sub { 1 }) for 1..3;
+$mw->after(1, sub { 1 });
+$mw->after(20);
+$mw->update;
+Tk::Event::Histograms(0);
+
+my $h = Tk::Event::HistogramData();
+is_deeply [sort keys %$h], [qw(handler idlequeue iteration lateness)],
+	  'all histograms returned';
+is scalar(@{$h->{iteration}}), 32, 'buckets per histogram';
+cmp_ok total($h->{iteration}), '>', 0, 'iterations recorded';
+cmp_ok total($h->{handler}), '>', 0, 'handlers recorded';
+cmp_ok total($h->{lateness}), '>=', 1, 'late timer recorded';
+cmp_ok total($h->{idlequeue}), '>=', 1, 'idle passes recorded';
+
+Tk::Event::HistogramData(1);
+is total(Tk::Event::HistogramData()->{iteration}), 0, 'reset clears';
+
+my @stall;
+Tk::Event::Watchdog(0.05, sub { @stall = @_ });
+$mw->afterIdle(sub { select(undef, undef, undef, 0.1) });
+$mw->update;
+Tk::Event::Watchdog(0);
+cmp_ok $stall[0], '>=', 0.05, 'stall reported';
+like $stall[1], qr/__ANON__ at .*eventstats\.t line/, 'culprit named';
+
+# A nested iteration that does not itself stall must not lose the
+# culprit the outer iteration reports.
+@stall = ();
+Tk::Event::Watchdog(0.05, sub { @stall = @_ });
+$mw->afterIdle(sub { select(undef, undef, undef, 0.1); $mw->update });
+$mw->update;
+Tk::Event::Watchdog(0);
+like $stall[1], qr/__ANON__ at .*eventstats\.t line/,
+     'culprit named across a nested update';
+
+# The second of two timers due together is late by the time the first
+# one took.
+Tk::Event::HistogramData(1);
+Tk::Event::Histograms(1);
+$mw->after(5, sub { select(undef, undef, undef, 0.05) });
+$mw->after(5, sub { 1 });
+$mw->after(100);
+$mw->update;
+Tk::Event::Histograms(0);
+my @late = @{Tk::Event::HistogramData(1)->{lateness}};
+cmp_ok total([@late[16..$#late]]), '>=', 1,
+       'lateness counts time taken by earlier timers';
+
+$mw->destroy;
+
+__END__
@@ -0,0 +1,68 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Tcl_GetIndexFromObj remembers its lookups in the key's internal rep.
+# Check that the remembered result follows the key and the table.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 9;
+
+my $src = $mw->Photo(-width => 2, -height => 2);
+my $dst = $mw->Photo;
+
+my $v = 'box';
+for (1..3) {
+    $dst->copy($src, -subsample => 2, -filter => $v);
+}
+pass 'same key looked up repeatedly';
+
+eval { $dst->copy($src, -compositingrule => $v) };
+like $@, qr/bad compositing rule "box"/, 'key cached for one table is checked against another';
+
+$v = 'se';
+eval { $dst->copy($src, -compositingrule => $v) };
+is $@, '', 'abbreviation after assignment';
+
+substr($v, 0, 2) = 'bogus';
+eval { $dst->copy($src, -compositingrule => $v) };
+like $@, qr/bad compositing rule "bogus"/, 'key modified in place';
+
+$v = 'none';
+eval { $dst->copy($src, -filter => $v) };
+is $@, '', 'key reused for its first table';
+is $v, 'none', 'key keeps its string value';
+
+# Only a unique abbreviation may stand for the entry cached last.
+my $cmd = 'types';
+is_deeply [$mw->image($cmd)], [$mw->image('types')], 'exact key cached';
+$cmd = 'ty';
+eval { $mw->image($cmd) };
+like $@, qr/ambiguous option "ty"/, 'ambiguous prefix of the cached entry';
+$cmd = '';
+eval { $mw->image($cmd) };
+like $@, qr/ambiguous option ""/, 'empty key';
+
+$mw->destroy;
+
+__END__
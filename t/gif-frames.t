@@ -0,0 +1,114 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Frames of a multi-image GIF: GIFFrameInfo and reading with -index.
+#
+
+use strict;
+
+use Tk;
+use Tk::Animation;
+use MIME::Base64 qw(encode_base64);
+use File::Temp qw(tempdir);
+use Cwd qw(getcwd);
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 12;
+
+my $file = Tk->findINC('anim.gif');
+my $info = $mw->GIFFrameInfo($file);
+my $frames = $info->{frames};
+cmp_ok scalar(@$frames), '>', 1, 'several frames';
+is scalar(grep { $_->{width} > 0 && $_->{height} > 0 } @$frames),
+    scalar(@$frames), 'each frame has a size';
+
+my $data = do { local $/; open my $fh, '<', $file or die $!; binmode $fh; <$fh> };
+is_deeply $mw->GIFFrameInfo(encode_base64($data), 1), $info,
+    'same frames from base64 data';
+is_deeply $mw->GIFFrameInfo($data, 1), $info, 'same frames from binary data';
+
+# Read the frames back to front, then front to back:  both orders must
+# see the same images whether or not the positions were indexed yet.
+my @sizes = map {
+    my $p = $mw->Photo(-file => $file, -format => "gif -index $_");
+    my $s = join 'x', $p->width, $p->height;
+    $p->delete;
+    $s;
+} reverse 0..$#$frames;
+my @again = map {
+    my $p = $mw->Photo(-file => $file, -format => "gif -index $_");
+    my $s = join 'x', $p->width, $p->height;
+    $p->delete;
+    $s;
+} 0..$#$frames;
+is_deeply [reverse @sizes], \@again, 'frames read in any order';
+
+eval { $mw->Photo(-file => $file, -format => 'gif -index ' . scalar(@$frames)) };
+like $@, qr/no image data for this index/, 'index past the last frame';
+
+eval { $mw->GIFFrameInfo('/nonexistent/file.gif') };
+ok $@, 'missing file';
+
+# A file rewritten with the same length, or another file found under
+# the same relative name, must not be taken for the one indexed last.
+my $slow = $data;
+$slow =~ s/(\x21\xF9\x04.)(..)/$1 . pack('v', 2 * unpack('v', $2))/se
+    or die "no graphic control extension in $file";
+my $dir = tempdir(CLEANUP => 1);
+sub put {
+    my ($path, $bytes, $mtime) = @_;
+    open my $fh, '>', $path or die "$path: $!";
+    binmode $fh;
+    print $fh $bytes;
+    close $fh;
+    utime $mtime, $mtime, $path;
+}
+put("$dir/x.gif", $data, 1000000000);
+$mw->GIFFrameInfo("$dir/x.gif");
+put("$dir/x.gif", $slow, 1000000010);
+is $mw->GIFFrameInfo("$dir/x.gif")->{frames}[0]{delay},
+    2 * $frames->[0]{delay}, 'file rewritten with the same length';
+
+mkdir "$dir/a"; mkdir "$dir/b";
+put("$dir/a/x.gif", $data, 1000000000);
+put("$dir/b/x.gif", $slow, 1000000000);
+my $cwd = getcwd();
+chdir "$dir/a" or die $!;
+$mw->GIFFrameInfo('x.gif');
+chdir "$dir/b" or die $!;
+my $other = $mw->GIFFrameInfo('x.gif');
+chdir $cwd;
+is $other->{frames}[0]{delay}, 2 * $frames->[0]{delay},
+    'same relative name after chdir';
+
+# One buffer holding two different GIFs of the same length in turn.
+my $buf = $data;
+$mw->GIFFrameInfo($buf, 1);
+substr($buf, 0, length($slow), $slow);
+is $mw->GIFFrameInfo($buf, 1)->{frames}[0]{delay},
+    2 * $frames->[0]{delay}, 'data changed in place';
+substr($buf, 0, length($data), $data);
+is_deeply $mw->GIFFrameInfo($buf, 1), $info, 'and changed back';
+
+my $anim = $mw->Animation(-file => $file, -format => 'gif');
+is $anim->frame_count, scalar(@$frames), 'Tk::Animation frame count';
+
+$mw->destroy;
+
+__END__
@@ -0,0 +1,104 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Slaves that change size without changing the size of their row,
+# column or master are only re-placed by grid and pack.  Whatever
+# path is taken, the result must be the layout a fresh master
+# would get for the same slaves.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 12;
+
+my @text = map { [ map { 'X' x (1 + ($_ % 3)) } 0..3 ] } 0..3;
+
+sub make {
+    my ($manager, $text) = @_;
+    my $f = $mw->Frame->pack(-side => 'left', -anchor => 'n');
+    my @l;
+    for my $r (0..$#$text) {
+	for my $c (0..$#{$text->[$r]}) {
+	    my $l = $f->Label(-text => $text->[$r][$c], -borderwidth => 0);
+	    if ($manager eq 'grid') {
+		$l->grid(-row => $r, -column => $c, -sticky => 'w');
+	    } else {
+		$l->pack(-side => 'top', -anchor => 'w');
+	    }
+	    push @l, $l;
+	}
+    }
+    [$f, @l];
+}
+
+sub layout {
+    my ($w) = @_;
+    $mw->update;
+    [ map { [$_->x, $_->y, $_->width, $_->height] } @$w[1..$#$w] ],
+    [ $w->[0]->reqwidth, $w->[0]->reqheight ];
+}
+
+for my $manager (qw(grid pack)) {
+    my $w = make($manager, \@text);
+
+    my $same = sub {
+	my ($what) = @_;
+	my $ref = make($manager, \@text);
+	is_deeply [layout($w)], [layout($ref)], "$manager: $what";
+	$ref->[0]->destroy;
+    };
+    my $set = sub {
+	my ($r, $c, $t) = @_;
+	$text[$r][$c] = $t;
+	$w->[1 + 4 * $r + $c]->configure(-text => $t);
+    };
+
+    $mw->update;
+
+    # Every row starts out the same, so column 2 ('XXX') is held by
+    # four labels, and so is the width pack needs.
+    $set->(1, 2, 'X');
+    $same->('one of several widest shrinks');
+
+    $set->(1, 2, 'XX');
+    $same->('grow below the widest');
+
+    $set->(0, 2, 'X');
+    $set->(2, 2, 'X');
+    $same->('all but one widest shrink');
+
+    $set->(1, 2, 'X');
+    $same->('shrink below the widest');
+
+    $set->(3, 2, 'X');
+    $same->('the last widest shrinks');
+
+    $set->(1, 1, 'XXXXXX');
+    $same->('grow beyond the widest');
+
+    $w->[0]->destroy;
+    @text = map { [ map { 'X' x (1 + ($_ % 3)) } 0..3 ] } 0..3;
+}
+
+$mw->destroy;
+
+__END__
@@ -0,0 +1,75 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Widget methods entered with Tk::LeafMethods behave like the others.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 12;
+
+my $c = $mw->Canvas->pack;
+my $id = $c->createRectangle(10, 20, 30, 40, -fill => 'red');
+
+is_deeply [$c->coords($id)], [10, 20, 30, 40], 'list result';
+is scalar($c->itemcget($id, -fill)), 'red', 'scalar result';
+is_deeply [$c->coords($id)], [$c->WidgetMethod('coords', $id)], 'same as general path';
+
+my @xy = $c->coords($id);
+$_ = 0 for @xy;
+is_deeply [$c->coords($id)], [10, 20, 30, 40], 'results are not aliased to the widget';
+
+eval { $c->itemconfigure($id, -bogus => 1) };
+like $@, qr/Bad option `-bogus'/, 'errors croak';
+
+$c->itemconfigure($id, -fill => 'blue');
+is $c->itemcget($id, -fill), 'blue', 'void context';
+
+my $t = $mw->Text->pack;
+$t->insert('end', "hello world\n");
+$t->tagAdd('hot', '1.0', '1.5');
+is_deeply [$t->tag('ranges', 'hot')], ['1.0', '1.5'], 'submethod through leaf method';
+
+my @args = ('1.0', '1.5');
+is $t->compare($args[0], '<', $args[1]), 1, 'arguments copied from the stack';
+
+# Leaf methods can still call back to perl.  Callbacks which grow the
+# stack must not disturb the arguments or result of the method.
+my $lost = 0;
+$mw->SelectionOwn(-command => sub { my @big = (1) x 10000; $lost++ });
+$t->tag('add', 'sel', '1.0', '1.5');
+is $lost, 1, 'tag add sel ran the lost selection callback';
+is_deeply [$t->tag('ranges', 'sel')], ['1.0', '1.5'], 'after the callback';
+
+my $created = 0;
+$t->windowCreate('1.0', -create => sub {
+    my @big = (1) x 10000;
+    $created++;
+    $t->Label(-text => 'x');
+});
+my @where = ('@0,0', '==', '1.0');
+is $t->compare(@where), 1, 'index laid out the embedded window';
+is $created, 1, 'index ran the window create callback';
+
+$mw->destroy;
+
+__END__
@@ -0,0 +1,36 @@
+# -*- perl -*-
+BEGIN { $|=1; $^W=1; }
+use strict;
+use Test::More;
+
+use Tk;
+
+my $mw = eval { MainWindow->new };
+if (!$mw) {
+    plan skip_all => "Cannot create MainWindow: $@";
+}
+plan tests => 6;
+
+$mw->optionAdd('*OptTest.background', 'red');
+my $f = $mw->Frame(-class => 'OptTest');
+is($f->cget(-background), 'red', 'option resolved by class');
+
+## The per-window search list must see options added later
+$mw->optionAdd('*OptTest.foo.background', 'blue');
+my $l1 = $f->Label(Name => 'foo');
+is($l1->cget(-background), 'blue', 'option added after parent lookup');
+
+$mw->optionAdd('*OptTest.foo.background', 'green');
+my $l2 = $f->Label(Name => 'foo2');
+is($l2->optionGet('background', 'Background'), undef, 'no match for other name');
+is($l1->optionGet('background', 'Background'), 'green', 'redefined option seen on same window');
+
+## Repeated lookups on one window hit the cache
+for (1..100) {
+    $l1->optionGet('foreground', 'Foreground');
+}
+is($l1->optionGet('background', 'Background'), 'green', 'still green after repeated lookups');
+
+$mw->optionAdd('*OptTest*Label.relief', 'ridge');
+my $l3 = $f->Label;
+is($l3->cget(-relief), 'ridge', 'class path lookup on fresh window');
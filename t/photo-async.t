@@ -0,0 +1,99 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Photo reads queued with ReadAsync and completed from the event loop.
+#
+
+use strict;
+
+use Tk qw(:DEFAULT :eventtypes);
+use Tk::Photo;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 15;
+
+my $file = Tk->findINC('Xcamel.gif');
+my $ref  = $mw->Photo(-file => $file);
+
+my @done;
+my $p1 = $mw->Photo;
+$p1->ReadAsync($file, -command => sub { push @done, [@_] });
+is $p1->width, 0, 'nothing read before the event loop runs';
+$mw->update;
+is scalar(@done), 1, 'callback fired once';
+ok !defined $done[0][1], 'no error';
+is_deeply [map { $p1->get($_, $_) } 0..10], [map { $ref->get($_, $_) } 0..10],
+    'same pixels as a synchronous read';
+
+@done = ();
+my $p2 = $mw->Photo;
+my $job = $p2->ReadAsync($file, -command => sub { push @done, [@_] });
+is $p2->CancelRead($job), 1, 'read cancelled';
+$mw->update;
+ok !@done && $p2->width == 0, 'cancelled read not performed';
+
+$p2->ReadAsync('no/such/file.gif', -command => sub { push @done, [@_] });
+$mw->update;
+like $done[0][1], qr/no\/such\/file/, 'error passed to callback';
+
+# Decoded in one step and copied in whole in the next, with events
+# handled in between.
+{
+    my $p3 = $mw->Photo;
+    my $done = 0;
+    $p3->ReadAsync($file, -command => sub { $done++ });
+    DoOneEvent(DONT_WAIT|IDLE_EVENTS);
+    is_deeply [$p3->width, $p3->height, $done], [0, 0, 0],
+	'nothing shown once decoded';
+    my $ticked = 0;
+    $mw->after(0, sub { $ticked++ });
+    DoOneEvent(DONT_WAIT);
+    ok $ticked && !$done, 'events handled between decoding and copying';
+    DoOneEvent(DONT_WAIT|IDLE_EVENTS);
+    is $done, 1, 'copied in the next step';
+    is_deeply [map { $p3->get(7 * $_ % $ref->width, $_) } 0..$ref->height - 1],
+	[map { $ref->get(7 * $_ % $ref->width, $_) } 0..$ref->height - 1],
+	'pixels once copied';
+}
+
+# A read which has been decoded can still be cancelled.
+{
+    my $p6 = $mw->Photo;
+    my $done = 0;
+    my $images = () = $mw->imageNames;
+    $p6->ReadAsync($file, -command => sub { $done++ });
+    DoOneEvent(DONT_WAIT|IDLE_EVENTS);
+    is $p6->CancelRead, 1, 'decoded read cancelled';
+    $mw->update;
+    is_deeply [$p6->width, $done], [0, 0], 'cancelled read not copied in';
+    is scalar(() = $mw->imageNames), $images, 'scratch image deleted';
+}
+
+my $p4 = $mw->Photo;
+$p4->ReadAsync($file, -from => 10, 20, 50, 45, -to => 5, 7);
+$mw->update;
+my $p5 = $mw->Photo;
+$p5->copy($ref, -from => 10, 20, 50, 45, -to => 5, 7);
+is_deeply [$p4->width, $p4->height, map { $p4->get($_, $_ + 5) } 5..26],
+    [$p5->width, $p5->height, map { $p5->get($_, $_ + 5) } 5..26],
+    '-from and -to pick out and place a region';
+
+$mw->destroy;
+
+__END__
@@ -0,0 +1,59 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# The decoded photo image cache.
+#
+
+use strict;
+
+use Tk;
+use Tk::Photo;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 8;
+
+my $file = Tk->findINC('Xcamel.gif');
+
+is(Tk::Photo->CacheLimit(1<<20), 0, 'cache is off by default');
+my %s = Tk::Photo->CacheStats;
+is $s{limit}, 1<<20, 'limit set';
+
+my $p1 = $mw->Photo(-file => $file);
+my $p2 = $mw->Photo(-file => $file);
+%s = Tk::Photo->CacheStats;
+is "$s{misses}/$s{hits}/$s{entries}", '1/1/1', 'second photo from cache';
+is_deeply [$p2->width, $p2->height], [$p1->width, $p1->height], 'same size';
+is_deeply [map { $p2->get($_, $_) } 0..10], [map { $p1->get($_, $_) } 0..10],
+    'same pixels';
+
+$mw->Photo(-file => $file, -format => 'gif');
+%s = Tk::Photo->CacheStats;
+is $s{entries}, 2, 'format is part of the key';
+
+Tk::Photo->CacheLimit($p1->width * $p1->height * 4);
+%s = Tk::Photo->CacheStats;
+is "$s{entries}/$s{evictions}", '1/1', 'lower limit evicts';
+
+Tk::Photo->CacheLimit(0);
+%s = Tk::Photo->CacheStats;
+is $s{entries}, 0, 'disabling empties the cache';
+
+$mw->destroy;
+
+__END__
@@ -0,0 +1,68 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Zooming and filtered subsampling with the photo copy method.
+#
+
+use strict;
+
+use Tk;
+use Tk::Photo;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 7;
+
+my $src = $mw->Photo(-width => 4, -height => 4);
+$src->put([['#000000', '#ff0000', '#00ff00', '#0000ff'],
+	   ['#ffffff', '#808080', '#000000', '#ff0000'],
+	   ['#202020', '#404040', '#606060', '#808080'],
+	   ['#ff00ff', '#00ffff', '#ffff00', '#000000']]);
+
+my $dst = $mw->Photo;
+$dst->copy($src, -zoom => 3, 2);
+is_deeply [$dst->width, $dst->height], [12, 8], 'zoomed size';
+my @bad;
+for my $y (0..7) {
+    for my $x (0..11) {
+	my @want = $src->get(int($x/3), int($y/2));
+	my @got  = $dst->get($x, $y);
+	push @bad, "$x,$y" unless "@want" eq "@got";
+    }
+}
+is "@bad", '', 'every zoomed pixel matches its source';
+
+$dst->blank;
+$dst->copy($src, -zoom => 2, -to => 0, 0, 7, 5);
+is_deeply [$dst->get(6, 4)], [$src->get(3, 2)], 'zoom into a clipped region';
+
+$dst = $mw->Photo;
+$dst->copy($src, -subsample => 2);
+is_deeply [$dst->get(1, 1)], [$src->get(2, 2)], 'plain subsample picks a pixel';
+
+$dst = $mw->Photo;
+$dst->copy($src, -subsample => 2, -filter => 'box');
+is_deeply [$dst->width, $dst->height], [2, 2], 'box filtered size';
+is_deeply [$dst->get(0, 0)], [0xa0, 0x60, 0x60], 'box filter averages a cell';
+
+eval { $dst->copy($src, -subsample => 2, -filter => 'bogus') };
+like $@, qr/bad filter "bogus"/, 'unknown filter';
+
+$mw->destroy;
+
+__END__
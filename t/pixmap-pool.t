@@ -0,0 +1,57 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Redisplay buffers are reused from the display's pool.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 5;
+
+my %stats = $mw->BufferPixmapStats;
+is_deeply [sort keys %stats], [qw(bytes hits inuse misses pixmaps)],
+    'stats keys';
+
+my $e = $mw->Entry(-width => 20)->pack;
+my $l = $mw->Listbox(-height => 5)->pack;
+$l->insert('end', 1..10);
+$mw->update;
+
+%stats = $mw->BufferPixmapStats;
+my ($hits, $misses) = @stats{qw(hits misses)};
+cmp_ok $stats{pixmaps}, '>', 0, 'pixmaps kept after redisplay';
+is $stats{inuse}, 0, 'none in use between redisplays';
+
+for my $i (1..20) {
+    $e->delete(0, 'end');
+    $e->insert(0, "text $i");
+    $l->selectionClear(0, 'end');
+    $l->selectionSet($i % 10);
+    $mw->idletasks;
+}
+%stats = $mw->BufferPixmapStats;
+cmp_ok $stats{hits} - $hits, '>=', 20, 'redisplays reuse pooled pixmaps';
+is $stats{misses}, $misses, 'no new pixmaps needed';
+
+$mw->destroy;
+
+__END__
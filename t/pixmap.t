@@ -9,7 +9,7 @@ BEGIN {
 	exit;
     }
 }
-plan tests => 2;
+plan tests => 6;
 
 my($icon)=<<'END';
 /* XPM */
@@ -33,10 +33,51 @@ static char * junk_xpm[] = {
 " .+...oo. "};
 END
 use Tk;
+use Tk::WinPhoto;
 my $mw = tkinit;
 $mw->geometry("+20+20");
 my $label = $mw->Label(-image=>$mw->Pixmap(-data=>$icon))->pack;
 pass("Loaded and displayed pixmap");
+
+# Two and three characters per pixel take different lookup paths; the
+# second label shares the first one's parsed pixels.  The pixels are read
+# back off the screen, so each must have come out in its key's colour.
+for my $cpp (2, 3) {
+    my @keys = map { sprintf "%-${cpp}s", chr(ord('a') + $_ % 26) . int($_ / 26) } 0..29;
+    my $xpm = "/* XPM */\nstatic char * cpp_xpm[] = {\n\"30 4 30 $cpp\",\n";
+    for my $i (0..$#keys) {
+	$xpm .= sprintf "\"%s c #%02X%02X00\",\n", $keys[$i], 8*$i, 255-8*$i;
+    }
+    my @rows;
+    for my $y (0..3) {
+	push @rows, '"' . join('', map { $keys[($_ + $y) % 30] } 0..29) . '"';
+    }
+    $xpm .= join(",\n", @rows) . "};\n";
+    my $pm = $mw->Pixmap(-data => $xpm);
+    my @l = map {
+	$mw->Label(-image => $pm, -borderwidth => 0, -highlightthickness => 0,
+		   -padx => 0, -pady => 0)->pack
+    } 1..2;
+    $mw->raise;
+    $mw->update;
+    is($pm->width . 'x' . $pm->height, '30x4', "$cpp characters per pixel");
+    SKIP: {
+	skip "screen depth below 24", 1 if $mw->depth < 24;
+	my $shot = $mw->Photo(-format => 'Window', -data => oct($l[1]->id));
+	my @bad;
+	for my $y (0..3) {
+	    for my $x (0..29) {
+		my $i = ($x + $y) % 30;
+		my $got = join ',', $shot->get($x, $y);
+		my $want = join ',', 8*$i, 255-8*$i, 0;
+		push @bad, "$x,$y: $got != $want" if $got ne $want;
+	    }
+	}
+	$shot->delete;
+	is(scalar(@bad), 0, "$cpp characters per pixel: colours")
+	    or diag(join "\n", grep { defined } @bad[0..4]);
+    }
+}
 eval { $mw->Pixmap(-file => "__nonexistingpixmap__") };
 like($@, qr{(\QCannot open '__nonexistingpixmap__' in mode 'r'\E
 	    |\Qcouldn't read file "__nonexistingpixmap__": No such file or directory\E
@@ -0,0 +1,72 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# The event loop's profile of commands, callbacks and handlers.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 11;
+
+my $c = $mw->Canvas->pack;
+my $id = $c->createLine(0, 0, 10, 10);
+$mw->update;
+
+Tk::Event::ProfileData(1);
+is Tk::Event::Profile(1), 0, 'profile was off';
+is Tk::Event::Profile(), 1, 'profile now on';
+
+$c->coords($id, 0, 0, 20, 20) for 1..5;
+my $ran = 0;
+$mw->afterIdle(sub { $ran++ });
+$mw->after(1, sub { $ran++ });
+$mw->after(20);
+$mw->update;
+Tk::Event::Profile(0);
+
+my $p = Tk::Event::ProfileData();
+is ref($p), 'HASH', 'profile is a hash';
+is $p->{command}{'Canvas coords'}[0], 5, 'calls of a widget method counted';
+cmp_ok $p->{command}{'Canvas coords'}[1], '>=', 0, 'time recorded';
+ok((grep { /__ANON__ at .*profile\.t line/ } keys %{$p->{callback}}),
+   'anonymous callback named by where it was defined');
+ok $p->{idle} && keys %{$p->{idle}}, 'idle handlers recorded';
+ok $p->{timer} && keys %{$p->{timer}}, 'timer handlers recorded';
+
+# Every image instance is counted under one name.
+my @img = map { $mw->Photo(-width => 4, -height => 4) } 1..3;
+Tk::Event::ProfileData(1);
+Tk::Event::Profile(1);
+$_->blank for @img;
+Tk::Event::Profile(0);
+$p = Tk::Event::ProfileData();
+is $p->{command}{'Tk::Photo blank'}[0], 3, 'images named by class';
+ok !(grep { /HASH\(0x/ } keys %{$p->{command}}), 'no per-instance names';
+$_->delete for @img;
+
+$c->coords($id, 0, 0, 10, 10);
+Tk::Event::ProfileData(1);
+is_deeply Tk::Event::ProfileData(), {}, 'reset clears the profile';
+
+$mw->destroy;
+
+__END__
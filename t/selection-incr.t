@@ -0,0 +1,80 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Selections larger than one transfer chunk must arrive intact, whether
+# they are copied within this process or sent by another client with
+# the INCR protocol.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 4;
+
+# Larger than both the local copy size (64K) and the biggest X chunk
+# (1MB), with no repeat that would hide a misplaced piece.
+my $data = join '', map { sprintf "%07d\n", $_ } 0..320_000;
+
+$mw->SelectionOwn;
+$mw->SelectionHandle(sub { my ($off, $max) = @_; substr($data, $off, $max) });
+my $got = $mw->SelectionGet;
+is length($got), length($data), 'chunked handler: length';
+ok $got eq $data, 'chunked handler: contents';
+
+# A handler returning the whole remainder has later pieces sliced from
+# what it returned.
+$mw->SelectionHandle(sub { my ($off) = @_; substr($data, $off) });
+$got = $mw->SelectionGet;
+ok $got eq $data, 'whole-value handler: contents';
+$mw->SelectionClear;
+# Nothing above needed the server, so flush before the other client
+# starts or our stale ownership would reach it after theirs.
+$mw->update;
+
+# Another client owns the selection; it gives up when we take it back.
+my $script = <<'EOS';
+use Tk;
+my $data = join '', map { sprintf "%07d\n", $_ } 0..320_000;
+my $mw = MainWindow->new;
+$mw->withdraw;
+$mw->SelectionOwn(-command => sub { $mw->destroy });
+$mw->SelectionHandle(sub { my ($off, $max) = @_; substr($data, $off, $max) });
+$mw->after(30000, sub { $mw->destroy });
+$mw->update;
+$| = 1;
+print "ready\n";
+MainLoop;
+EOS
+my $pid = open(my $kid, '-|', $^X, (map { "-I$_" } @INC), '-e', $script);
+SKIP: {
+    skip "cannot start a second client", 1
+	unless $pid && defined(my $line = <$kid>);
+    $got = eval { $mw->SelectionGet };
+    ok defined($got) && $got eq $data, 'INCR transfer from another client'
+	or diag($@ || 'got ' . (defined $got ? length($got) : 0) . ' bytes');
+    $mw->SelectionOwn;
+    $mw->update;
+}
+close $kid if $pid;
+
+$mw->destroy;
+
+__END__
@@ -19,7 +19,7 @@ BEGIN {
     }
 }
 
-plan tests => 16;
+plan tests => 30;
 
 if (!defined $ENV{BATCH}) { $ENV{BATCH} = 1 }
 
@@ -76,6 +76,58 @@ isa_ok($table->Subwidget("yscrollbar"), "Tk::Scrollbar",
     ok !Tk::Exists($b2), 'Button was destroyed by clear() method';
 }
 
+{
+    my $t2 = $mw->Table(-rows => 5, -columns => 4, -scrollbars => 'se',
+			-fixedrows => 1, -fixedcolumns => 1)->pack;
+    for my $r (0 .. 29) {
+	for my $c (0 .. 9) {
+	    $t2->put($r, $c, "$r,$c");
+	}
+    }
+    $t2->update;
+    my @all = map { my $r = $_; map { $t2->get($r, $_) } 0 .. 9 } 0 .. 29;
+    my @mapped = grep { $_->ismapped } @all;
+    ok(@mapped >= 16 && @mapped < 60, 'only visible cells are mapped')
+	or diag scalar(@mapped) . ' mapped';
+
+    $t2->yview(moveto => 0.5);
+    $t2->update;
+    my ($first) = $t2->yview;
+    ok($first > 0.3 && $first < 0.7, 'yview moveto') or diag $first;
+    ok(!$t2->get(1, 1)->ismapped, 'scrolled out of view is unmapped');
+    ok($t2->get(0, 0)->ismapped, 'fixed cell stays mapped');
+
+    $t2->see(29, 9);
+    $t2->update;
+    ok($t2->get(29, 9)->ismapped, 'see scrolls last cell into view');
+
+    # Moving a shown slave to a cell out of view must hide it.
+    my $moved = $t2->get(29, 9);
+    my $old = $t2->get(1, 1);
+    is($t2->put(1, 1, $moved), $old, 'put returns the displaced slave');
+    $t2->update;
+    ok(!$moved->ismapped, 'slave moved out of view is unmapped');
+    ok(!$old->ismapped, 'displaced slave is unmapped');
+    is($t2->get(29, 9), undef, 'old cell is empty');
+    is(join(',', $moved->table('info')), '1,1', 'slave is in its new cell');
+
+    $t2->yview(scroll => -100, 'units');
+    $t2->xview(moveto => 0);
+    $t2->update;
+    ok($moved->ismapped, 'scrolled back to the moved slave');
+    is($moved->x, $t2->get(1, 2)->x - $moved->width,
+       'moved slave sits in its new column');
+
+    my $f = $mw->Frame;
+    my $other = $f->Button;
+    eval { $t2->put(2, 2, $other) };
+    like($@, qr/can't put \S+ inside/, 'slave of another master rejected');
+    eval { $t2->put(2, 2, $t2) };
+    like($@, qr/can't put \S+ inside/, 'table cannot hold itself');
+    $f->destroy;
+    $t2->destroy;
+}
+
 if ($ENV{BATCH}) {
     $mw->after(150, sub { $mw->destroy });
 }
@@ -0,0 +1,123 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Display lines kept for re-use after they scroll out of a text
+# widget must be thrown away whenever the text, tags or widget
+# configuration change underneath them.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 10;
+
+# $t is scrolled about so that its cache fills up; $ref always jumps
+# straight to the view being compared, so it lays everything out afresh.
+my @opt = (-width => 40, -height => 10, -wrap => 'word');
+my $t   = $mw->Text(@opt)->pack(-side => 'left');
+my $ref = $mw->Text(@opt)->pack(-side => 'left');
+for my $w ($t, $ref) {
+    for my $i (1..300) {
+	$w->insert('end', "line $i " . ('word ' x ($i % 23)) . "\tend\n");
+    }
+    $w->tagConfigure('big', -font => 'Courier 18');
+}
+
+sub both (&) {
+    my $code = shift;
+    $code->($_) for $t, $ref;
+}
+
+sub layout {
+    my ($w) = @_;
+    $w->update;
+    my @l;
+    for my $i (1..40) {
+	push @l, [$i, $w->dlineinfo("$i.0"), $w->bbox("$i.0 lineend")];
+    }
+    \@l;
+}
+
+sub scroll_away {
+    for (my $i = 1; $i < 250; $i += 7) {
+	$t->yview($i . '.0');
+	$t->update;
+    }
+}
+
+sub same_view {
+    my ($what) = @_;
+    both { $_[0]->yview('1.0') };
+    is_deeply layout($t), layout($ref), $what;
+}
+
+scroll_away();
+same_view('scrolling back reuses an unchanged layout');
+
+$t->yview('200.0');
+$t->update;
+my $before = Tk::Event::AllocStats();
+$t->yviewScroll(-5, 'units') for 1..6;
+$t->update;
+my $cached = Tk::Event::AllocStats()->{ckalloc} - $before->{ckalloc};
+$ref->yview('200.0');
+$ref->update;
+$before = Tk::Event::AllocStats();
+$ref->yviewScroll(-5, 'units') for 1..6;
+$ref->update;
+my $fresh = Tk::Event::AllocStats()->{ckalloc} - $before->{ckalloc};
+cmp_ok $cached, '<', $fresh, 'scrolling back allocates less';
+
+scroll_away();
+both { $_[0]->insert('5.3', 'inserted ' x 12) };
+same_view('text inserted off-screen');
+
+scroll_away();
+both { $_[0]->delete('8.0', '12.0') };
+same_view('lines deleted off-screen');
+
+scroll_away();
+both { $_[0]->tagAdd('big', '3.0', '4.0') };
+same_view('tag added off-screen');
+
+scroll_away();
+both { $_[0]->tagConfigure('big', -font => 'Courier 24') };
+same_view('tag reconfigured off-screen');
+
+scroll_away();
+both { $_[0]->tagConfigure('hide', -elide => 1); $_[0]->tagAdd('hide', '6.0', '7.0') };
+same_view('line elided off-screen');
+
+scroll_away();
+both { $_[0]->tagRemove('big', '1.0', 'end') };
+same_view('tag removed off-screen');
+
+scroll_away();
+both { $_[0]->markSet('insert', '2.4') };
+same_view('insert cursor moved off-screen');
+
+scroll_away();
+both { $_[0]->configure(-width => 30) };
+same_view('widget narrowed');
+
+$mw->destroy;
+
+__END__
@@ -0,0 +1,74 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# tag ranges, nextrange and remove on tags with many toggles.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 9;
+
+my $t = $mw->Text;
+$t->debug(1);	# check the B-tree after every change
+
+my $lines = 300;
+my @expect;
+for my $l (1..$lines) {
+    $t->insert('end', "k\x{e9}y = 'value'; # note $l\n");
+}
+for my $l (1..$lines) {
+    # Three ranges per line, after a non-ASCII character.
+    for ([0,3], [6,13], [15,21]) {
+	$t->tagAdd('hl', "$l.$_->[0]", "$l.$_->[1]");
+	push @expect, "$l.$_->[0]", "$l.$_->[1]";
+    }
+}
+is_deeply [$t->tagRanges('hl')], \@expect, 'ranges of a tag toggled often';
+is_deeply [$t->tagNextrange('hl', '150.4')], ['150.6', '150.13'],
+    'nextrange from inside a line';
+
+$t->tagRemove('hl', '100.0', '200.0');
+is_deeply [$t->tagRanges('hl')],
+    [grep { /^(\d+)/; $1 < 100 || $1 >= 200 } @expect],
+    'remove over many lines';
+is_deeply [$t->tagNextrange('hl', '100.0')], ['200.0', '200.3'],
+    'nextrange skips the cleared lines';
+
+$t->tagAdd('hl', '10.1', '20.8');
+my @r = $t->tagRanges('hl');
+is_deeply [@r[0..7]], [qw(1.0 1.3 1.6 1.13 1.15 1.21 2.0 2.3)],
+    'ranges before a merged range';
+is_deeply [grep { /^(\d+)\./ && $1 >= 10 && $1 <= 20 } @r],
+    [qw(10.0 20.13 20.15 20.21)], 'add over existing toggles merges them';
+
+$t->tagRemove('hl', '1.0', 'end');
+is_deeply [$t->tagRanges('hl')], [], 'remove everything';
+
+$t->tagAdd('hl', map { ("$_.0", "$_.1") } 1..50);
+is scalar(my @x = $t->tagRanges('hl')), 100, 'many ranges in one call';
+
+$t->tagDelete('hl');
+is_deeply [$t->tagRanges('hl')], [], 'delete a tag with many toggles';
+
+$mw->destroy;
+
+__END__
@@ -0,0 +1,70 @@
+#!/usr/bin/perl -w
+# -*- perl -*-
+
+#
+# Styles of text runs under many overlapping tags, as the tags are
+# toggled within a line, re-prioritized and reconfigured.
+#
+
+use strict;
+
+use Tk;
+
+BEGIN {
+    if (!eval q{
+	use Test::More;
+	1;
+    }) {
+	print "1..0 # skip no Test::More module\n";
+	exit;
+    }
+}
+
+my $mw = eval { tkinit };
+if (!$mw) {
+    plan skip_all => 'Cannot create MainWindow';
+    CORE::exit(0);
+}
+
+plan tests => 8;
+
+my $t = $mw->Text(-width => 40, -height => 10, -wrap => 'char',
+		  -font => 'Courier 10')->pack;
+$t->tagConfigure('big',   -font => 'Courier 24');
+$t->tagConfigure('small', -font => 'Courier 8');
+$t->tagConfigure("c$_", -foreground => ($_ % 2 ? 'red' : 'blue')) for 1..60;
+
+sub width_of {
+    my ($index) = @_;
+    $t->update;
+    my @b = $t->bbox($index);
+    return $b[2];
+}
+
+$t->insert('end', 'aa', '', 'BB', 'big', 'cc', '', 'DD', 'big', "ee\n");
+my $plain = width_of('1.0');
+my $big   = width_of('1.2');
+cmp_ok $big, '>', $plain, 'tagged run uses its font';
+is width_of('1.4'), $plain, 'tag toggled off within the line';
+is width_of('1.6'), $big,   'tag toggled on again within the line';
+
+for my $i (0..59) {
+    $t->tagAdd('c' . ($i+1), "1.0 + $i chars", '1.end');
+}
+is width_of('1.2'), $big, 'many colour tags leave the font alone';
+
+$t->tagAdd('small', '1.0', '1.end');
+is width_of('1.2'), width_of('1.0'), 'higher priority tag wins';
+$t->tagRaise('big', 'small');
+is width_of('1.2'), $big, 'raising a tag changes the style';
+
+$t->tagConfigure('big', -font => 'Courier 10');
+is width_of('1.2'), $plain, 'reconfiguring a tag changes the style';
+
+$t->tagConfigure('big', -font => 'Courier 24');
+$t->insert('2.0', ('x' x 30) . ('y' x 30), 'big');
+is width_of('2.end - 1 chars'), $big, 'wrapped line starting inside a tag';
+
+$mw->destroy;
+
+__END__
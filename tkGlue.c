@@ -97,8 +97,12 @@ typedef struct
  Tcl_Interp        *interp;
  char              *part2;
  SV                *sv;
+ int                pending;	/* A deferred call is scheduled */
 } Tk_TraceInfo;
 
+/* Number of trace calls folded into an already scheduled deferred one */
+static long suppressedTraces = 0;
+
 typedef struct
 {
  Tcl_Interp *interp;
@@ -113,6 +117,11 @@ typedef struct Assoc_s
 
 static int initialized = 0;
 
+/* Set once any callback has asked to exit, so that Call_Tk need not look
+   for _TK_EXIT_ in the interp after every command.
+ */
+static int exitRequested = 0;
+
 
 static I32 ec = 0;
 static SV *my_watch;
@@ -167,6 +176,7 @@ static void HandleBgErrors _((ClientData clientData));
 static void SetTclResult _((Tcl_Interp *interp,int count));
 static int InfoFromArgs _((Lang_CmdInfo *info,Tcl_ObjCmdProc *proc,int mwcd, int items, SV **args));
 static I32 InsertArg _((SV **mark,I32 posn,SV *sv));
+static int InvokeTk _((Lang_CmdInfo *info, int items, SV **args, int leaf));
 extern Tk_Window TkToMainWindow _((Tk_Window tkwin));
 static int isSwitch _((char *arg));
 static void Lang_ClearErrorInfo _((Tcl_Interp *interp));
@@ -1510,6 +1520,7 @@ Tcl_Interp *interp;
      Tk_Window tkwin = Tk_MainWindow(interp);
      SV *sv = FindSv(aTHX_ interp, "Check_Eval", 1, "_TK_EXIT_");
      char *e = strchr(s+=10,')');
+     exitRequested = 1;
      sv_setpvn(sv,s,e-s);
      if (tkwin)
       Tk_DestroyWindow(tkwin);
@@ -2048,6 +2059,7 @@ Return_Object(int items, int offset, Tcl_Obj *sv)
  int gimme = GIMME_V;
  int count = 0;
  int i;
+ int steal;
  SV **objv = NULL;
  SV **args = NULL;
  /* Get stack as it is now */
@@ -2097,9 +2109,20 @@ Return_Object(int items, int offset, Tcl_Obj *sv)
   }
  /* Now move 'args' to 0'th arg position in current stack */
  args = sp + offset;
+ /* Every caller releases the result as soon as we return, so an
+    element which nothing else refers to can be handed to perl as it
+    is rather than copied.  Shared, magical or read-only values are
+    still copied.
+  */
+ steal = (SvREFCNT(sv) == 1 &&
+          (objv == &sv || (SvROK(sv) && SvREFCNT(SvRV(sv)) == 1)));
  for (i = count-1; i >= 0; i--)
   {
-   args[i] = sv_mortalcopy(objv[i]);
+   SV *elem = objv[i];
+   if (steal && SvREFCNT(elem) == 1 && !SvMAGICAL(elem) && !SvREADONLY(elem))
+    args[i] = sv_2mortal(SvREFCNT_inc(elem));
+   else
+    args[i] = sv_mortalcopy(elem);
   }
  /* Copy stack pointer back to global */
  PUTBACK;
@@ -2197,6 +2220,22 @@ Call_Tk(info, items, args)
 Lang_CmdInfo *info;
 int items;
 SV **args;
+{
+ return InvokeTk(info, items, args, 0);
+}
+
+/* Call the command behind a widget method.
+   A "leaf" command is one that does not run the event loop; its
+   arguments are only converted to strings when the command asks for
+   them.  It may still call back to perl, so the stack is swapped as
+   for any other command.
+ */
+static int
+InvokeTk(info, items, args, leaf)
+Lang_CmdInfo *info;
+int items;
+SV **args;
+int leaf;
 {
  int count = 1;
  STRLEN na;
@@ -2222,6 +2261,8 @@ SV **args;
      int offset = args - sp;
      int code;
      SV **our_sp = sp;
+     double start;
+     char name[128];
 
      Tcl_ObjCmdProc *proc = info->Tk.objProc;
      ClientData cd = info->Tk.objClientData;
@@ -2235,10 +2276,41 @@ SV **args;
       {
        Lang_TaintCheck(Tcl_GetString(args[0]),items, args);
       }
-     for (i=0; i < items; i++)
+
+     /* info may be gone by the time the command returns,
+        so name it for the profile now; objects are named by class
+        so that every instance shares one entry */
+     name[0] = '\0';
+     if ((start = LangProfileStart()) && LangProfiling())
+      {
+       if (info->tkwin && sv_isobject(args[0]) && items > 1)
+        {
+         CONST char *cls = Tk_Class(info->tkwin);
+         my_snprintf(name, sizeof(name), "%s %s",
+                     (cls) ? cls : Tk_PathName(info->tkwin),
+                     Tcl_GetString(args[1]));
+        }
+       else if (sv_isobject(args[0]))
+        {
+         my_snprintf(name, sizeof(name), "%s %s",
+                     sv_reftype(SvRV(args[0]), 1),
+                     (items > 1) ? Tcl_GetString(args[1]) : "");
+        }
+       else
+        {
+         my_snprintf(name, sizeof(name), "%s", Tcl_GetString(args[0]));
+        }
+      }
+
+     /* Leaf methods leave their arguments for the command to convert
+        when it needs them; others are converted to strings up front. */
+     if (!leaf)
       {
-       if (SvPOK(args[i]))
-        Tcl_GetString(args[i]);
+       for (i=0; i < items; i++)
+        {
+         if (SvPOK(args[i]))
+          Tcl_GetString(args[i]);
+        }
       }
 
      Tcl_Preserve(interp);
@@ -2249,7 +2321,9 @@ SV **args;
         (Note it is only vector that is at risk, SVs themselves will stay put.)
 
         So we pre-emptively swap perl stack so any callbacks
-        which grow their stack don't move our "args"
+        which grow their stack don't move our "args".
+        Even leaf methods need this, as parsing an index or taking
+        the selection can run perl code.
       */
      ENTER;
      SAVETMPS;
@@ -2268,6 +2342,8 @@ SV **args;
       abort();
 
      Tcl_Release(interp);
+     LangProfileRecord("command", (name[0]) ? name : NULL,
+                       (VOID *) proc, start);
 
      /* info stucture may have been free'ed now ... */
 #ifdef WIN32
@@ -2278,7 +2354,8 @@ SV **args;
         DCcount = 0;
        }
 #endif
-     if ((exiting = FindSv(aTHX_ interp, "Check_Eval", 0, "_TK_EXIT_")))
+     if (exitRequested &&
+         (exiting = FindSv(aTHX_ interp, "Check_Eval", 0, "_TK_EXIT_")))
       {
        PL_tainted = old_taint;
        DecInterp(interp, "Call_Tk");
@@ -2627,6 +2704,15 @@ XS(XStoWidget)
  TKXSRETURN(Call_Tk(info, items, &ST(0)));
 }
 
+XS(XStoLeafWidget)
+{
+ dXSARGS;
+ Lang_CmdInfo *info = WindowCommand(ST(0), NULL, 1);
+ do_watch();
+ items = InsertArg(mark,1,XSANY.any_ptr);
+ TKXSRETURN(InvokeTk(info, items, &ST(0), 1));
+}
+
 static SV *
 NameFromCv(cv)
 CV *cv;
@@ -3720,6 +3806,41 @@ TraceExitHandler(ClientData clientData)
  LEAVE;
 }
 
+/* Variables marked with Tk::DeferTrace carry an extra 'U' magic whose
+   only purpose is to be found by TraceDeferred.
+ */
+static DECL_MG_UFUNC(Perl_TraceDeferred, ix, sv)
+{
+ return 0;
+}
+
+static MAGIC **
+TraceDeferred(SV *sv)
+{
+ MAGIC **mgp = &SvMAGIC(sv);
+ MAGIC *mg;
+ while ((mg = *mgp))
+  {
+   if (mg->mg_type == PERL_MAGIC_uvar && mg->mg_ptr &&
+       mg->mg_len == sizeof(struct ufuncs) &&
+       ((struct ufuncs *) (mg->mg_ptr))->uf_val == Perl_TraceDeferred)
+    return mgp;
+   mgp = &mg->mg_moremagic;
+  }
+ return NULL;
+}
+
+static void
+DeferredTrace(ClientData clientData)
+{
+ dTHX;
+ Tk_TraceInfo *p = (Tk_TraceInfo *) clientData;
+ /* The trace proc may untrace the variable, which frees p */
+ SV *sv = p->sv;
+ p->pending = 0;
+ TraceExitHandler(clientData);
+ SvREFCNT_dec(sv);
+}
 
 static DECL_MG_UFUNC(Perl_Trace, ix, sv)
 {
@@ -3755,6 +3876,22 @@ static DECL_MG_UFUNC(Perl_Trace, ix, sv)
   SvIOK_on(sv);
 #endif
 
+ if (TraceDeferred(sv))
+  {
+   /* Just note the change, and tell the widget once at idle time */
+   if (p->pending)
+    {
+     suppressedTraces++;
+    }
+   else
+    {
+     p->pending = 1;
+     SvREFCNT_inc(p->sv);
+     Tcl_DoWhenIdle(DeferredTrace, (ClientData) p);
+    }
+   return 0;
+  }
+
  ENTER;
  SvREFCNT_inc(sv);
  save_freesv(sv);
@@ -3815,6 +3952,7 @@ ClientData clientData;
  p->interp = interp;
  p->part2 = part2;
  p->sv    = sv;
+ p->pending = 0;
 
  Tcl_CreateExitHandler(TraceExitHandler, (ClientData) p);
 
@@ -3987,6 +4125,27 @@ CONST char *varName;
   }
 }
 
+/* The last magic has been unlinked from sv by hand: make it an
+   ordinary scalar again.
+ */
+static void
+UnmagicFlags(SV *sv)
+{
+ SvMAGICAL_off(sv);
+ if ((SvFLAGS(sv) & (SVp_IOK|SVp_NOK)) == (SVp_IOK|SVp_NOK))
+  {
+   /* RT #90077: if both SVp_IOK and SVp_NOK are set, then the
+    * SVf_IOK must not be set, otherwise arithmetic operations
+    * may use the wrong integer value
+    */
+   SvFLAGS(sv) |= (SvFLAGS(sv) & (SVp_NOK|SVp_POK)) >> PRIVSHIFT;
+  }
+ else
+  {
+   SvFLAGS(sv) |= (SvFLAGS(sv) & (SVp_IOK|SVp_NOK|SVp_POK)) >> PRIVSHIFT;
+  }
+}
+
 void
 Lang_UntraceVar(interp, sv, flags, tkproc, clientData)
 Tcl_Interp *interp;
@@ -3995,6 +4154,7 @@ int flags;
 Lang_VarTraceProc *tkproc;
 ClientData clientData;
 {
+ dTHX;
  int mgType = PERL_MAGIC_uvar;
  MAGIC **mgp;
  /* it may not be magical i.e. it may never have been traced
@@ -4031,6 +4191,11 @@ ClientData clientData;
         {
          *mgp = mg->mg_moremagic;
          Tcl_DeleteExitHandler(TraceExitHandler, (ClientData) p);
+         if (p->pending)
+          {
+           Tcl_CancelIdleCall(DeferredTrace, (ClientData) p);
+           sv_2mortal(p->sv);
+          }
          Safefree(p);
          uf->uf_index = 0;
          Safefree(mg->mg_ptr);
@@ -4044,22 +4209,59 @@ ClientData clientData;
       mgp = &mg->mg_moremagic;
     }
    if (!SvMAGIC(sv))
+    UnmagicFlags(sv);
+  }
+}
+
+/* Tk::DeferTrace(\$var ?,boolean?)
+   With a true value, widgets tracing $var are told of a change once per
+   idle cycle instead of on every store.  Returns the previous setting.
+ */
+XS(XS_Tk_DeferTrace)
+{
+ dXSARGS;
+ SV *sv;
+ MAGIC **mgp = NULL;
+ int old;
+ if (items < 1 || items > 2 || !SvROK(ST(0)) || SvTYPE(SvRV(ST(0))) >= SVt_PVAV)
+  croak("Usage: Tk::DeferTrace(\\$var ?,boolean?)");
+ sv = SvRV(ST(0));
+ if (SvMAGICAL(sv))
+  mgp = TraceDeferred(sv);
+ old = (mgp != NULL);
+ if (items > 1)
+  {
+   int on = SvTRUE(ST(1));
+   if (on && !old)
     {
-     SvMAGICAL_off(sv);
-     if ((SvFLAGS(sv) & (SVp_IOK|SVp_NOK)) == (SVp_IOK|SVp_NOK))
-      {
-       /* RT #90077: if both SVp_IOK and SVp_NOK are set, then the
-	* SVf_IOK must not be set, otherwise arithmetic operations
-	* may use the wrong integer value
-	*/
-       SvFLAGS(sv) |= (SvFLAGS(sv) & (SVp_NOK|SVp_POK)) >> PRIVSHIFT;
-      }
+     struct ufuncs uf;
+     Zero(&uf, 1, struct ufuncs);
+     uf.uf_val = Perl_TraceDeferred;
+     sv_magicext(sv, NULL, PERL_MAGIC_uvar, &PL_vtbl_uvar,
+                 (char *) &uf, sizeof(uf));
+    }
+   else if (!on && old)
+    {
+     MAGIC *mg = *mgp;
+     *mgp = mg->mg_moremagic;
+     Safefree(mg->mg_ptr);
+     Safefree(mg);
+     if (SvMAGIC(sv))
+      mg_magical(sv);
      else
-      {
-       SvFLAGS(sv) |= (SvFLAGS(sv) & (SVp_IOK|SVp_NOK|SVp_POK)) >> PRIVSHIFT;
-      }
+      UnmagicFlags(sv);
     }
   }
+ ST(0) = boolSV(old);
+ XSRETURN(1);
+}
+
+/* Tk::SuppressedTraces() - how many trace calls deferral has saved */
+XS(XS_Tk_SuppressedTraces)
+{
+ dXSARGS;
+ ST(0) = sv_2mortal(newSViv(suppressedTraces));
+ XSRETURN(1);
 }
 
 int
@@ -5560,6 +5762,8 @@ _((pTHX))
 
  newXS("Tk::DoWhenIdle", XS_Tk_DoWhenIdle, __FILE__);
  newXS("Tk::CreateGenericHandler", XS_Tk_CreateGenericHandler, __FILE__);
+ newXS("Tk::DeferTrace", XS_Tk_DeferTrace, __FILE__);
+ newXS("Tk::SuppressedTraces", XS_Tk_SuppressedTraces, __FILE__);
 
 
  sprintf(buf, "%s::Widget::%s", BASEEXT, "ManageGeometry");
@@ -50,6 +50,7 @@ extern EventAndKeySym *SVtoEventAndKeySym _((SV *arg));
 extern int XSTkCommand _ANSI_ARGS_((CV *cv, int mwcd, Tcl_ObjCmdProc *proc, int items, SV **args));
 
 extern XS(XStoWidget);
+extern XS(XStoLeafWidget);
 
 EXTERN void ClearErrorInfo _ANSI_ARGS_((SV *interp));
 EXTERN Tk_Window mainWindow;